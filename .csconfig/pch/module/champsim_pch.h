@@ -0,0 +1,2 @@
+#include "cache.h"
+#include "ooo_cpu.h"
@@ -21,6 +21,7 @@ import argparse
 
 import config.filewrite
 import config.parse
+import config.runtime
 import config.util
 
 # Read the config file
@@ -60,6 +61,9 @@ if __name__ == '__main__':
     parser.add_argument('--compile-all-modules', action='store_true', dest='compile_all_modules',
             help='Compile all modules in the search path')
 
+    parser.add_argument('--runtime-config', metavar='FILE',
+            help='Also write the fully resolved configuration to FILE, which can be loaded by any ChampSim binary with the same number of cores using its --config option. This permits sweeping geometries and latencies without rebuilding.')
+
     parser.add_argument('-v', action='store_true', dest='verbose')
 
     parser.add_argument('--join', choices=['chain','product'], default='product',
@@ -93,7 +97,18 @@ if __name__ == '__main__':
         'compile_all_modules': args.compile_all_modules,
         'verbose': args.verbose
     }
-    parsed_configs = (config.parse.parse_config(*c, **parse_args) for c in config_files)
+    parsed_configs = [config.parse.parse_config(*c, **parse_args) for c in config_files]
+
+    if args.runtime_config is not None:
+        if len(parsed_configs) != 1:
+            parser.error('--runtime-config requires that exactly one configuration is produced')
+        _, elements, _, _, config_file = parsed_configs[0]
+        try:
+            runtime_config = config.runtime.get_runtime_config(**elements, config_file=config_file)
+        except ValueError as exc:
+            parser.error(str(exc))
+        with open(args.runtime_config, 'wt') as wfp:
+            json.dump(runtime_config, wfp, indent=2)
 
     with config.filewrite.FileWriter(bindir_name=bindir_name, objdir_name=objdir_name, makedir_name=args.makedir, verbose=args.verbose) as wr:
         for c in parsed_configs:
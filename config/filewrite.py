@@ -23,6 +23,8 @@ import pathlib
 from .makefile import get_makefile_lines
 from .instantiation_file import get_instantiation_lines
 from .instantiation_file import get_instantiation_header
+from .instantiation_file import get_module_registry_headers
+from .instantiation_file import get_module_registry_entries
 from . import util
 
 warning_text = (
@@ -148,6 +150,7 @@ class Fragment:
         executable_basename, elements, modules_to_compile, module_info, config_file = parsed_config
 
         joined_module_info = util.subdict(util.chain(*module_info.values()), modules_to_compile) # remove module type tag
+        registry_module_info = {k: util.subdict(v, modules_to_compile) for k,v in module_info.items()}
         executable = os.path.join(bindir_name, executable_basename)
         if verbose:
             print('For Executable', executable)
@@ -162,10 +165,18 @@ class Fragment:
                 print('Touching file:', str(legacy_marker))
             legacy_marker.touch()
 
+        # Each configuration has its own instantiation files, in a directory named for its build ID, so that
+        # changing one configuration does not cause the others to be rebuilt
+        builddir_name = os.path.join(objdir_name, build_id)
+
         fileparts = [
             # Instantiation file
-            (os.path.join(objdir_name, 'core_inst.inc'), cxx_file(get_instantiation_header(len(elements['cores']), config_file, build_id=build_id))),
-            (os.path.join(objdir_name, 'core_inst.cc.inc'), cxx_file(get_instantiation_lines(build_id=build_id, **elements))),
+            (os.path.join(builddir_name, 'instantiation.inc'), cxx_file(get_instantiation_header(len(elements['cores']), config_file, build_id=build_id))),
+            (os.path.join(builddir_name, 'instantiation.cc.inc'), cxx_file(get_instantiation_lines(build_id=build_id, **elements))),
+
+            # Module registry, for environments built at runtime
+            (os.path.join(objdir_name, 'module_registry.inc'), cxx_file(get_module_registry_headers(registry_module_info))),
+            (os.path.join(objdir_name, 'module_registry_entries.inc'), cxx_file(get_module_registry_entries(registry_module_info))),
 
             # Makefile generation
             (os.path.join(makedir_name, '_configuration.mk'), (
@@ -44,6 +44,8 @@ core_builder_parts = {
     'sq_width': '.sq_width(champsim::bandwidth::maximum_type{{{sq_width}}})',
     'retire_width': '.retire_width(champsim::bandwidth::maximum_type{{{retire_width}}})',
     'mispredict_penalty': '.mispredict_penalty({mispredict_penalty})',
+    'model': '.model(champsim::core_model::{model})',
+    'core_type': '.core_type("{core_type}")',
     'decode_latency': '.decode_latency({decode_latency})',
     'dispatch_latency': '.dispatch_latency({dispatch_latency})',
     'schedule_latency': '.schedule_latency({schedule_latency})',
@@ -80,6 +82,7 @@ cache_builder_parts = {
     'max_tag_check': '.tag_bandwidth(champsim::bandwidth::maximum_type{{{max_tag_check}}})',
     'max_fill': '.fill_bandwidth(champsim::bandwidth::maximum_type{{{max_fill}}})',
     '_offset_bits': '.offset_bits(champsim::data::bits{{{_offset_bits}}})',
+    'set_sample_mask': '.set_sample_mask({set_sample_mask})',
     'prefetch_activate': '.prefetch_activate({^prefetch_activate_string})',
     '_replacement_data': '.replacement<{^replacement_string}>()',
     '_prefetcher_data': '.prefetcher<{^prefetcher_string}>()',
@@ -168,11 +171,17 @@ def get_cache_builder(elem, ul_pairs):
             '^lower_translate_queues': f'channels.at({ul_pairs.index((elem.get("lower_translate"), elem.get("name")))})'
         })
 
+    # If the geometry is known here, specialize the cache on it
+    geometry_parts = []
+    if all(isinstance(elem.get(k), int) and elem.get(k) > 0 for k in ('sets', 'ways')) and (elem['sets'] & (elem['sets'] - 1)) == 0 and '_offset_bits' in elem:
+        geometry_parts.append('.fixed_geometry<{sets}, {ways}, {_offset_bits}>()')
+
     builder_parts = itertools.chain(util.multiline(itertools.chain(
         ('champsim::cache_builder{{ {^defaults} }}',),
         required_parts,
         (v for k,v in cache_builder_parts.items() if k in elem),
-        (v for k,v in local_cache_builder_parts.items() if k[0] in elem and k[1] == elem[k[0]])
+        (v for k,v in local_cache_builder_parts.items() if k[0] in elem and k[1] == elem[k[0]]),
+        geometry_parts
     ), indent=1, line_end=''))
     yield from (part.format(**elem, **local_params) for part in builder_parts)
 
@@ -264,6 +273,12 @@ def ptw_queue_defaults(ptw):
         '_queue_check_full_addr': False
     }
 
+def get_bandwidth_allocation(pmem):
+    if 'bandwidth_allocation' not in pmem:
+        return
+    allocations = (f'{{{int(a.get("percent", 100))}, {int(a.get("priority", 0))}}}' for a in pmem['bandwidth_allocation'])
+    yield f'DRAM.set_allocations({{{", ".join(allocations)}}});'
+
 def get_upper_levels(cores, caches, ptws):
     ''' Get a sequence of (lower_name, upper_name) for the given elements. '''
     def named_selector(elem, key):
@@ -295,6 +310,34 @@ def module_include_files(datas):
 
     yield from (f'#include "{f}"' for _,f in candidates)
 
+registry_kinds = {
+    'pref': 'prefetcher',
+    'repl': 'replacement',
+    'branch': 'branch_predictor',
+    'btb': 'btb'
+}
+
+def get_module_registry_headers(module_info):
+    '''
+    Generate C++ include lines for every module listed in the module registry.
+
+    :param module_info: A dictionary from module type tags to dictionaries of module data
+    '''
+    datas = itertools.filterfalse(operator.methodcaller('get', 'legacy', False), itertools.chain(*(v.values() for v in module_info.values())))
+    yield from sorted(module_include_files(datas))
+
+def get_module_registry_entries(module_info):
+    '''
+    Generate the lines that register each compiled module under the name of its directory.
+    Environments that are built at runtime select modules through these names.
+
+    :param module_info: A dictionary from module type tags to dictionaries of module data
+    '''
+    for kind, datas in sorted(module_info.items()):
+        for data in sorted(datas.values(), key=operator.itemgetter('name')):
+            name = os.path.basename(os.path.normpath(data['path']))
+            yield f'CHAMPSIM_REGISTER_MODULE({registry_kinds[kind]}, "{name}", class {data["class"]})'
+
 def decorate_queues(caches, ptws, pmem):
     return util.chain(
             *({c['name']: cache_queue_defaults(c)} for c in caches),
@@ -391,6 +434,7 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
     yield from cache_instantiation_body
     yield from core_instantiation_body
     yield '{'
+    yield from get_bandwidth_allocation(pmem)
     yield '}'
     yield ''
 
@@ -76,6 +76,7 @@ def get_makefile_lines(build_id, executable, module_info):
     exe_basename = os.path.join('$(BIN_ROOT)', exe_basename)
     yield from hard_assign_variable('BIN_ROOT', exe_dirname)
     yield from hard_assign_variable('build_id', build_id, targets=[exe_basename])
+    yield from append_variable('build_ids', build_id)
 
     mod_paths = [relroot(mod["path"]) for mod in module_info.values()]
     yield from append_variable('nonbase_module_objs', '$(filter-out $(base_module_objs),$(call get_module_list,', *mod_paths, '))')
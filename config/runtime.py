@@ -0,0 +1,81 @@
+#    Copyright 2023 The ChampSim Contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import re
+
+from . import util
+
+def module_names(datas):
+    ''' Get the registry names of the given modules, which are the names of the directories that contain them. '''
+    return [os.path.basename(os.path.normpath(d['path'])) for d in datas]
+
+def single_module_names(element, kind):
+    ''' Get the registry name of the module of the given kind, rejecting an element that lists more than one, since a runtime configuration selects one module of each kind. '''
+    names = list(dict.fromkeys(module_names(element.get('_'+kind+'_data', [])))) # a module listed twice is still one module
+    if len(names) > 1:
+        raise ValueError(f'{element["name"]} lists {len(names)} modules for \'{kind}\', but a runtime configuration may select only one')
+    return names
+
+def offset_bits(val):
+    ''' Evaluate an offset given as a string of the form "champsim::lg2(N)" '''
+    match = re.fullmatch(r'champsim::lg2\((\d+)\)', str(val))
+    if match is not None:
+        return int(match.group(1)).bit_length() - 1
+    return int(val)
+
+def public_keys(element):
+    ''' Remove the keys that are private to the configuration system. '''
+    return {k:v for k,v in element.items() if not k.startswith('_')}
+
+# The resolved values replace any values the user gave, so these are not joined with util.chain()
+def runtime_core(cpu):
+    return {
+        **public_keys(cpu),
+        'index': cpu['_index'],
+        'branch_predictor': single_module_names(cpu, 'branch_predictor'),
+        'btb': single_module_names(cpu, 'btb')
+    }
+
+def runtime_cache(cache):
+    retval = {
+        **public_keys(cache),
+        'queue_factor': cache['_queue_factor'],
+        'offset_bits': offset_bits(cache['_offset_bits']),
+        'queue_check_full_addr': cache['_queue_check_full_addr'],
+        'prefetcher': single_module_names(cache, 'prefetcher'),
+        'replacement': single_module_names(cache, 'replacement')
+    }
+    if '_defaults' in cache:
+        retval['defaults'] = cache['_defaults'].replace('champsim::defaults::default_', '')
+    return retval
+
+def runtime_ptw(ptw):
+    return { **public_keys(ptw), 'queue_factor': ptw['_queue_factor'] }
+
+def get_runtime_config(cores, caches, ptws, pmem, vmem, config_file):
+    '''
+    Produce a fully resolved description of a configuration, which can be loaded by a simulator at startup.
+
+    All defaults are applied and all names are resolved, so the simulator does not need to repeat the work of the configuration system.
+    Modules are referred to by the names under which they are listed in the module registry.
+    '''
+    return {
+        **util.subdict(config_file, ('block_size', 'page_size')),
+        'cores': [runtime_core(c) for c in cores],
+        'caches': [runtime_cache(c) for c in caches],
+        'ptws': [runtime_ptw(p) for p in ptws],
+        'pmem': public_keys(pmem),
+        'vmem': public_keys(vmem)
+    }
@@ -16,8 +16,9 @@
 
 /** \file */
 
+// This header is included from within headers that also set the module flag aside, so it uses its own marker
 #ifdef CHAMPSIM_MODULE
-#define SET_ASIDE_CHAMPSIM_MODULE
+#define SET_ASIDE_CHAMPSIM_MODULE_ADDRESS
 #undef CHAMPSIM_MODULE
 #endif
 
@@ -668,7 +669,7 @@ struct fmt::formatter<champsim::address_slice<Extent>> {
 
 #endif
 
-#ifdef SET_ASIDE_CHAMPSIM_MODULE
-#undef SET_ASIDE_CHAMPSIM_MODULE
+#ifdef SET_ASIDE_CHAMPSIM_MODULE_ADDRESS
+#undef SET_ASIDE_CHAMPSIM_MODULE_ADDRESS
 #define CHAMPSIM_MODULE
 #endif
@@ -18,19 +18,21 @@
 #define BLOCK_H
 
 #include "champsim.h"
+#include "compact_address.h"
 
 namespace champsim
 {
+// The flags follow the wider members, so that they fill what would otherwise be padding
 struct cache_block {
+  champsim::block_address_storage address{};
+  champsim::block_address_storage v_address{};
+  champsim::block_address_storage data{};
+
+  uint32_t pf_metadata = 0;
+
   bool valid = false;
   bool prefetch = false;
   bool dirty = false;
-
-  champsim::address address{};
-  champsim::address v_address{};
-  champsim::address data{};
-
-  uint32_t pf_metadata = 0;
 };
 } // namespace champsim
 
@@ -0,0 +1,79 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BLOCK_ARRAY_H
+#define BLOCK_ARRAY_H
+
+#include <cstddef>
+#include <vector>
+
+#include "block.h"
+
+namespace champsim
+{
+/**
+ * The blocks of a cache, held in pages of consecutive sets that are allocated when one of their sets is first modified.
+ *
+ * Sets in pages that were never allocated are read as invalid blocks, so that a large cache whose footprint is sparse
+ * occupies host memory only for the sets that the simulation touches.
+ */
+class block_array
+{
+  std::size_t m_sets = 0;
+  std::size_t m_ways = 0;
+  std::vector<std::vector<cache_block>> m_pages{};
+  std::vector<cache_block> m_invalid_page{};
+
+  [[nodiscard]] std::size_t page_size() const;
+
+public:
+  /**
+   * The number of sets held by each page.
+   */
+  constexpr static std::size_t sets_per_page = 64;
+
+  block_array() = default;
+  block_array(std::size_t sets, std::size_t ways);
+
+  /**
+   * The first way of the set, allocating its page if needed.
+   */
+  cache_block* set(std::size_t set_idx);
+
+  /**
+   * The first way of the set. If the page of the set has not been allocated, its blocks are invalid.
+   */
+  [[nodiscard]] const cache_block* set(std::size_t set_idx) const;
+
+  cache_block& at(std::size_t idx);
+  [[nodiscard]] const cache_block& at(std::size_t idx) const;
+
+  /**
+   * Mark every block invalid. Pages that have not been allocated stay unallocated.
+   */
+  void invalidate();
+
+  [[nodiscard]] std::size_t size() const { return m_sets * m_ways; }
+  [[nodiscard]] std::size_t page_count() const { return std::size(m_pages); }
+
+  /**
+   * The number of pages that hold blocks in host memory.
+   */
+  [[nodiscard]] std::size_t allocated_pages() const;
+};
+} // namespace champsim
+
+#endif
@@ -37,13 +37,17 @@
 #include "address.h"
 #include "bandwidth.h"
 #include "block.h"
+#include "block_array.h"
 #include "cache_builder.h"
+#include "cache_geometry.h"
 #include "cache_stats.h"
 #include "champsim.h"
 #include "channel.h"
 #include "chrono.h"
 #include "modules.h"
 #include "operable.h"
+#include "pooled_list.h"
+#include "set_sampler.h"
 #include "util/to_underlying.h" // for to_underlying
 #include "waitable.h"
 
@@ -77,11 +81,11 @@ class CACHE : public champsim::operable
 
     champsim::chrono::clock::time_point event_cycle = champsim::chrono::clock::time_point::max();
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::pooled_list<uint64_t> instr_depend_on_me{};
+    champsim::pooled_list<std::deque<response_type>*> to_return{};
 
-    explicit tag_lookup_type(request_type req) : tag_lookup_type(req, false, false) {}
-    tag_lookup_type(const request_type& req, bool local_pref, bool skip);
+    explicit tag_lookup_type(request_type req) : tag_lookup_type(std::move(req), false, false) {}
+    tag_lookup_type(request_type req, bool local_pref, bool skip);
   };
 
 public:
@@ -105,11 +109,11 @@ public:
 
     champsim::chrono::clock::time_point time_enqueued;
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::pooled_list<uint64_t> instr_depend_on_me{};
+    champsim::pooled_list<std::deque<response_type>*> to_return{};
 
     mshr_type(const tag_lookup_type& req, champsim::chrono::clock::time_point _time_enqueued);
-    static mshr_type merge(mshr_type predecessor, mshr_type successor);
+    static mshr_type merge(mshr_type&& predecessor, mshr_type&& successor);
   };
 
 private:
@@ -119,19 +123,25 @@ private:
   bool handle_write(const tag_lookup_type& handle_pkt);
   void finish_packet(const response_type& packet);
   void finish_translation(const response_type& packet);
+  void record_sampled_miss(champsim::address address);
 
   void issue_translation(tag_lookup_type& q_entry) const;
 
+protected:
+  void clock_period_changed(champsim::chrono::picoseconds old_period) final;
+
 public:
   using BLOCK = champsim::cache_block;
 
 private:
-  static BLOCK fill_block(mshr_type mshr, uint32_t metadata);
-  using set_type = std::vector<BLOCK>;
+  static BLOCK fill_block(const mshr_type& mshr, uint32_t metadata);
+  using set_type = champsim::block_array;
 
-  std::pair<set_type::iterator, set_type::iterator> get_set_span(champsim::address address);
-  [[nodiscard]] std::pair<set_type::const_iterator, set_type::const_iterator> get_set_span(champsim::address address) const;
+  std::pair<BLOCK*, BLOCK*> get_set_span(champsim::address address);
+  [[nodiscard]] std::pair<const BLOCK*, const BLOCK*> get_set_span(champsim::address address) const;
   [[nodiscard]] long get_set_index(champsim::address address) const;
+  static const champsim::cache_geometry_table* checked_geometry(const champsim::cache_geometry_table* geometry, uint32_t sets, uint32_t ways,
+                                                                 champsim::data::bits offset_bits);
 
   template <typename T>
   bool should_activate_prefetcher(const T& pkt) const;
@@ -148,6 +158,7 @@ private:
   std::deque<tag_lookup_type> internal_PQ{};
   std::deque<tag_lookup_type> inflight_tag_check{};
   std::deque<tag_lookup_type> translation_stash{};
+  std::deque<tag_lookup_type> unsampled_returns{};
 
 public:
   std::vector<channel_type*> upper_levels;
@@ -161,13 +172,23 @@ public:
   champsim::chrono::clock::duration HIT_LATENCY;
   champsim::chrono::clock::duration FILL_LATENCY;
   champsim::data::bits OFFSET_BITS;
-  set_type block{static_cast<typename set_type::size_type>(NUM_SET * NUM_WAY)};
+  set_type block{NUM_SET, NUM_WAY};
   champsim::bandwidth::maximum_type MAX_TAG, MAX_FILL;
   bool prefetch_as_load;
   bool match_offset_bits;
   bool virtual_prefetch;
   std::vector<access_type> pref_activate_mask;
 
+  /**
+   * The set selection and way searches specialized on the geometry of this cache, if it was fixed when the simulator was built, or nullptr.
+   */
+  const champsim::cache_geometry_table* fixed_geometry;
+
+  /**
+   * The sets that are simulated in detail. Unless the cache samples its sets, all of them are.
+   */
+  champsim::set_sampler sampler;
+
   using stats_type = cache_stats;
 
   stats_type sim_stats, roi_stats;
@@ -210,6 +231,11 @@ public:
   [[deprecated("This function should not be used to access the blocks directly.")]] [[nodiscard]] uint64_t get_way(uint64_t address, uint64_t set) const;
 
   long invalidate_entry(champsim::address inval_addr);
+
+  /**
+   * Invalidate every block, without writing back dirty blocks. This is intended for caches that hold translations.
+   */
+  void invalidate_all();
   bool prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
 
   [[deprecated]] bool prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
@@ -321,6 +347,7 @@ public:
         NUM_WAY(b.get_num_ways()), MSHR_SIZE(b.get_num_mshrs()), PQ_SIZE(b.m_pq_size), HIT_LATENCY(b.get_hit_latency() * b.m_clock_period),
         FILL_LATENCY(b.get_fill_latency() * b.m_clock_period), OFFSET_BITS(b.m_offset_bits), MAX_TAG(b.get_tag_bandwidth()), MAX_FILL(b.get_fill_bandwidth()),
         prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), pref_activate_mask(b.m_pref_act_mask),
+        fixed_geometry(checked_geometry(b.m_geometry, NUM_SET, NUM_WAY, OFFSET_BITS)), sampler(NUM_SET, b.m_sample_mask),
         pref_module_pimpl(std::make_unique<prefetcher_module_model<Ps...>>(this)), repl_module_pimpl(std::make_unique<replacement_module_model<Rs...>>(this))
   {
   }
@@ -22,7 +22,10 @@
 #include <cstdint>
 #include <limits>
 #include <optional>
+#include <utility>
+#include <vector>
 
+#include "cache_geometry.h"
 #include "champsim.h"
 #include "channel.h"
 #include "chrono.h"
@@ -54,6 +57,8 @@ struct cache_builder_base {
   std::optional<champsim::bandwidth::maximum_type> m_max_tag{};
   std::optional<champsim::bandwidth::maximum_type> m_max_fill{};
   champsim::data::bits m_offset_bits{LOG2_BLOCK_SIZE};
+  const cache_geometry_table* m_geometry{nullptr};
+  uint64_t m_sample_mask{};
   bool m_pref_load{};
   bool m_wq_full_addr{};
   bool m_va_pref{};
@@ -182,6 +187,19 @@ public:
    */
   self_type& log2_offset_bits(unsigned log2_offset_bits_);
 
+  /**
+   * Specify the number of sets, the number of ways, and the number of offset bits, all known when the simulator is built.
+   * The cache's set selection and way searches are then specialized on them.
+   */
+  template <uint32_t SETS, uint32_t WAYS, unsigned OFFSET_BITS>
+  self_type& fixed_geometry();
+
+  /**
+   * Specify that only the sets whose index has no bits in common with the mask are simulated in detail.
+   * Accesses to the other sets are serviced at the average latency of the sampled sets, and the statistics are extrapolated from the sampled sets.
+   */
+  self_type& set_sample_mask(uint64_t set_sample_mask_);
+
   /**
    * Specify that prefetches should be issued with the same priority as loads.
    */
@@ -218,6 +236,11 @@ public:
   template <typename... Elems>
   self_type& prefetch_activate(Elems... pref_act_elems);
 
+  /**
+   * Specify the ``access_type`` values that should activate the prefetcher, as a list that is known only at runtime.
+   */
+  self_type& prefetch_activate(std::vector<access_type>&& pref_act_mask_);
+
   /**
    * Specify the upper levels to this cache.
    */
@@ -443,6 +466,17 @@ auto champsim::cache_builder<P, R>::log2_offset_bits(unsigned log2_offset_bits_)
   return offset_bits(champsim::data::bits{1ull << log2_offset_bits_});
 }
 
+template <typename P, typename R>
+template <uint32_t SETS, uint32_t WAYS, unsigned OFFSET_BITS>
+auto champsim::cache_builder<P, R>::fixed_geometry() -> self_type&
+{
+  m_sets = SETS;
+  m_ways = WAYS;
+  m_offset_bits = champsim::data::bits{OFFSET_BITS};
+  m_geometry = &champsim::fixed_cache_geometry<SETS, WAYS, OFFSET_BITS>::table;
+  return *this;
+}
+
 template <typename P, typename R>
 auto champsim::cache_builder<P, R>::set_prefetch_as_load() -> self_type&
 {
@@ -471,6 +505,13 @@ auto champsim::cache_builder<P, R>::reset_wq_checks_full_addr() -> self_type&
   return *this;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_sample_mask(uint64_t set_sample_mask_) -> self_type&
+{
+  m_sample_mask = set_sample_mask_;
+  return *this;
+}
+
 template <typename P, typename R>
 auto champsim::cache_builder<P, R>::set_virtual_prefetch() -> self_type&
 {
@@ -493,6 +534,13 @@ auto champsim::cache_builder<P, R>::prefetch_activate(Elems... pref_act_elems) -
   return *this;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::prefetch_activate(std::vector<access_type>&& pref_act_mask_) -> self_type&
+{
+  m_pref_act_mask = std::move(pref_act_mask_);
+  return *this;
+}
+
 template <typename P, typename R>
 auto champsim::cache_builder<P, R>::upper_levels(std::vector<champsim::channel*>&& uls_) -> self_type&
 {
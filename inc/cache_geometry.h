@@ -0,0 +1,164 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CACHE_GEOMETRY_H
+#define CACHE_GEOMETRY_H
+
+#include <cstdint>
+
+#include "address.h"
+#include "block.h"
+#include "util/bits.h"
+#include "util/to_underlying.h"
+
+namespace champsim
+{
+namespace detail
+{
+/**
+ * Search a set of the given associativity. The trip count is constant, so that the compiler can unroll the loop.
+ */
+template <long WAYS, bool CHECK_VALID>
+long find_in_set(const cache_block* set, uint64_t match, unsigned offset_bits)
+{
+  for (long way = 0; way < WAYS; ++way) {
+    if ((!CHECK_VALID || set[way].valid) && (champsim::address{set[way].address}.to<uint64_t>() >> offset_bits) == match) {
+      return way;
+    }
+  }
+  return WAYS;
+}
+
+template <long WAYS>
+long find_invalid_in_set(const cache_block* set)
+{
+  for (long way = 0; way < WAYS; ++way) {
+    if (!set[way].valid) {
+      return way;
+    }
+  }
+  return WAYS;
+}
+} // namespace detail
+
+/**
+ * The operations of a cache that depend only on its geometry.
+ * Caches whose geometry is known when the simulator is built use a table that is specialized on it (see fixed_cache_geometry),
+ * while other caches compute these from their runtime geometry.
+ *
+ * The operations are inline and dispatch on the associativity with a switch, so that the searches of the common associativities have a constant
+ * trip count without an indirect call.
+ */
+struct cache_geometry_table {
+  uint32_t sets;
+  uint32_t ways;
+  champsim::data::bits offset_bits;
+
+  /**
+   * The index of the set that holds the address.
+   */
+  [[nodiscard]] long set_index(champsim::address addr) const
+  {
+    return static_cast<long>((addr.to<uint64_t>() >> champsim::to_underlying(offset_bits)) & (uint64_t{sets} - 1));
+  }
+
+  /**
+   * The first way of the set that holds a valid copy of the address, or the number of ways if there is none.
+   */
+  [[nodiscard]] long find_valid(const cache_block* set, champsim::address addr) const { return find<true>(set, addr); }
+
+  /**
+   * The first way of the set that holds the address, whether or not it is valid, or the number of ways if there is none.
+   */
+  [[nodiscard]] long find_any(const cache_block* set, champsim::address addr) const { return find<false>(set, addr); }
+
+  /**
+   * The first invalid way of the set, or the number of ways if there is none.
+   */
+  [[nodiscard]] long find_invalid(const cache_block* set) const
+  {
+    switch (ways) {
+    case 4:
+      return detail::find_invalid_in_set<4>(set);
+    case 8:
+      return detail::find_invalid_in_set<8>(set);
+    case 12:
+      return detail::find_invalid_in_set<12>(set);
+    case 16:
+      return detail::find_invalid_in_set<16>(set);
+    default:
+      for (long way = 0; way < long{ways}; ++way) {
+        if (!set[way].valid) {
+          return way;
+        }
+      }
+      return long{ways};
+    }
+  }
+
+private:
+  template <bool CHECK_VALID>
+  [[nodiscard]] long find(const cache_block* set, champsim::address addr) const
+  {
+    const auto shift = static_cast<unsigned>(champsim::to_underlying(offset_bits));
+    const auto match = addr.to<uint64_t>() >> shift;
+    switch (ways) {
+    case 4:
+      return detail::find_in_set<4, CHECK_VALID>(set, match, shift);
+    case 8:
+      return detail::find_in_set<8, CHECK_VALID>(set, match, shift);
+    case 12:
+      return detail::find_in_set<12, CHECK_VALID>(set, match, shift);
+    case 16:
+      return detail::find_in_set<16, CHECK_VALID>(set, match, shift);
+    default:
+      for (long way = 0; way < long{ways}; ++way) {
+        if ((!CHECK_VALID || set[way].valid) && (champsim::address{set[way].address}.to<uint64_t>() >> shift) == match) {
+          return way;
+        }
+      }
+      return long{ways};
+    }
+  }
+};
+
+/**
+ * Set selection and way searches for a cache with the given geometry.
+ * The set index is a constant shift and mask, and the way searches have a constant trip count, so that the compiler can unroll them.
+ */
+template <uint32_t SETS, uint32_t WAYS, unsigned OFFSET_BITS>
+struct fixed_cache_geometry {
+  static_assert(champsim::is_power_of_2(SETS), "The number of sets must be a power of two");
+  static_assert(WAYS > 0, "A cache must have at least one way");
+
+  constexpr static champsim::data::bits offset_bits{OFFSET_BITS};
+  constexpr static champsim::data::bits index_bits{OFFSET_BITS + champsim::lg2(SETS)};
+
+  static long set_index(champsim::address addr) { return addr.slice<index_bits, offset_bits>().template to<long>(); }
+
+  template <bool CHECK_VALID>
+  static long find(const cache_block* set, champsim::address addr)
+  {
+    return detail::find_in_set<long{WAYS}, CHECK_VALID>(set, addr.to<uint64_t>() >> OFFSET_BITS, OFFSET_BITS);
+  }
+
+  static long find_invalid(const cache_block* set) { return detail::find_invalid_in_set<long{WAYS}>(set); }
+
+  constexpr static cache_geometry_table table{SETS, WAYS, offset_bits};
+};
+} // namespace champsim
+
+#endif
@@ -5,12 +5,16 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "channel.h"
 #include "event_counter.h"
 
 struct cache_stats {
   std::string name;
+  long long begin_cycles = 0;
+  long long end_cycles = 0;
+
   // prefetch stats
   uint64_t pf_requested = 0;
   uint64_t pf_issued = 0;
@@ -24,8 +28,36 @@ struct cache_stats {
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> mshr_return = {};
 
   long total_miss_latency_cycles{};
+
+  // If the cache samples its sets, the counts above include only the sampled sets
+  long sampled_sets = 0;
+  long total_sets = 0;
+  std::vector<uint64_t> sampled_set_misses = {};
+
+  [[nodiscard]] auto cycles() const { return end_cycles - begin_cycles; }
 };
 
 cache_stats operator-(cache_stats lhs, cache_stats rhs);
 
+namespace champsim
+{
+/**
+ * A total over all sets of a cache, extrapolated from its sampled sets, with the half-width of its 95% confidence interval.
+ */
+struct sampled_estimate {
+  double value;
+  double confidence;
+};
+
+/**
+ * Whether the statistics cover only a sample of the sets.
+ */
+bool is_sampled(const cache_stats& stats);
+
+/**
+ * Extrapolate the misses of all sets from the misses of the sampled sets.
+ */
+sampled_estimate estimate_misses(const cache_stats& stats);
+} // namespace champsim
+
 #endif
@@ -0,0 +1,81 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLOCK_SCHEDULE_H
+#define CLOCK_SCHEDULE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "chrono.h"
+#include "operable.h"
+
+namespace champsim
+{
+/**
+ * Operates a set of components as the global clock advances, sorted by their local times.
+ *
+ * Components with fixed clock periods operate in a pattern that repeats every least common multiple of their periods and of the global clock's tick.
+ * The schedule records the order in which components operate in each tick of that pattern once, and replays it.
+ * If the clock period of any component changes, or the global clock does not advance by the expected tick, the pattern is recorded again.
+ * Patterns longer than max_ticks are not recorded. Instead, every tick sorts the components by their local times.
+ */
+class clock_schedule
+{
+  std::vector<std::reference_wrapper<operable>> m_operables;
+  std::vector<std::reference_wrapper<operable>> m_sorted;
+  champsim::chrono::clock::duration m_quantum;
+
+  std::vector<champsim::chrono::picoseconds> m_periods{};
+  std::vector<uint32_t> m_order{};
+  std::vector<std::size_t> m_tick_begin{};
+  std::size_t m_tick = 0;
+  champsim::chrono::clock::time_point m_expected_now{};
+  bool m_precomputed = false;
+
+  [[nodiscard]] bool periods_changed() const;
+  bool record(champsim::chrono::clock::time_point now);
+  long operate_sorted(const champsim::chrono::clock& clock);
+
+public:
+  /**
+   * The longest pattern, in ticks of the global clock, that a schedule records.
+   */
+  constexpr static std::size_t max_ticks = 4096;
+
+  clock_schedule(std::vector<std::reference_wrapper<operable>> operables, champsim::chrono::clock::duration quantum);
+
+  /**
+   * Operate every component until its local time reaches the time of the clock, and return the total progress.
+   * The clock is expected to have advanced by one tick since the previous call.
+   */
+  long operate_on(const champsim::chrono::clock& clock);
+
+  /**
+   * Whether the most recent tick was replayed from a recorded pattern.
+   */
+  [[nodiscard]] bool is_precomputed() const { return m_precomputed; }
+
+  /**
+   * The number of ticks in the recorded pattern, or 0 if none is recorded.
+   */
+  [[nodiscard]] std::size_t period_ticks() const { return m_precomputed ? std::size(m_tick_begin) - 1 : 0; }
+};
+} // namespace champsim
+
+#endif
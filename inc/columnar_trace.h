@@ -0,0 +1,180 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COLUMNAR_TRACE_H
+#define COLUMNAR_TRACE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "trace_instruction.h"
+
+/**
+ * The columnar trace format stores input_instr records in independently decodable blocks. Within each block, the fields of the records are stored as
+ * separate columns, each with an encoding suited to its contents:
+ *
+ * - Instruction pointers are stored as zigzag-encoded variable-length deltas from the previous instruction.
+ * - The branch flags are stored as bitmaps.
+ * - The register operands of each instruction are replaced by an index into a dictionary of the distinct register tuples in the block.
+ * - Each of the memory operand slots is stored as a presence bitmap, followed by zigzag-encoded variable-length deltas from the previous address in that slot.
+ *
+ * A file begins with an 8-byte header, and each block is preceded by its instruction count and payload length. The format is typically much smaller
+ * than the raw records, and it can be further compressed with any of the general-purpose compressors that the trace reader supports.
+ */
+namespace champsim::columnar
+{
+constexpr std::array<char, 4> file_magic{'C', 'S', 'C', 'T'};
+constexpr uint8_t format_version = 1;
+constexpr std::size_t file_header_size = 8;
+constexpr std::size_t block_header_size = 8;
+constexpr std::size_t default_block_size = 1 << 16;
+
+/**
+ * Produce the header that begins every columnar trace file.
+ */
+std::array<char, file_header_size> file_header();
+
+/**
+ * Check a file header.
+ *
+ * \throws std::invalid_argument if the header does not describe a columnar trace of a supported version
+ */
+void check_file_header(const std::array<char, file_header_size>& header);
+
+/**
+ * Encode the records in the range as a single block, including its block header, and append it to the output.
+ */
+void encode_block(const input_instr* begin, const input_instr* end, std::vector<char>& out);
+
+/**
+ * Decode a block payload (excluding its block header) that holds the given number of records, appending them to the output.
+ *
+ * \throws std::invalid_argument if the payload is malformed
+ */
+void decode_block(const char* begin, const char* end, std::size_t num_instrs, std::vector<input_instr>& out);
+
+/**
+ * An input byte stream that decodes a columnar trace from an underlying stream, producing the bytes of the equivalent raw input_instr records.
+ *
+ * This can be used as the stream of a bulk_tracereader, and may itself read from any stream that bulk_tracereader supports, including the decompressing
+ * inf_istream.
+ */
+template <typename F>
+class columnar_istream
+{
+  F underlying;
+  bool header_checked = false;
+  bool eof_ = false;
+  std::streamsize gcount_ = 0;
+
+  std::vector<char> payload{};
+  std::vector<input_instr> decoded{};
+  std::size_t decoded_pos = 0; // in bytes
+
+  bool read_block();
+  bool read_exactly(char* s, std::size_t count);
+
+public:
+  using char_type = char;
+
+  explicit columnar_istream(std::string s) : underlying(s) {}
+  explicit columnar_istream(F&& str) : underlying(std::move(str)) {}
+
+  columnar_istream& read(char* s, std::streamsize count);
+
+  [[nodiscard]] bool eof() const { return eof_; }
+  [[nodiscard]] bool fail() const { return eof_; }
+  [[nodiscard]] std::streamsize gcount() const { return gcount_; }
+};
+
+/**
+ * Read the given number of bytes. The trace may end cleanly before the first of them, but not partway through.
+ *
+ * \throws std::invalid_argument if the trace ends after some but not all of the bytes
+ */
+template <typename F>
+bool columnar_istream<F>::read_exactly(char* s, std::size_t count)
+{
+  underlying.read(s, static_cast<std::streamsize>(count));
+  auto bytes_read = static_cast<std::size_t>(underlying.gcount());
+  if (bytes_read != 0 && bytes_read != count) {
+    throw std::invalid_argument{"Columnar trace block is truncated"};
+  }
+  return bytes_read == count;
+}
+
+template <typename F>
+bool columnar_istream<F>::read_block()
+{
+  if (!header_checked) {
+    std::array<char, file_header_size> header{};
+    if (!read_exactly(std::data(header), std::size(header))) {
+      return false;
+    }
+    check_file_header(header);
+    header_checked = true;
+  }
+
+  std::array<char, block_header_size> block_header{};
+  if (!read_exactly(std::data(block_header), std::size(block_header))) {
+    return false;
+  }
+
+  uint32_t num_instrs = 0;
+  uint32_t payload_size = 0;
+  std::memcpy(&num_instrs, std::data(block_header), sizeof(num_instrs));
+  std::memcpy(&payload_size, std::next(std::data(block_header), sizeof(num_instrs)), sizeof(payload_size));
+
+  // Once a block header has been read, its payload must follow in full
+  payload.resize(payload_size);
+  if (payload_size > 0 && !read_exactly(std::data(payload), payload_size)) {
+    throw std::invalid_argument{"Columnar trace block is truncated"};
+  }
+
+  decoded.clear();
+  decode_block(std::data(payload), std::next(std::data(payload), payload_size), num_instrs, decoded);
+  decoded_pos = 0;
+  return true;
+}
+
+template <typename F>
+auto columnar_istream<F>::read(char* s, std::streamsize count) -> columnar_istream&
+{
+  gcount_ = 0;
+  while (gcount_ < count && !eof_) {
+    auto available = std::size(decoded) * sizeof(input_instr) - decoded_pos;
+    if (available == 0) {
+      eof_ = !read_block();
+      continue;
+    }
+
+    auto to_copy = std::min(available, static_cast<std::size_t>(count - gcount_));
+    std::memcpy(std::next(s, gcount_), std::next(reinterpret_cast<const char*>(std::data(decoded)), static_cast<long>(decoded_pos)), // NOLINT: records are trivial
+                to_copy);
+    decoded_pos += to_copy;
+    gcount_ += static_cast<std::streamsize>(to_copy);
+  }
+  return *this;
+}
+} // namespace champsim::columnar
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPACT_ADDRESS_H
+#define COMPACT_ADDRESS_H
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#include "address.h"
+#include "champsim.h"
+
+namespace champsim
+{
+/**
+ * The number of a block, packed without padding into the given number of bits.
+ *
+ * The top byte of an address (which holds the address space tag of a trace that the scheduler runs) is kept in the top 8 bits, and the lowest bits
+ * hold the low part of the block number. The bits between them must be zero, so the widest address that can be held, not counting its top byte, is
+ * given by address_bits(). The virtual memory rejects configurations whose addresses are wider when it is built.
+ *
+ * A compact block address converts to and from a champsim::address, so that code that reads it sees an ordinary address.
+ * The offset within the block is not kept.
+ */
+template <unsigned BITS>
+class compact_block_address
+{
+  static_assert(BITS >= 16 && BITS <= 56, "A compact block address must hold between 16 and 56 bits");
+
+  std::array<uint8_t, (BITS + 7) / 8> m_bytes{};
+
+public:
+  constexpr static unsigned bits = BITS;
+  constexpr static unsigned tag_bits = 8;
+  constexpr static unsigned tag_shift = 64 - tag_bits;
+  constexpr static unsigned low_bits = BITS - tag_bits;
+
+  /**
+   * The width of the widest address that can be held, not counting its top byte.
+   */
+  static unsigned address_bits() { return low_bits + LOG2_BLOCK_SIZE; }
+
+  compact_block_address() = default;
+
+  /**
+   * \throws std::range_error if the address is wider than address_bits().
+   */
+  compact_block_address(champsim::address addr); // NOLINT: implicitly converts from an address
+
+  operator champsim::address() const; // NOLINT: implicitly converts to an address
+
+  [[nodiscard]] uint64_t block_number() const;
+
+  friend bool operator==(const compact_block_address& lhs, const compact_block_address& rhs) { return lhs.m_bytes == rhs.m_bytes; }
+  friend bool operator!=(const compact_block_address& lhs, const compact_block_address& rhs) { return !(lhs == rhs); }
+};
+
+#ifdef CHAMPSIM_COMPACT_ADDRESS_BITS
+/**
+ * The type that cache blocks use to store their addresses.
+ * Builds with COMPACT_ADDRESS_BITS set store block numbers of that width, and other builds store full addresses.
+ */
+using block_address_storage = compact_block_address<CHAMPSIM_COMPACT_ADDRESS_BITS>;
+
+/**
+ * The width of the widest address, not counting its top byte, that cache blocks can hold.
+ */
+inline champsim::data::bits block_address_storage_bits() { return champsim::data::bits{block_address_storage::address_bits()}; }
+#else
+using block_address_storage = champsim::address;
+inline champsim::data::bits block_address_storage_bits() { return champsim::address::bits; }
+#endif
+} // namespace champsim
+
+template <unsigned BITS>
+champsim::compact_block_address<BITS>::compact_block_address(champsim::address addr)
+{
+  const auto raw = addr.to<uint64_t>();
+  const auto block = (raw & ((uint64_t{1} << tag_shift) - 1)) >> LOG2_BLOCK_SIZE;
+  if ((block >> low_bits) != 0) {
+    throw std::range_error{
+        fmt::format("The address {} is wider than the {}-bit addresses that cache blocks of this build hold. Rebuild with a larger COMPACT_ADDRESS_BITS.",
+                    addr, address_bits())};
+  }
+
+  auto packed = block | ((raw >> tag_shift) << low_bits);
+  for (auto& byte : m_bytes) {
+    byte = static_cast<uint8_t>(packed);
+    packed >>= 8;
+  }
+}
+
+template <unsigned BITS>
+uint64_t champsim::compact_block_address<BITS>::block_number() const
+{
+  uint64_t packed = 0;
+  for (auto it = std::rbegin(m_bytes); it != std::rend(m_bytes); ++it) {
+    packed = (packed << 8) | *it;
+  }
+  const auto tag = packed >> low_bits;
+  return (tag << (tag_shift - LOG2_BLOCK_SIZE)) | (packed & ((uint64_t{1} << low_bits) - 1));
+}
+
+template <unsigned BITS>
+champsim::compact_block_address<BITS>::operator champsim::address() const
+{
+  return champsim::address{block_number() << LOG2_BLOCK_SIZE};
+}
+
+#endif
@@ -19,6 +19,8 @@
 
 #include <cstdint>
 #include <limits>
+#include <string>
+#include <utility>
 
 #include "chrono.h"
 
@@ -31,10 +33,21 @@ template <typename...>
 class core_builder_module_type_holder
 {
 };
+
+/**
+ * The timing model that a core uses to advance through its trace.
+ */
+enum class core_model {
+  out_of_order, /**< Model each stage of the out-of-order pipeline */
+  interval      /**< Dispatch at full width between miss events, and account for the miss events as intervals */
+};
+
 namespace detail
 {
 struct core_builder_base {
   uint32_t m_cpu{};
+  core_model m_model{core_model::out_of_order};
+  std::string m_core_type{"default"};
   champsim::chrono::picoseconds m_clock_period{250};
   std::size_t m_dib_set{1};
   std::size_t m_dib_way{1};
@@ -93,6 +106,16 @@ public:
 
   self_type& index(uint32_t cpu_);
 
+  /**
+   * Specify the timing model of the core.
+   */
+  self_type& model(core_model model_);
+
+  /**
+   * Specify the name of the kind of core, for example "big" or "little". Traces can migrate between cores of different types.
+   */
+  self_type& core_type(std::string core_type_);
+
   /**
    * Specify the core's clock period.
    */
@@ -276,6 +299,20 @@ auto champsim::core_builder<B, T>::index(uint32_t cpu_) -> self_type&
   return *this;
 }
 
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::model(core_model model_) -> self_type&
+{
+  m_model = model_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::core_type(std::string core_type_) -> self_type&
+{
+  m_core_type = std::move(core_type_);
+  return *this;
+}
+
 template <typename B, typename T>
 auto champsim::core_builder<B, T>::clock_period(champsim::chrono::picoseconds clock_period_) -> self_type&
 {
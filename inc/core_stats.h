@@ -15,6 +15,11 @@ struct cpu_stats {
   long long end_cycles = 0;
   uint64_t total_rob_occupancy_at_branch_mispredict = 0;
 
+  // Cycles in which the core had no instructions to fetch because its trace waited on another trace
+  long long lock_wait_cycles = 0;
+  long long barrier_wait_cycles = 0;
+  uint64_t sync_events = 0;
+
   champsim::stats::event_counter<branch_type> total_branch_types = {};
   champsim::stats::event_counter<branch_type> branch_type_misses = {};
 
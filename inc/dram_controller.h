@@ -24,8 +24,10 @@
 #include <deque>    // for deque
 #include <iterator> // for end
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 
 #include "address.h"
 #include "channel.h"
@@ -33,6 +35,9 @@
 #include "dram_stats.h"
 #include "extent_set.h"
 #include "operable.h"
+#include "pooled_list.h"
+#include "token_bucket.h"
+#include "worker_pool.h"
 
 struct DRAM_ADDRESS_MAPPING {
   constexpr static std::size_t SLICER_OFFSET_IDX = 0;
@@ -102,16 +107,18 @@ struct DRAM_CHANNEL final : public champsim::operable {
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     uint32_t pf_metadata = 0;
+    uint32_t cpu = std::numeric_limits<uint32_t>::max();
 
     champsim::address address{};
     champsim::address v_address{};
     champsim::address data{};
     champsim::chrono::clock::time_point ready_time = champsim::chrono::clock::time_point::max();
+    champsim::chrono::clock::time_point enqueue_time{};
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::pooled_list<uint64_t> instr_depend_on_me{};
+    champsim::pooled_list<std::deque<response_type>*> to_return{};
 
-    explicit request_type(const typename champsim::channel::request_type& req);
+    explicit request_type(typename champsim::channel::request_type req);
   };
   using value_type = request_type;
   using queue_type = std::vector<std::optional<value_type>>;
@@ -135,6 +142,12 @@ struct DRAM_CHANNEL final : public champsim::operable {
 
   const champsim::data::bytes channel_width;
 
+  /**
+   * Responses that this channel has finished, with the queue that each will be returned to.
+   * The memory controller moves them into those queues after every channel has operated, so that the channels do not share any queues.
+   */
+  std::vector<std::pair<std::deque<response_type>*, response_type>> finished{};
+
   using request_array_type = std::vector<BANK_REQUEST>;
   request_array_type bank_request;
   request_array_type::iterator active_request;
@@ -188,15 +201,39 @@ struct DRAM_CHANNEL final : public champsim::operable {
 
 class MEMORY_CONTROLLER : public champsim::operable
 {
+public:
+  /**
+   * The share of the memory bandwidth given to one core.
+   * When the channel queues have room for requests of several cores, the requests of cores with a higher priority enter first.
+   */
+  struct core_allocation {
+    unsigned percent = 100; // of the peak bandwidth of all channels
+    unsigned priority = 0;
+  };
+
+  /**
+   * The number of requests a core may send at once after it has been idle, even if its share of the bandwidth is limited
+   */
+  constexpr static std::size_t allocation_burst = 16;
+
+private:
   using channel_type = champsim::channel;
   using request_type = typename channel_type::request_type;
   using response_type = typename channel_type::response_type;
   std::vector<channel_type*> queues;
   const champsim::data::bytes channel_width;
 
+  std::vector<core_allocation> allocations{};
+  std::vector<champsim::token_bucket> throttles{};
+
+  std::unique_ptr<champsim::worker_pool> workers = std::make_unique<champsim::worker_pool>(1);
+  std::vector<long> channel_progress{};
+
   void initiate_requests();
-  bool add_rq(const request_type& packet, champsim::channel* ul);
-  bool add_wq(const request_type& packet);
+  template <typename Q, typename F>
+  void admit(Q& queue, F&& add);
+  bool add_rq(request_type&& packet, champsim::channel* ul);
+  bool add_wq(request_type&& packet);
 
   const DRAM_ADDRESS_MAPPING address_mapping;
 
@@ -217,6 +254,21 @@ public:
   void end_phase(unsigned cpu) final;
   void print_deadlock() final;
 
+  /**
+   * Limit the bandwidth that each core may use, in the manner of memory bandwidth allocation.
+   * The requests of each core are admitted into the channel queues at no more than its share of the peak bandwidth, with bursts of up to
+   * allocation_burst requests. Cores beyond the end of the list are not limited.
+   *
+   * \throws std::invalid_argument if a share is not between 1 and 100 percent
+   */
+  void set_allocations(std::vector<core_allocation> allocs);
+
+  /**
+   * Operate the channels in parallel on the given number of threads, including the simulation thread.
+   * The results do not depend on the number of threads.
+   */
+  void set_threads(std::size_t threads);
+
   [[nodiscard]] champsim::data::bytes size() const;
 };
 
@@ -1,8 +1,21 @@
 #ifndef DRAM_STATS_H
 #define DRAM_STATS_H
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
+
+#include "chrono.h"
+
+/**
+ * The traffic of one core through a DRAM channel
+ */
+struct dram_core_stats {
+  uint64_t requests = 0;
+  uint64_t throttled_request_cycles = 0; // cycles that each request waited for a token before entering the channel queues, summed over the requests
+  uint64_t queue_cycles = 0;             // cycles that requests spent in the channel queues before their data was transferred
+};
 
 struct dram_stats {
   std::string name{};
@@ -10,8 +23,16 @@ struct dram_stats {
   uint64_t dbus_count_congested = 0;
   uint64_t refresh_cycles = 0;
   unsigned WQ_ROW_BUFFER_HIT = 0, WQ_ROW_BUFFER_MISS = 0, RQ_ROW_BUFFER_HIT = 0, RQ_ROW_BUFFER_MISS = 0, WQ_FULL = 0;
+
+  champsim::chrono::clock::duration elapsed{};
+  std::vector<dram_core_stats> cores{};
 };
 
 dram_stats operator-(dram_stats lhs, dram_stats rhs);
 
+/**
+ * The statistics of the given core, which are added if they do not yet exist
+ */
+dram_core_stats& core_stats(dram_stats& stats, std::size_t cpu);
+
 #endif
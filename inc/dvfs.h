@@ -0,0 +1,143 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DVFS_H
+#define DVFS_H
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "chrono.h"
+#include "dvfs_stats.h"
+#include "environment.h"
+#include "ooo_cpu.h"
+#include "operable.h"
+
+namespace champsim
+{
+/**
+ * A change of the frequency of one domain, at a point in simulated time.
+ */
+struct dvfs_event {
+  champsim::chrono::clock::time_point time;
+  std::string domain;
+  long frequency; // MHz
+};
+
+struct dvfs_governor_options {
+  /**
+   * The frequencies, in MHz, between which the governor moves each core.
+   */
+  std::vector<long> levels = {};
+
+  /**
+   * The number of core cycles between decisions.
+   */
+  long long interval = 0;
+
+  /**
+   * The fraction of the retire width used, above which the frequency is raised and below which it is lowered.
+   */
+  double up_threshold = 0;
+  double down_threshold = 0;
+};
+
+/**
+ * Changes the clock periods of groups of components while the simulation runs.
+ *
+ * A domain is named by a comma-separated list of patterns. Each pattern is the name of a component (as in the replay log: "cpu0", "cpu0_L1D", "LLC"),
+ * or a prefix followed by '*'. Every component that matches any pattern is in the domain, and the components of a domain always share one frequency
+ * once it has been set. A component may be in only one domain. The DRAM, whose timings are fixed by its data rate, may not be in a domain.
+ *
+ * Frequencies are changed at the times given in a schedule, or by a governor that raises the frequency of each core and the components whose names
+ * begin with its own, when the core retires instructions at a large fraction of its retire width, and lowers it when the core retires few.
+ *
+ * A default-constructed controller is disabled.
+ */
+class dvfs_controller
+{
+  struct domain_state {
+    dvfs_stats stats{};
+    std::vector<std::string> patterns{};
+    std::vector<std::reference_wrapper<operable>> members{};
+    long frequency = 0;
+    champsim::chrono::clock::time_point since{};
+
+    // The core whose utilization drives the governor, if the governor manages this domain
+    O3_CPU* core = nullptr;
+    std::size_t level = 0;
+    champsim::chrono::clock::time_point next_decision{};
+    long long decision_instrs = 0;
+    long long decision_cycles = 0;
+  };
+
+  std::vector<dvfs_event> m_schedule{};
+  std::vector<std::size_t> m_event_domains{};
+  std::size_t m_next_event = 0;
+  std::optional<dvfs_governor_options> m_governor{};
+  std::vector<domain_state> m_domains{};
+
+  std::size_t find_domain(environment& env, const std::string& name);
+  bool set_frequency(domain_state& domain, long frequency, champsim::chrono::clock::time_point now);
+  bool govern(domain_state& domain, champsim::chrono::clock::time_point now);
+
+public:
+  dvfs_controller() = default;
+  dvfs_controller(environment& env, std::vector<dvfs_event> schedule, std::optional<dvfs_governor_options> governor);
+
+  /**
+   * Whether any frequency may be changed.
+   */
+  [[nodiscard]] bool enabled() const { return !std::empty(m_domains); }
+
+  /**
+   * Begin counting the time spent at each frequency anew.
+   */
+  void begin_phase(champsim::chrono::clock::time_point now);
+
+  /**
+   * Make the changes that are due by the given time.
+   *
+   * @return whether any clock period was changed
+   */
+  bool operate(champsim::chrono::clock::time_point now);
+
+  /**
+   * The time each domain has spent at each frequency since the phase began.
+   */
+  std::vector<dvfs_stats> end_phase(champsim::chrono::clock::time_point now);
+};
+
+/**
+ * The clock period of a frequency in MHz
+ */
+champsim::chrono::picoseconds period_of_frequency(long frequency);
+
+/**
+ * Read frequency changes from a schedule file.
+ *
+ * Each line holds the simulated time of the change in nanoseconds, the domain, and the frequency in MHz. Blank lines and lines that begin with '#'
+ * are ignored.
+ */
+std::vector<dvfs_event> read_dvfs_schedule(std::istream& in);
+} // namespace champsim
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DVFS_STATS_H
+#define DVFS_STATS_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "chrono.h"
+
+/**
+ * The statistics of one frequency domain, when frequencies are changed while the simulation runs.
+ */
+struct dvfs_stats {
+  std::string name;
+  uint64_t transitions = 0;
+
+  // The time the domain spent at each frequency, in MHz
+  std::map<long, champsim::chrono::clock::duration> residency = {};
+};
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ENERGY_MODEL_H
+#define ENERGY_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json_fwd.hpp>
+
+#include "chrono.h"
+#include "energy_stats.h"
+#include "environment.h"
+#include "phase_info.h"
+
+namespace champsim
+{
+/**
+ * Energies of a core, in picojoules
+ */
+struct core_energy {
+  double dispatch = 120; // per instruction
+  double retire = 30;    // per instruction
+  double leakage = 125;  // per cycle
+};
+
+/**
+ * Energies of a cache, in picojoules
+ */
+struct cache_energy {
+  double tag_access = 0;  // per lookup, over all ways of the set
+  double data_access = 0; // per block read or written
+  double leakage = 0;     // per cycle
+};
+
+/**
+ * Energies of a DRAM channel, in picojoules
+ */
+struct dram_energy {
+  double activate = 1500;  // per row activation
+  double precharge = 800;  // per row precharge
+  double read = 1500;      // per block read, including I/O
+  double write = 1600;     // per block written, including I/O
+  double refresh = 0;      // per refresh command, over all ranks
+  double background = 0;   // per memory controller cycle, over all ranks
+};
+
+/**
+ * The energies of a cache of the given geometry, interpolated from a table of SRAM arrays in the manner of CACTI.
+ */
+cache_energy default_cache_energy(std::size_t sets, std::size_t ways, std::size_t block_size);
+
+/**
+ * The energies of a DDR4 channel with the given number of ranks
+ */
+dram_energy default_dram_energy(std::size_t ranks);
+
+/**
+ * Estimates the energy of each component from the statistics of a phase.
+ *
+ * The estimate multiplies the count of each kind of event by its energy, and adds a leakage energy for each cycle, so it costs nothing while the
+ * simulation runs. Every event of a sampled cache is scaled by the fraction of its sets that were sampled.
+ */
+class energy_model
+{
+  std::map<uint32_t, core_energy> m_cores{}; // keyed by the index of the core
+  std::map<std::string, cache_energy> m_caches{};
+  dram_energy m_dram{};
+  champsim::chrono::picoseconds m_dram_period{};
+
+public:
+  /**
+   * Size the energies of each component from its configuration.
+   */
+  explicit energy_model(environment& env);
+
+  /**
+   * Size the energies of each component from its configuration, then replace those given in an object keyed by component name ("cpu0", "LLC",
+   * "DRAM"), each of which maps the names of energies to picojoules.
+   */
+  energy_model(environment& env, const nlohmann::json& overrides);
+
+  /**
+   * The energy of each core, cache, and DRAM channel over the phase, followed by the total of the system.
+   */
+  [[nodiscard]] std::vector<energy_stats> account(const phase_stats& stats) const;
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ENERGY_STATS_H
+#define ENERGY_STATS_H
+
+#include <chrono>
+#include <ratio>
+#include <string>
+
+#include "chrono.h"
+
+/**
+ * The energy that one component consumed over a phase, estimated from its event counts.
+ */
+struct energy_stats {
+  std::string name;
+  double dynamic = 0; // pJ
+  double leakage = 0; // pJ
+  champsim::chrono::clock::duration delay{};
+
+  [[nodiscard]] double total() const { return dynamic + leakage; }
+
+  /**
+   * The energy-delay product, in joule-seconds
+   */
+  [[nodiscard]] double edp() const
+  {
+    return total() * static_cast<double>(std::pico::num) / static_cast<double>(std::pico::den) * std::chrono::duration<double>{delay}.count();
+  }
+};
+
+#endif
@@ -18,6 +18,7 @@
 #define ENVIRONMENT_H
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "cache.h"
@@ -40,7 +41,12 @@ namespace configured
 {
 template <unsigned long long ID>
 struct generated_environment;
-}
+
+/**
+ * Create the environment this simulator was configured with. This is defined in the translation unit that is compiled for each configuration.
+ */
+std::unique_ptr<environment> make_generated_environment();
+} // namespace configured
 } // namespace champsim
 
 #endif
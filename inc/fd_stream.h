@@ -0,0 +1,86 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FD_STREAM_H
+#define FD_STREAM_H
+
+#include <ios>
+#include <string>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A minimal input byte stream over a POSIX file descriptor.
+ *
+ * This satisfies the same interface as std::ifstream for the purposes of bulk_tracereader and inf_istream, so that traces can be read from sources that
+ * cannot be opened as regular files: the standard input, named pipes, and Unix domain sockets.
+ */
+class fd_istream
+{
+  int fd_ = -1;
+  bool owns_fd_ = false;
+  bool eof_ = false;
+  bool fail_ = false;
+  std::streamsize gcount_ = 0;
+  std::vector<char> pushback_{};
+
+public:
+  using char_type = char;
+
+  /**
+   * Open the named source. The name "-" denotes the standard input. Paths that name a Unix domain socket are connected to as a client. Any other path
+   * (including a named pipe) is opened for reading.
+   *
+   * \throws std::system_error if the source cannot be opened
+   */
+  explicit fd_istream(const std::string& name);
+
+  /**
+   * Wrap an already-open file descriptor. If ``owns`` is true, the descriptor is closed when this stream is destroyed.
+   */
+  fd_istream(int fd, bool owns);
+
+  fd_istream(const fd_istream&) = delete;
+  fd_istream& operator=(const fd_istream&) = delete;
+  fd_istream(fd_istream&& other) noexcept;
+  fd_istream& operator=(fd_istream&& other) noexcept;
+  ~fd_istream();
+
+  /**
+   * Read up to ``count`` bytes, blocking until that many are available or the writer closes the stream.
+   *
+   * \throws std::system_error if the source reports an error other than an interrupted read
+   */
+  fd_istream& read(char* s, std::streamsize count);
+
+  /**
+   * Return bytes to the stream, such that they are produced by the next read. This allows a header to be examined before the stream is handed off.
+   */
+  void unread(const char* s, std::streamsize count);
+
+  [[nodiscard]] bool eof() const { return eof_; }
+  [[nodiscard]] bool fail() const { return fail_; }
+  [[nodiscard]] std::streamsize gcount() const { return gcount_; }
+};
+
+/**
+ * Determine whether the named trace is a stream that must be read sequentially, rather than a regular file.
+ */
+[[nodiscard]] bool is_stream_source(const std::string& name);
+} // namespace champsim
+
+#endif
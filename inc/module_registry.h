@@ -0,0 +1,64 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MODULE_REGISTRY_H
+#define MODULE_REGISTRY_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cache.h"
+#include "ooo_cpu.h"
+
+/**
+ * A registry of every module that was compiled into the simulator, keyed by the name of the directory that contains it.
+ *
+ * The registry is populated by the configuration system, which lists all modules on the search path. Environments that are built at runtime use it to
+ * select modules by name, rather than by type.
+ */
+namespace champsim::modules::registry
+{
+/**
+ * Create the named prefetcher, bound to the given cache. A name ending in ".so" is loaded as a plugin.
+ * Throws std::invalid_argument if no such prefetcher was compiled.
+ */
+std::unique_ptr<CACHE::prefetcher_module_concept> make_prefetcher(std::string_view name, CACHE* cache);
+
+/**
+ * Create the named replacement policy, bound to the given cache. A name ending in ".so" is loaded as a plugin.
+ * Throws std::invalid_argument if no such policy was compiled.
+ */
+std::unique_ptr<CACHE::replacement_module_concept> make_replacement(std::string_view name, CACHE* cache);
+
+/**
+ * Create the named branch direction predictor, bound to the given core. Throws std::invalid_argument if no such predictor was compiled.
+ */
+std::unique_ptr<O3_CPU::branch_module_concept> make_branch_predictor(std::string_view name, O3_CPU* cpu);
+
+/**
+ * Create the named branch target predictor, bound to the given core. Throws std::invalid_argument if no such predictor was compiled.
+ */
+std::unique_ptr<O3_CPU::btb_module_concept> make_btb(std::string_view name, O3_CPU* cpu);
+
+std::vector<std::string> prefetcher_names();
+std::vector<std::string> replacement_names();
+std::vector<std::string> branch_predictor_names();
+std::vector<std::string> btb_names();
+} // namespace champsim::modules::registry
+
+#endif
@@ -30,6 +30,7 @@
 #include <optional>
 #include <queue>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -42,6 +43,7 @@
 #include "modules.h"
 #include "operable.h"
 #include "register_allocator.h"
+#include "sync_manager.h"
 #include "util/lru_table.h"
 #include "util/to_underlying.h"
 
@@ -61,6 +63,8 @@ public:
   CacheBus(uint32_t cpu_idx, champsim::channel* ll) : lower_level(ll), cpu(cpu_idx) {}
   bool issue_read(request_type packet);
   bool issue_write(request_type packet);
+
+  [[nodiscard]] channel_type* lower_channel() const { return lower_level; }
 };
 
 struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY> {
@@ -82,6 +86,9 @@ struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY> {
 // cpu
 class O3_CPU : public champsim::operable
 {
+protected:
+  void clock_period_changed(champsim::chrono::picoseconds old_period) final;
+
 public:
   uint32_t cpu = 0;
 
@@ -91,6 +98,7 @@ public:
   champsim::chrono::clock::time_point finish_phase_time{};
   long long finish_phase_instr = 0;
   champsim::chrono::clock::time_point last_heartbeat_time{};
+  long long last_heartbeat_cycle = 0;
   long long last_heartbeat_instr = 0;
 
   // instruction
@@ -134,14 +142,23 @@ public:
 
   champsim::bandwidth::maximum_type L1I_BANDWIDTH, L1D_BANDWIDTH;
 
+  champsim::core_model MODEL;
+  std::string CORE_TYPE;
+
   RegisterAllocator reg_allocator{REGISTER_FILE_SIZE};
 
+  // The interval model does not rename registers. Instead, each architectural register records the last instruction that writes it.
+  std::array<uint64_t, std::numeric_limits<uint8_t>::max() + 1> interval_producers{};
+
   // branch
   champsim::chrono::clock::time_point fetch_resume_time{};
 
   const long IN_QUEUE_SIZE;
   std::deque<ooo_model_instr> input_queue;
 
+  // The synchronization event, if any, that holds back the trace that fills the input queue
+  std::optional<champsim::sync_kind> waiting_for_sync{};
+
   CacheBus L1I_bus, L1D_bus;
   CACHE* l1i;
 
@@ -163,6 +180,10 @@ public:
   long handle_memory_return();
   long retire_rob();
 
+  long operate_interval();
+  long dispatch_interval();
+  long complete_interval();
+
   bool do_init_instruction(ooo_model_instr& instr);
   bool do_predict_branch(ooo_model_instr& instr);
   void do_check_dib(ooo_model_instr& instr);
@@ -172,6 +193,8 @@ public:
   void do_execution(ooo_model_instr& instr);
   void do_memory_scheduling(ooo_model_instr& instr);
   void do_complete_execution(ooo_model_instr& instr);
+  void do_interval_dispatch(ooo_model_instr& instr);
+  void do_interval_completion(ooo_model_instr& instr);
   void do_sq_forward_to_lq(LSQ_ENTRY& sq_entry, LSQ_ENTRY& lq_entry);
 
   void do_finish_store(const LSQ_ENTRY& sq_entry);
@@ -181,7 +204,7 @@ public:
   [[nodiscard]] auto roi_instr() const { return roi_stats.instrs(); }
   [[nodiscard]] auto roi_cycle() const { return roi_stats.cycles(); }
   [[nodiscard]] auto sim_instr() const { return num_retired - begin_phase_instr; }
-  [[nodiscard]] auto sim_cycle() const { return (current_time.time_since_epoch() / clock_period) - sim_stats.begin_cycles; }
+  [[nodiscard]] auto sim_cycle() const { return cycle_count() - sim_stats.begin_cycles; }
 
   void print_deadlock() final;
 
@@ -247,10 +270,11 @@ public:
         BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty * b.m_clock_period), DISPATCH_LATENCY(b.m_dispatch_latency * b.m_clock_period),
         DECODE_LATENCY(b.m_decode_latency * b.m_clock_period), SCHEDULING_LATENCY(b.m_schedule_latency * b.m_clock_period),
         EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period), L1I_BANDWIDTH(b.m_l1i_bw),
-        L1D_BANDWIDTH(b.m_l1d_bw), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
-        L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
-        btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this))
+        L1D_BANDWIDTH(b.m_l1d_bw), MODEL(b.m_model), CORE_TYPE(b.m_core_type), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)),
+        L1I_bus(b.m_cpu, b.m_fetch_queues), L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i),
+        branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)), btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this))
   {
+    interval_producers.fill(std::numeric_limits<uint64_t>::max());
   }
 };
 
@@ -21,12 +21,27 @@
 
 namespace champsim
 {
+namespace replay
+{
+class chain;
+}
+
 class operable
 {
+  long long cycles_before_period = 0;
+  champsim::chrono::clock::time_point period_begin{};
+
+protected:
+  /**
+   * Called after the clock period has changed, so that latencies given in cycles of the old period may be rescaled.
+   */
+  virtual void clock_period_changed(champsim::chrono::picoseconds /*old period*/) {} // LCOV_EXCL_LINE
+
 public:
   champsim::chrono::picoseconds clock_period{};
   champsim::chrono::clock::time_point current_time{};
   bool warmup = true;
+  replay::chain* replay_chain = nullptr;
 
   operable();
   virtual ~operable() = default;
@@ -35,15 +50,41 @@ public:
   long _operate();
   long operate_on(const champsim::chrono::clock& clock);
 
+  /**
+   * The bookkeeping that _operate() does before and after operate(), for owners that call operate() themselves.
+   * advance_cycle() moves the current time forward by one period, and finish_cycle() closes the cycle in the replay log.
+   */
+  void advance_cycle();
+  void finish_cycle();
+
   virtual void initialize() {} // LCOV_EXCL_LINE
   virtual long operate() = 0;
   virtual void begin_phase() {}                     // LCOV_EXCL_LINE
   virtual void end_phase(unsigned /*cpu index*/) {} // LCOV_EXCL_LINE
   virtual void print_deadlock() {}                  // LCOV_EXCL_LINE
 
+  /**
+   * Change the clock period from the current time onward. Cycles already elapsed keep their length.
+   */
+  void set_clock_period(champsim::chrono::picoseconds new_period);
+
+  /**
+   * The number of cycles this component has operated, counting each in the period it had at the time
+   */
+  [[nodiscard]] long long cycle_count() const;
+
   [[deprecated]] uint64_t current_cycle() const;
 };
 
+/**
+ * Convert a latency that is a whole number of cycles of one period into the same number of cycles of another
+ */
+constexpr champsim::chrono::clock::duration rescale_latency(champsim::chrono::clock::duration latency, champsim::chrono::picoseconds from,
+                                                            champsim::chrono::picoseconds to)
+{
+  return (latency / from) * to;
+}
+
 } // namespace champsim
 
 #endif
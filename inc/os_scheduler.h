@@ -0,0 +1,163 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OS_SCHEDULER_H
+#define OS_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "cache.h"
+#include "chrono.h"
+#include "instruction.h"
+#include "ooo_cpu.h"
+#include "trace_stats.h"
+#include "tracereader.h"
+
+namespace champsim
+{
+/**
+ * How traces move between cores of different types.
+ */
+enum class migration_policy {
+  none,     /**< Traces move only when their time slices end */
+  periodic, /**< At each decision, the traces on the largest cores move to the smallest, and every other trace moves to the next larger core */
+  phase     /**< At each decision, the traces that used the most of their core's width in the last interval are placed on the largest cores */
+};
+
+struct scheduler_options {
+  /**
+   * The number of core cycles that a trace runs before the core switches to the next waiting trace.
+   */
+  long long time_slice = 0;
+
+  /**
+   * The number of core cycles for which fetch stalls at each context switch.
+   */
+  long long switch_cost = 0;
+
+  /**
+   * Whether the translation caches of a core are emptied at each context switch.
+   */
+  bool flush_translations = false;
+
+  /**
+   * How traces migrate between cores of different types.
+   */
+  migration_policy migration = migration_policy::none;
+
+  /**
+   * The number of cycles of the first core between migration decisions.
+   */
+  long long migration_interval = 0;
+};
+
+/**
+ * Runs more traces than there are cores, in the manner of a time-sharing operating system.
+ *
+ * Each core runs one trace at a time. When its time slice ends, the instructions that the core has not yet fetched are returned to the trace, and the
+ * core takes the trace that has waited longest. The virtual addresses of each trace are tagged with its index in their top byte, so that traces occupy
+ * separate address spaces and TLB entries are tagged by address space. Instructions are renumbered in the order they are given to a core.
+ *
+ * Traces can also migrate between cores of different types (see migration_policy). Cores are ordered from largest to smallest by their ROB size and
+ * then their dispatch width. A migrating trace takes its unfetched instructions to its new core, so its register state moves with it: instructions that
+ * are already in the pipeline of the old core retire there, and the new core begins with no instructions in flight. The private caches of the new core
+ * are not filled for the trace, and warm up as it runs. Fetch stalls for the switch cost at each migration.
+ *
+ * A default-constructed scheduler is disabled, and gives each core the instructions of its trace unchanged.
+ */
+class os_scheduler
+{
+  struct core_state {
+    std::size_t trace;
+    champsim::chrono::clock::time_point slice_end{};
+    champsim::chrono::clock::time_point switch_end{};
+    long long accounted_cycles = 0;
+    long long accounted_instrs = 0;
+    long long decision_cycles = 0;
+    long long decision_instrs = 0;
+    std::vector<uint64_t> accounted_misses{};
+    uint64_t next_instr_id = 0;
+    std::vector<std::reference_wrapper<CACHE>> translation_caches{};
+  };
+
+  scheduler_options m_options{};
+  std::vector<core_state> m_cores{};
+  std::deque<std::size_t> m_ready{};
+  std::vector<std::deque<ooo_model_instr>> m_pending{};
+  std::vector<trace_stats> m_stats{};
+  std::vector<std::reference_wrapper<CACHE>> m_caches{};
+  champsim::chrono::clock::time_point m_next_migration{};
+
+  void account(O3_CPU& cpu);
+  void release_trace(O3_CPU& cpu);
+  void resume_trace(O3_CPU& cpu, std::size_t trace);
+  void switch_trace(O3_CPU& cpu);
+
+public:
+  /**
+   * The number of bits above which a trace index is placed in its virtual addresses.
+   */
+  constexpr static unsigned address_space_shift = 56;
+  constexpr static std::size_t max_traces = std::size_t{1} << (64 - address_space_shift);
+
+  os_scheduler() = default;
+  os_scheduler(std::size_t num_traces, std::size_t num_cores, scheduler_options options);
+
+  [[nodiscard]] bool enabled() const { return !std::empty(m_cores); }
+
+  /**
+   * The index of the trace that the core runs.
+   */
+  [[nodiscard]] std::size_t trace_on(std::size_t core) const { return m_cores.at(core).trace; }
+
+  /**
+   * Whether the trace has instructions left.
+   */
+  [[nodiscard]] bool has_instruction(std::size_t trace, const tracereader& reader) const;
+
+  /**
+   * Take the next instruction of the trace that the core runs.
+   */
+  ooo_model_instr next_instruction(std::size_t core, std::size_t trace, tracereader& reader);
+
+  /**
+   * Switch the trace that the core runs, if its time slice has ended and another trace is waiting.
+   * Returns nonzero while the core is switching, so that the pause in fetch is not mistaken for a deadlock.
+   */
+  long operate(O3_CPU& cpu);
+
+  /**
+   * Migrate traces between the cores, if a migration decision is due. Returns nonzero if any trace moved.
+   */
+  long migrate(const std::vector<std::reference_wrapper<O3_CPU>>& cpus);
+
+  /**
+   * Begin collecting statistics for a phase. The caches are those whose misses are attributed to the traces.
+   */
+  void begin_phase(const std::vector<std::reference_wrapper<O3_CPU>>& cpus, const std::vector<std::reference_wrapper<CACHE>>& caches);
+
+  /**
+   * The statistics of each trace since the beginning of the phase.
+   */
+  std::vector<trace_stats> end_phase(const std::vector<std::reference_wrapper<O3_CPU>>& cpus);
+};
+} // namespace champsim
+
+#endif
@@ -26,6 +26,9 @@
 #include "cache_stats.h"
 #include "core_stats.h"
 #include "dram_stats.h"
+#include "dvfs_stats.h"
+#include "energy_stats.h"
+#include "trace_stats.h"
 
 namespace champsim
 {
@@ -40,10 +43,23 @@ struct phase_info {
 
 struct phase_stats {
   std::string name;
+  champsim::chrono::clock::duration elapsed{};
   std::vector<std::string> trace_names;
   std::vector<O3_CPU::stats_type> roi_cpu_stats, sim_cpu_stats;
   std::vector<CACHE::stats_type> roi_cache_stats, sim_cache_stats;
   std::vector<DRAM_CHANNEL::stats_type> roi_dram_stats, sim_dram_stats;
+
+  // If the cores are of more than one type, the instructions and cycles of the cores of each type
+  std::vector<core_type_stats> sim_core_type_stats;
+
+  // If the traces were scheduled onto the cores by time slices, the statistics of each trace
+  std::vector<trace_stats> sim_trace_stats;
+
+  // If frequencies were changed while the simulation ran, the time each frequency domain spent at each frequency
+  std::vector<dvfs_stats> sim_dvfs_stats;
+
+  // If energy was estimated, the energy of each component, followed by that of the system
+  std::vector<energy_stats> sim_energy_stats;
 };
 
 } // namespace champsim
@@ -0,0 +1,89 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLUGIN_H
+#define PLUGIN_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "cache.h"
+#include "plugin_abi.h"
+
+/**
+ * Prefetchers and replacement policies that are loaded from shared objects, through the interface in plugin_abi.h.
+ */
+namespace champsim::plugin
+{
+/**
+ * A shared object that was opened with dlopen(). The object is closed when this is destroyed.
+ */
+class library
+{
+  std::string path;
+  void* handle = nullptr;
+
+public:
+  /**
+   * Open the shared object at the given path. Throws std::runtime_error if it cannot be opened.
+   */
+  explicit library(std::string path);
+  ~library();
+
+  library(const library&) = delete;
+  library& operator=(const library&) = delete;
+  library(library&& other) noexcept;
+  library& operator=(library&& other) noexcept;
+
+  /**
+   * Find an exported symbol, or return nullptr if there is none.
+   */
+  [[nodiscard]] void* symbol(const char* name) const;
+  [[nodiscard]] const std::string& name() const { return path; }
+};
+
+/**
+ * Whether a module name in a configuration refers to a shared object, rather than to a compiled-in module.
+ */
+bool is_plugin_name(std::string_view name);
+
+/**
+ * Open the shared object at the given path, if it is not already open, and get its prefetcher hooks.
+ * The object stays open until the simulator exits.
+ * Throws std::invalid_argument if it does not export a prefetcher, or if it was built against a different version of the interface.
+ */
+const champsim_prefetcher_plugin_vtable* load_prefetcher(const std::string& path);
+
+/**
+ * Open the shared object at the given path, if it is not already open, and get its replacement hooks.
+ * The object stays open until the simulator exits.
+ * Throws std::invalid_argument if it does not export a replacement policy, or if it was built against a different version of the interface.
+ */
+const champsim_replacement_plugin_vtable* load_replacement(const std::string& path);
+
+/**
+ * Create a prefetcher for the cache that forwards each hook to the given table.
+ */
+std::unique_ptr<CACHE::prefetcher_module_concept> make_prefetcher(const champsim_prefetcher_plugin_vtable* vtable, CACHE* cache);
+
+/**
+ * Create a replacement policy for the cache that forwards each hook to the given table.
+ */
+std::unique_ptr<CACHE::replacement_module_concept> make_replacement(const champsim_replacement_plugin_vtable* vtable, CACHE* cache);
+} // namespace champsim::plugin
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The binary interface between ChampSim and prefetchers or replacement policies that are loaded from shared objects at runtime.
+ *
+ * This header is valid C and C++, and does not depend on any other ChampSim header, so that plugins can be built without the simulator's sources.
+ * Addresses are passed as full 64-bit integers. Access types are passed as the values of the simulator's access_type enumeration:
+ * 0 for loads, 1 for RFOs, 2 for prefetches, 3 for writes, and 4 for translations.
+ *
+ * A plugin exports one or both of the entry points champsim_prefetcher_plugin() and champsim_replacement_plugin(), each of which returns a pointer
+ * to a table of hooks with static storage duration. Any hook may be null, in which case the simulator does nothing for that event. A module without
+ * create has a null state, and a replacement policy without find_victim always evicts way 0.
+ */
+
+#ifndef CHAMPSIM_PLUGIN_ABI_H
+#define CHAMPSIM_PLUGIN_ABI_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Plugins are rejected unless they were built against this version of the interface */
+#define CHAMPSIM_PLUGIN_ABI_VERSION 1
+
+/* The cache that a module instance is attached to. Plugins may only pass it back to the services. */
+typedef struct champsim_plugin_cache champsim_plugin_cache;
+
+/* Functions that plugins may call on the cache they are attached to */
+typedef struct champsim_plugin_services {
+  uint32_t abi_version;
+
+  /* Issue a prefetch. Returns nonzero if the prefetch was accepted. */
+  int (*prefetch_line)(champsim_plugin_cache* cache, uint64_t pf_addr, int fill_this_level, uint32_t prefetch_metadata);
+
+  uint32_t (*num_set)(const champsim_plugin_cache* cache);
+  uint32_t (*num_way)(const champsim_plugin_cache* cache);
+  uint32_t (*cpu)(const champsim_plugin_cache* cache);
+  uint32_t (*offset_bits)(const champsim_plugin_cache* cache);
+
+  /* Inspect a block in the cache */
+  int (*block_valid)(const champsim_plugin_cache* cache, long set, long way);
+  uint64_t (*block_address)(const champsim_plugin_cache* cache, long set, long way);
+} champsim_plugin_services;
+
+typedef struct champsim_prefetcher_plugin_vtable {
+  uint32_t abi_version;
+
+  /* Create an instance for the given cache, returning its state. The services outlive the instance. */
+  void* (*create)(const champsim_plugin_services* services, champsim_plugin_cache* cache);
+  void (*destroy)(void* self);
+
+  void (*initialize)(void* self);
+  uint32_t (*cache_operate)(void* self, uint64_t addr, uint64_t ip, int cache_hit, int useful_prefetch, uint32_t type, uint32_t metadata_in);
+  uint32_t (*cache_fill)(void* self, uint64_t addr, long set, long way, int prefetch, uint64_t evicted_addr, uint32_t metadata_in);
+  void (*cycle_operate)(void* self);
+  void (*final_stats)(void* self);
+  void (*branch_operate)(void* self, uint64_t ip, uint8_t branch_type, uint64_t branch_target);
+} champsim_prefetcher_plugin_vtable;
+
+typedef struct champsim_replacement_plugin_vtable {
+  uint32_t abi_version;
+
+  /* Create an instance for the given cache, returning its state. The services outlive the instance. */
+  void* (*create)(const champsim_plugin_services* services, champsim_plugin_cache* cache);
+  void (*destroy)(void* self);
+
+  void (*initialize)(void* self);
+  long (*find_victim)(void* self, uint32_t triggering_cpu, uint64_t instr_id, long set, uint64_t ip, uint64_t full_addr, uint32_t type);
+  void (*update_replacement_state)(void* self, uint32_t triggering_cpu, long set, long way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr,
+                                   uint32_t type, int hit);
+  void (*cache_fill)(void* self, uint32_t triggering_cpu, long set, long way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, uint32_t type);
+  void (*final_stats)(void* self);
+} champsim_replacement_plugin_vtable;
+
+typedef const champsim_prefetcher_plugin_vtable* (*champsim_prefetcher_plugin_entry)(void);
+typedef const champsim_replacement_plugin_vtable* (*champsim_replacement_plugin_entry)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POOLED_LIST_H
+#define POOLED_LIST_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace champsim
+{
+/**
+ * A small list whose storage is drawn from a pool of nodes that is shared by all lists of the same type in a thread.
+ *
+ * Copies share their node and count references, so that passing a list along with a packet does not copy its elements.
+ * A list copies its elements into a node of its own only when it is modified while shared.
+ * Released nodes are kept by the pool and reused for lists of the same capacity, so that once a simulation reaches its steady state,
+ * lists are created, copied, and destroyed without allocating from the heap.
+ *
+ * The reference counts are atomic, so lists that share a node may be copied and destroyed by different threads.
+ * A node that is released by a thread other than the one that allocated it is returned to the pool of its owner, which takes it back when its own free nodes run out.
+ * Like a standard container, a single list must not be modified by two threads at once.
+ */
+template <typename T>
+class pooled_list
+{
+  static_assert(std::is_trivially_copyable_v<T>, "Elements of a pooled list are copied as bytes");
+  static_assert(alignof(T) <= alignof(std::max_align_t), "Elements of a pooled list cannot be over-aligned");
+
+  struct pool;
+
+  struct node {
+    node* next_free;
+    pool* owner;
+    std::atomic<uint32_t> refcount;
+    uint32_t size;
+    uint32_t size_class;
+  };
+
+  struct pool {
+    std::array<node*, 32> free_nodes{};
+    std::array<std::atomic<node*>, 32> remote_free_nodes{};
+    std::size_t heap_allocations = 0;
+  };
+
+  constexpr static std::size_t min_capacity = 4;
+  constexpr static std::size_t data_offset = (sizeof(node) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+  node* m_node = nullptr;
+
+  static pool& local_pool();
+  static std::size_t capacity_of(uint32_t size_class) { return min_capacity << size_class; }
+  static uint32_t size_class_for(std::size_t count);
+  static node* acquire(uint32_t size_class);
+  static void release(node* released);
+  static T* data_of(node* n) { return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(n) + data_offset); }
+
+  void make_unique(std::size_t count);
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using iterator = const T*;
+  using const_iterator = const T*;
+
+  pooled_list() = default;
+  pooled_list(std::initializer_list<T> values);
+  pooled_list(const pooled_list& other) noexcept;
+  pooled_list(pooled_list&& other) noexcept : m_node(std::exchange(other.m_node, nullptr)) {}
+  pooled_list& operator=(pooled_list other) noexcept;
+  ~pooled_list();
+
+  [[nodiscard]] const T* data() const { return m_node == nullptr ? nullptr : data_of(m_node); }
+  [[nodiscard]] std::size_t size() const { return m_node == nullptr ? 0 : m_node->size; }
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  [[nodiscard]] const_iterator begin() const { return data(); }
+  [[nodiscard]] const_iterator end() const { return data() + size(); }
+  [[nodiscard]] const T& front() const { return *begin(); }
+  [[nodiscard]] const T& back() const { return *(end() - 1); }
+
+  void push_back(const T& value);
+  const_iterator erase(const_iterator pos);
+  void clear();
+
+  /**
+   * The number of nodes that the pool of the calling thread has allocated from the heap.
+   */
+  static std::size_t heap_allocations() { return local_pool().heap_allocations; }
+
+  friend bool operator==(const pooled_list& lhs, const pooled_list& rhs) { return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+  friend bool operator!=(const pooled_list& lhs, const pooled_list& rhs) { return !(lhs == rhs); }
+};
+} // namespace champsim
+
+template <typename T>
+auto champsim::pooled_list<T>::local_pool() -> pool&
+{
+  // The pool is never destroyed, so that nodes released after its thread exits can still be returned to it.
+  thread_local pool* instance = new pool{};
+  return *instance;
+}
+
+template <typename T>
+uint32_t champsim::pooled_list<T>::size_class_for(std::size_t count)
+{
+  uint32_t size_class = 0;
+  while (capacity_of(size_class) < count)
+    ++size_class;
+  return size_class;
+}
+
+template <typename T>
+auto champsim::pooled_list<T>::acquire(uint32_t size_class) -> node*
+{
+  auto& local = local_pool();
+  if (local.free_nodes.at(size_class) == nullptr) {
+    local.free_nodes[size_class] = local.remote_free_nodes[size_class].exchange(nullptr, std::memory_order_acquire);
+  }
+
+  void* storage = local.free_nodes[size_class];
+  if (storage != nullptr) {
+    local.free_nodes[size_class] = local.free_nodes[size_class]->next_free;
+  } else {
+    ++local.heap_allocations;
+    storage = ::operator new(data_offset + capacity_of(size_class) * sizeof(T));
+  }
+
+  return ::new (storage) node{nullptr, &local, {1}, 0, size_class};
+}
+
+template <typename T>
+void champsim::pooled_list<T>::release(node* released)
+{
+  if (released == nullptr || released->refcount.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+
+  auto& local = local_pool();
+  if (released->owner == &local) {
+    released->next_free = local.free_nodes[released->size_class];
+    local.free_nodes[released->size_class] = released;
+  } else {
+    auto& remote = released->owner->remote_free_nodes[released->size_class];
+    released->next_free = remote.load(std::memory_order_relaxed);
+    while (!remote.compare_exchange_weak(released->next_free, released, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+  }
+}
+
+template <typename T>
+void champsim::pooled_list<T>::make_unique(std::size_t count)
+{
+  if (m_node != nullptr && m_node->refcount.load(std::memory_order_acquire) == 1 && capacity_of(m_node->size_class) >= count)
+    return;
+
+  auto old_size = size();
+  node* unique = acquire(size_class_for(std::max(count, old_size)));
+  std::copy_n(begin(), old_size, data_of(unique));
+  unique->size = static_cast<uint32_t>(old_size);
+
+  release(std::exchange(m_node, unique));
+}
+
+template <typename T>
+champsim::pooled_list<T>::pooled_list(std::initializer_list<T> values)
+{
+  if (std::size(values) > 0) {
+    m_node = acquire(size_class_for(std::size(values)));
+    std::copy(std::begin(values), std::end(values), data_of(m_node));
+    m_node->size = static_cast<uint32_t>(std::size(values));
+  }
+}
+
+template <typename T>
+champsim::pooled_list<T>::pooled_list(const pooled_list& other) noexcept : m_node(other.m_node)
+{
+  if (m_node != nullptr)
+    m_node->refcount.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+auto champsim::pooled_list<T>::operator=(pooled_list other) noexcept -> pooled_list&
+{
+  std::swap(m_node, other.m_node);
+  return *this;
+}
+
+template <typename T>
+champsim::pooled_list<T>::~pooled_list()
+{
+  release(m_node);
+}
+
+template <typename T>
+void champsim::pooled_list<T>::push_back(const T& value)
+{
+  make_unique(size() + 1);
+  data_of(m_node)[m_node->size] = value;
+  ++m_node->size;
+}
+
+template <typename T>
+auto champsim::pooled_list<T>::erase(const_iterator pos) -> const_iterator
+{
+  auto index = std::distance(begin(), pos);
+  make_unique(size());
+  auto* first = data_of(m_node) + index;
+  std::copy(first + 1, data_of(m_node) + m_node->size, first);
+  --m_node->size;
+  return first;
+}
+
+template <typename T>
+void champsim::pooled_list<T>::clear()
+{
+  release(std::exchange(m_node, nullptr));
+}
+
+#endif
@@ -27,6 +27,7 @@
 #include "bandwidth.h"
 #include "channel.h"
 #include "operable.h"
+#include "pooled_list.h"
 #include "ptw_builder.h"
 #include "util/lru_table.h"
 #include "waitable.h"
@@ -55,8 +56,8 @@ class PageTableWalker : public champsim::operable
     champsim::address v_address{};
     champsim::waitable<champsim::address> data{};
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::pooled_list<uint64_t> instr_depend_on_me{};
+    champsim::pooled_list<std::deque<response_type>*> to_return{};
 
     uint32_t pf_metadata = 0;
     uint32_t cpu = std::numeric_limits<uint32_t>::max();
@@ -80,11 +81,14 @@ class PageTableWalker : public champsim::operable
 
   void finish_packet(const response_type& packet);
 
+protected:
+  void clock_period_changed(champsim::chrono::picoseconds old_period) final;
+
 public:
   const std::string NAME;
   const uint32_t MSHR_SIZE;
   champsim::bandwidth::maximum_type MAX_READ, MAX_FILL;
-  const champsim::chrono::clock::duration HIT_LATENCY;
+  champsim::chrono::clock::duration HIT_LATENCY;
 
   std::vector<pscl_type> pscl;
   VirtualMemory* vmem;
@@ -0,0 +1,96 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPLAY_LOG_H
+#define REPLAY_LOG_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "chrono.h"
+
+namespace champsim
+{
+class operable;
+
+/**
+ * A deterministic record of simulated behavior, used to check that a change to the simulator does not change its results.
+ *
+ * Each component that is attached to the log keeps a hash chain of the events it observes. At the end of each cycle in which a component observed any
+ * events, the log records the cycle and the current value of that component's chain. Since each chain value depends on every earlier event, two logs
+ * can be compared to find the first cycle and component at which the simulations diverged.
+ */
+namespace replay
+{
+enum class event : uint64_t { retire = 1, fill = 2, dram_issue = 3, walk_step = 4 };
+
+class log;
+
+class chain
+{
+  log* owner;
+  uint32_t id;
+  uint32_t events = 0;
+  uint64_t hash;
+
+public:
+  chain(log* owner_, uint32_t id_);
+
+  /**
+   * Add an event to the chain.
+   */
+  void add(event kind, uint64_t value);
+
+  /**
+   * Finish the cycle that ends at the given time, writing a record if any events were added during the cycle.
+   */
+  void end_cycle(champsim::chrono::clock::time_point now, uint64_t cycle);
+};
+
+class log
+{
+  std::ostream& out;
+  std::vector<std::unique_ptr<chain>> chains{};
+
+  friend class chain;
+
+public:
+  explicit log(std::ostream& stream);
+
+  /**
+   * Attach a component to the log. Components must be attached in the same order in the runs that are to be compared.
+   */
+  void attach(champsim::operable& op, const std::string& name);
+};
+
+struct divergence {
+  std::string component;
+  uint64_t cycle;
+  std::string reason;
+};
+
+/**
+ * Compare two logs, and return the earliest point at which they differ, if any.
+ */
+std::optional<divergence> find_divergence(std::istream& lhs, std::istream& rhs);
+} // namespace replay
+} // namespace champsim
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RUNTIME_ENVIRONMENT_H
+#define RUNTIME_ENVIRONMENT_H
+
+#include <deque>
+#include <optional>
+#include <nlohmann/json_fwd.hpp>
+
+#include "channel.h"
+#include "environment.h"
+#include "vmem.h"
+
+namespace champsim
+{
+/**
+ * An environment that is built when the simulator starts, from a configuration that was resolved by ``config.sh --runtime-config``.
+ *
+ * The elements are built with the same builders as a generated environment, and modules are selected by name from the module registry. A single
+ * binary can therefore simulate any geometry, latency, or choice of compiled-in modules. The number of cores, the block size, and the page size
+ * must match the values the binary was built with.
+ */
+class runtime_environment final : public environment
+{
+  std::deque<champsim::channel> channels;
+  std::optional<MEMORY_CONTROLLER> DRAM;
+  std::optional<VirtualMemory> vmem;
+  std::deque<PageTableWalker> ptws;
+  std::deque<CACHE> caches;
+  std::deque<O3_CPU> cores;
+
+public:
+  /**
+   * Build the environment. Throws std::invalid_argument if the configuration is inconsistent or names an unknown element or module.
+   */
+  explicit runtime_environment(const nlohmann::json& config);
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final;
+  std::vector<std::reference_wrapper<CACHE>> cache_view() final;
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final;
+  MEMORY_CONTROLLER& dram_view() final;
+  std::vector<std::reference_wrapper<operable>> operable_view() final;
+};
+} // namespace champsim
+
+#endif
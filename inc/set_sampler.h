@@ -0,0 +1,74 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SET_SAMPLER_H
+#define SET_SAMPLER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "chrono.h"
+
+namespace champsim
+{
+/**
+ * Selects the sets of a cache that are simulated in detail when the cache samples its sets.
+ *
+ * A set is sampled if its index has no bits in common with the mask, so a mask of 2^k - 1 samples one set in 2^k.
+ * Accesses to the other sets are serviced at the average latency that the sampled sets have shown so far.
+ */
+class set_sampler
+{
+  uint64_t m_mask = 0;
+  std::vector<long> m_sample_index{};
+  long m_sampled_sets = 0;
+
+  champsim::chrono::clock::duration m_total_latency{};
+  long m_accesses = 0;
+
+public:
+  set_sampler() = default;
+  set_sampler(long sets, uint64_t mask);
+
+  /**
+   * Whether only some of the sets are sampled.
+   */
+  [[nodiscard]] bool enabled() const { return m_mask != 0; }
+
+  [[nodiscard]] bool is_sampled(long set) const { return (static_cast<uint64_t>(set) & m_mask) == 0; }
+
+  /**
+   * The position of a sampled set among the sampled sets.
+   */
+  [[nodiscard]] long sample_index(long set) const { return m_sample_index.at(static_cast<std::size_t>(set)); }
+
+  [[nodiscard]] long sampled_sets() const { return m_sampled_sets; }
+  [[nodiscard]] long total_sets() const { return static_cast<long>(std::size(m_sample_index)); }
+
+  /**
+   * Record the latency of a demand access to a sampled set.
+   */
+  void record_latency(champsim::chrono::clock::duration latency);
+
+  /**
+   * The average latency of the demand accesses to sampled sets, or the given latency if none have been recorded.
+   */
+  [[nodiscard]] champsim::chrono::clock::duration average_latency(champsim::chrono::clock::duration fallback) const;
+};
+} // namespace champsim
+
+#endif
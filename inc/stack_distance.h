@@ -0,0 +1,131 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STACK_DISTANCE_H
+#define STACK_DISTANCE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * Counts, for each access, the number of distinct lines touched since the previous access to the same line (the LRU stack distance).
+ *
+ * Each line's most recent access is marked in a Fenwick tree indexed by access time, so a distance is the number of marks after the previous access:
+ * O(log n) per access. When the tree fills, the live marks are renumbered into its lower half, so its size is bounded by the number of distinct lines.
+ */
+class stack_distance_counter
+{
+  std::vector<uint32_t> tree;
+  std::unordered_map<uint64_t, std::size_t> last_access;
+  std::size_t now = 0;
+
+  void add(std::size_t pos, int32_t delta)
+  {
+    for (++pos; pos <= std::size(tree); pos += pos & (~pos + 1)) {
+      tree[pos - 1] += static_cast<uint32_t>(delta);
+    }
+  }
+
+  [[nodiscard]] uint64_t prefix(std::size_t pos) const // sum over [0, pos)
+  {
+    uint64_t sum = 0;
+    for (; pos > 0; pos -= pos & (~pos + 1)) {
+      sum += tree[pos - 1];
+    }
+    return sum;
+  }
+
+  void compact()
+  {
+    std::vector<std::pair<std::size_t, uint64_t>> live;
+    live.reserve(std::size(last_access));
+    for (const auto& [line, time] : last_access) {
+      live.emplace_back(time, line);
+    }
+    std::sort(std::begin(live), std::end(live));
+
+    tree.assign(std::max<std::size_t>(2 * std::size(live), 1024), 0);
+    now = 0;
+    for (const auto& [time, line] : live) {
+      last_access[line] = now;
+      add(now++, 1);
+    }
+  }
+
+public:
+  constexpr static uint64_t infinite = std::numeric_limits<uint64_t>::max();
+
+  stack_distance_counter() : tree(1024) {}
+
+  /**
+   * Record an access to the line, and return its stack distance, or ``infinite`` if the line was never accessed before.
+   */
+  uint64_t access(uint64_t line)
+  {
+    if (now == std::size(tree)) {
+      compact();
+    }
+
+    uint64_t distance = infinite;
+    if (auto found = last_access.find(line); found != std::end(last_access)) {
+      distance = prefix(now) - prefix(found->second + 1);
+      add(found->second, -1);
+      found->second = now;
+    } else {
+      last_access.emplace(line, now);
+    }
+    add(now++, 1);
+    return distance;
+  }
+
+  /**
+   * The number of distinct lines accessed so far.
+   */
+  [[nodiscard]] std::size_t footprint() const { return std::size(last_access); }
+};
+
+/**
+ * A histogram of stack distances in power-of-two buckets. Bucket 0 holds the distance 0, bucket b holds the distances in [2^(b-1), 2^b), and the last
+ * bucket holds the cold misses.
+ */
+class stack_distance_histogram
+{
+  std::array<uint64_t, 65> m_buckets{};
+
+public:
+  void add(uint64_t distance)
+  {
+    if (distance == stack_distance_counter::infinite) {
+      ++m_buckets.back();
+    } else {
+      ++m_buckets[distance == 0 ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(distance))];
+    }
+  }
+
+  [[nodiscard]] const std::array<uint64_t, 65>& buckets() const { return m_buckets; }
+  [[nodiscard]] uint64_t cold() const { return m_buckets.back(); }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "environment.h"
+
+namespace champsim
+{
+/**
+ * The time taken to prepare one part of the simulation.
+ */
+struct startup_time {
+  std::string name;
+  std::chrono::steady_clock::duration elapsed;
+};
+
+/**
+ * Initialize every component of the environment, using up to the given number of threads, and report how long each took.
+ *
+ * Components do not interact while they are initialized, so they may be initialized concurrently.
+ * Modules that share mutable state between instances, or whose output must not interleave, should be initialized with one thread.
+ * If any component throws, the first exception is rethrown once every thread has finished.
+ */
+std::vector<startup_time> initialize(environment& env, unsigned threads);
+} // namespace champsim
+
+#endif
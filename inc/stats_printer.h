@@ -37,6 +37,10 @@ public:
   static std::vector<std::string> format(O3_CPU::stats_type stats);
   static std::vector<std::string> format(CACHE::stats_type stats);
   static std::vector<std::string> format(DRAM_CHANNEL::stats_type stats);
+  static std::vector<std::string> format(core_type_stats stats);
+  static std::vector<std::string> format(trace_stats stats);
+  static std::vector<std::string> format(dvfs_stats stats);
+  static std::vector<std::string> format(energy_stats stats);
   static std::vector<std::string> format(phase_stats& stats);
 };
 
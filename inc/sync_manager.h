@@ -0,0 +1,112 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYNC_MANAGER_H
+#define SYNC_MANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace champsim
+{
+enum class sync_kind { acquire, release, barrier };
+
+/**
+ * A synchronization event in one trace of a multithreaded workload.
+ * The event happens after the given number of instructions have been read from the trace.
+ */
+struct sync_event {
+  std::size_t thread;
+  uint64_t instr;
+  sync_kind kind;
+  uint64_t id;
+};
+
+/**
+ * Holds back the traces of a multithreaded workload so that they respect each other's locks and barriers.
+ *
+ * A trace that reaches an acquire waits until no other trace holds the lock. A trace that reaches a barrier waits until every trace that uses the
+ * barrier has reached it. Traces are held back as their instructions are read into the cores, so a lock is held from the time its acquire is
+ * fetched until its release is fetched.
+ */
+class sync_manager
+{
+  struct thread_state {
+    std::vector<sync_event> events{};
+    std::size_t next_event = 0;
+    uint64_t instrs_read = 0;
+    uint64_t events_passed = 0;
+    std::optional<uint64_t> barrier_generation{};
+    std::optional<sync_kind> waiting{};
+  };
+
+  struct barrier_state {
+    std::size_t participants = 0;
+    std::size_t arrived = 0;
+    uint64_t generation = 0;
+  };
+
+  std::vector<thread_state> m_threads{};
+  std::map<uint64_t, std::size_t> m_lock_owners{};
+  std::map<uint64_t, barrier_state> m_barriers{};
+
+  bool try_pass(std::size_t thread, const sync_event& event);
+
+public:
+  sync_manager() = default;
+  explicit sync_manager(std::vector<sync_event> events);
+
+  /**
+   * Whether the next instruction of the trace may be read.
+   * Every event that comes before the instruction and whose conditions are met is passed, in order.
+   */
+  bool may_read(std::size_t thread);
+
+  /**
+   * Record that the next instruction of the trace has been read.
+   */
+  void advance(std::size_t thread);
+
+  /**
+   * The event that holds back the trace, if it was held back at its last call to may_read().
+   */
+  [[nodiscard]] std::optional<sync_kind> waiting_on(std::size_t thread) const;
+
+  /**
+   * The number of events the trace has passed.
+   */
+  [[nodiscard]] uint64_t events_passed(std::size_t thread) const;
+
+  /**
+   * The number of traces that have events.
+   */
+  [[nodiscard]] std::size_t thread_count() const { return std::size(m_threads); }
+};
+
+/**
+ * Read synchronization events from a marker file.
+ *
+ * Each line holds the index of the trace, the number of instructions read from the trace before the event, the kind of event ("acquire",
+ * "release", or "barrier"), and the identifier of the lock or barrier. Blank lines and lines that begin with '#' are ignored.
+ */
+std::vector<sync_event> read_sync_markers(std::istream& in);
+} // namespace champsim
+
+#endif
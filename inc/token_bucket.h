@@ -0,0 +1,60 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TOKEN_BUCKET_H
+#define TOKEN_BUCKET_H
+
+#include <cstddef>
+
+#include "chrono.h"
+
+namespace champsim
+{
+/**
+ * A token bucket that holds up to a burst of tokens and gains one token each interval.
+ *
+ * The bucket is kept in its virtual-scheduling form: instead of a count of tokens, it records the time at which the bucket would be empty,
+ * so that no refill step is needed. A default-constructed bucket never runs out of tokens.
+ */
+class token_bucket
+{
+  champsim::chrono::clock::duration m_interval{};
+  champsim::chrono::clock::duration m_tolerance{};
+  champsim::chrono::clock::time_point m_empty_time{};
+
+public:
+  token_bucket() = default;
+  token_bucket(champsim::chrono::clock::duration interval, std::size_t burst);
+
+  /**
+   * Whether the bucket can run out of tokens.
+   */
+  [[nodiscard]] bool limited() const { return m_interval > champsim::chrono::clock::duration::zero(); }
+
+  /**
+   * Whether a token is available at the given time.
+   */
+  [[nodiscard]] bool may_take(champsim::chrono::clock::time_point now) const;
+
+  /**
+   * Remove one token from the bucket. The caller should check may_take() first.
+   */
+  void take(champsim::chrono::clock::time_point now);
+};
+} // namespace champsim
+
+#endif
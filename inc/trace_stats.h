@@ -0,0 +1,51 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACE_STATS_H
+#define TRACE_STATS_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * The instructions retired and cycles elapsed on the cores of one type.
+ */
+struct core_type_stats {
+  std::string name;
+  long long instrs = 0;
+  long long cycles = 0;
+};
+
+/**
+ * The statistics of one trace, when the traces are scheduled onto the cores by time slices.
+ */
+struct trace_stats {
+  std::string name;
+  long long instrs = 0;
+  long long cycles = 0;
+  uint64_t context_switches = 0;
+  uint64_t migrations = 0;
+
+  // The share of the instructions and cycles that the trace ran on each type of core
+  std::vector<core_type_stats> core_types = {};
+
+  // The misses in each cache that were caused by the core while it ran this trace
+  std::vector<std::pair<std::string, uint64_t>> cache_misses = {};
+};
+
+#endif
@@ -17,12 +17,15 @@
 #ifndef TRACEREADER_H
 #define TRACEREADER_H
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstring>
-#include <deque>
 #include <memory>
 #include <numeric>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "instruction.h"
 #include "util/detect.h"
@@ -84,17 +87,34 @@ class bulk_tracereader
   bool eof_ = false;
   F trace_file;
 
-  constexpr static std::size_t buffer_size = 128;
   constexpr static std::size_t refresh_thresh = 1;
-  std::deque<ooo_model_instr> instr_buffer;
+
+  // Decoded instructions are held in a fixed-capacity buffer. The first slot is reserved for the instruction carried over from the previous refill, which
+  // cannot be returned until its successor is known.
+  std::vector<T> record_buffer;
+  std::vector<ooo_model_instr> instr_buffer;
+  std::size_t instr_head = 0;
+  std::size_t instr_tail = 0;
+
+  void refill();
 
 public:
+  constexpr static std::size_t default_buffer_size = 4096;
+
   ooo_model_instr operator()();
 
-  bulk_tracereader(uint8_t cpu_idx, std::string tf) : cpu(cpu_idx), trace_file(tf) {}
-  bulk_tracereader(uint8_t cpu_idx, F&& file) : cpu(cpu_idx), trace_file(std::move(file)) {}
+  bulk_tracereader(uint8_t cpu_idx, std::string tf, std::size_t buffer_size = default_buffer_size)
+      : cpu(cpu_idx), trace_file(tf), record_buffer(buffer_size - refresh_thresh), instr_buffer(buffer_size, ooo_model_instr{cpu_idx, T{}})
+  {
+    assert(buffer_size > refresh_thresh);
+  }
+  bulk_tracereader(uint8_t cpu_idx, F&& file, std::size_t buffer_size = default_buffer_size)
+      : cpu(cpu_idx), trace_file(std::move(file)), record_buffer(buffer_size - refresh_thresh), instr_buffer(buffer_size, ooo_model_instr{cpu_idx, T{}})
+  {
+    assert(buffer_size > refresh_thresh);
+  }
 
-  [[nodiscard]] bool eof() const { return trace_file.eof() && std::size(instr_buffer) <= refresh_thresh; }
+  [[nodiscard]] bool eof() const { return trace_file.eof() && (instr_tail - instr_head) <= refresh_thresh; }
 };
 
 ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_instr& target);
@@ -107,38 +127,61 @@ void set_branch_targets(It begin, It end)
   std::adjacent_difference(rbegin, rend, rbegin, apply_branch_target);
 }
 
+template <typename T, typename F>
+void bulk_tracereader<T, F>::refill()
+{
+  // Move the carried-over instruction to the front
+  auto carried = std::move_backward(std::next(std::begin(instr_buffer), static_cast<long>(instr_head)),
+                                    std::next(std::begin(instr_buffer), static_cast<long>(instr_tail)), std::next(std::begin(instr_buffer), refresh_thresh));
+  instr_head = static_cast<std::size_t>(std::distance(std::begin(instr_buffer), carried));
+  instr_tail = refresh_thresh;
+
+  // Read from trace file directly into the record buffer
+  trace_file.read(reinterpret_cast<char*>(std::data(record_buffer)), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast): T is trivial
+                  static_cast<std::streamsize>(std::size(record_buffer) * sizeof(T)));
+  auto records_read = static_cast<std::size_t>(trace_file.gcount()) / sizeof(T);
+  eof_ = trace_file.eof();
+
+  // Inflate trace format into core model instructions
+  auto end = std::transform(std::begin(record_buffer), std::next(std::begin(record_buffer), static_cast<long>(records_read)),
+                            std::next(std::begin(instr_buffer), static_cast<long>(instr_tail)), [cpu = this->cpu](T t) { return ooo_model_instr{cpu, t}; });
+  instr_tail = static_cast<std::size_t>(std::distance(std::begin(instr_buffer), end));
+
+  // Set branch targets
+  set_branch_targets(std::next(std::begin(instr_buffer), static_cast<long>(instr_head)), end);
+}
+
 template <typename T, typename F>
 ooo_model_instr bulk_tracereader<T, F>::operator()()
 {
-  if (std::size(instr_buffer) <= refresh_thresh) {
-    std::array<T, buffer_size - refresh_thresh> trace_read_buf;
-    std::array<char, std::size(trace_read_buf) * sizeof(T)> raw_buf;
-    std::size_t bytes_read;
-
-    // Read from trace file
-    trace_file.read(std::data(raw_buf), std::size(raw_buf));
-    bytes_read = static_cast<std::size_t>(trace_file.gcount());
-    eof_ = trace_file.eof();
-
-    // Transform bytes into trace format instructions
-    std::memcpy(std::data(trace_read_buf), std::data(raw_buf), bytes_read);
-
-    // Inflate trace format into core model instructions
-    auto begin = std::begin(trace_read_buf);
-    auto end = std::next(begin, bytes_read / sizeof(T));
-    std::transform(begin, end, std::back_inserter(instr_buffer), [cpu = this->cpu](T t) { return ooo_model_instr{cpu, t}; });
-
-    // Set branch targets
-    set_branch_targets(std::begin(instr_buffer), std::end(instr_buffer));
+  while ((instr_tail - instr_head) <= refresh_thresh && !trace_file.eof()) {
+    refill();
   }
 
-  auto retval = instr_buffer.front();
-  instr_buffer.pop_front();
-
-  return retval;
+  return std::move(instr_buffer.at(instr_head++));
 }
 
 std::string get_fptr_cmd(std::string_view fname);
+
+/**
+ * An optional header that a producer may write at the beginning of a streamed trace, so that the reader need not infer the record format and compression
+ * from the file name. Streams without this header fall back to the command-line options and the name of the source.
+ */
+struct trace_stream_header {
+  enum class format_type : uint8_t { input_instr = 0, cloudsuite_instr = 1, columnar = 2 };
+  enum class compression_type : uint8_t { none = 0, gzip = 1, xz = 2, bzip2 = 3 };
+
+  constexpr static std::array<char, 4> expected_magic{'C', 'S', 'T', 'R'};
+  constexpr static uint8_t current_version = 1;
+
+  std::array<char, 4> magic = expected_magic;
+  uint8_t version = current_version;
+  format_type format = format_type::input_instr;
+  compression_type compression = compression_type::none;
+  uint8_t reserved = 0;
+};
+static_assert(sizeof(trace_stream_header) == 8);
+static_assert(std::is_trivially_copyable_v<trace_stream_header>);
 } // namespace champsim
 
 champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat);
@@ -18,10 +18,10 @@
 #define VMEM_H
 
 #include <cstdint>
-#include <deque>
 #include <map>
 #include <optional>
 #include <random>
+#include <vector>
 
 #include "address.h"
 #include "champsim.h"
@@ -37,6 +37,7 @@ private:
   std::map<std::pair<uint32_t, champsim::page_number>, champsim::page_number> vpage_to_ppage_map;
   std::map<std::tuple<uint32_t, uint32_t, champsim::address_slice<champsim::dynamic_extent>>, champsim::address> page_table;
   std::optional<uint64_t> randomization_seed;
+  std::optional<unsigned> address_space_shift;
   MEMORY_CONTROLLER& dram;
 
 public:
@@ -45,7 +46,11 @@ public:
   const pte_entry pte_page_size; // Size of a PTE page
 
 private:
-  std::deque<champsim::page_number> ppage_free_list;
+  // Free pages are handed out in order from a range, or from a shuffled list of that range if there is a randomization seed
+  std::vector<champsim::page_number> ppage_shuffled;
+  champsim::page_number ppage_range_begin{};
+  std::size_t ppage_range_size = 0;
+  std::size_t ppage_range_taken = 0;
   champsim::page_number active_pte_page{};
   champsim::address_slice<champsim::dynamic_extent> next_pte_page;
 
@@ -58,6 +63,8 @@ private:
   void shuffle_pages();
   void populate_pages();
 
+  [[nodiscard]] uint32_t address_space(uint32_t cpu_num, champsim::page_number vaddr) const;
+
 public:
   /**
    * Initialize the virtual memory.
@@ -96,11 +103,17 @@ public:
    */
   [[nodiscard]] std::size_t available_ppages() const;
 
+  /**
+   * Identify address spaces by the tag in the bits of the virtual address at and above the given position, instead of by the requesting core.
+   * Traces that move between cores then keep their pages.
+   */
+  void tag_address_spaces(unsigned shift);
+
   /**
    * Translate the given address from the virtual space to the physical space.
    * If a page translation does not already exist, one will be created and the minor fault penalty will be applied.
    *
-   * :param cpu_num: The cpu index of the core making the request. This is currently used as an address space ID.
+   * :param cpu_num: The cpu index of the core making the request. This is used as an address space ID, unless address spaces are tagged.
    * :param vaddr: The address to translate.
    *
    * :returns: A pair of the physical address and the latency to be applied to the translation.
@@ -111,7 +124,7 @@ public:
    * Find the address for the page table page for the given virtual address (under translation), and the given level.
    * If a page table page does not already exist, one will be created and the minor fault penalty will be applied.
    *
-   * :param cpu_num: The cpu index of the core making the request. This is currently used as an address space ID.
+   * :param cpu_num: The cpu index of the core making the request. This is used as an address space ID, unless address spaces are tagged.
    * :param vaddr: The address to translate.
    * :param level: The current level being translated.
    *
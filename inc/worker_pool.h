@@ -0,0 +1,81 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A fixed set of threads that share the iterations of short loops with the calling thread.
+ *
+ * The loops of a simulation are run once per cycle, so the threads wait for work by spinning rather than sleeping.
+ * A pool of one thread has no helpers, and runs every loop on the calling thread.
+ */
+class worker_pool
+{
+  struct job {
+    void (*run)(void*, std::size_t);
+    void* context;
+    std::size_t count;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+  };
+
+  std::atomic<job*> m_job{nullptr};
+  std::atomic<uint64_t> m_generation{0};
+  std::atomic<std::size_t> m_visitors{0};
+  std::atomic<bool> m_stop{false};
+  std::vector<std::thread> m_helpers;
+
+  static void drain(job& work);
+  void help();
+  void run(job& work);
+
+public:
+  explicit worker_pool(std::size_t threads);
+  ~worker_pool();
+
+  worker_pool(const worker_pool&) = delete;
+  worker_pool& operator=(const worker_pool&) = delete;
+
+  /**
+   * The number of threads that run each loop, including the calling thread.
+   */
+  [[nodiscard]] std::size_t size() const { return std::size(m_helpers) + 1; }
+
+  /**
+   * Call the function once with each index in [0, count), and return when every call has returned.
+   * The calls may be made concurrently and in any order.
+   */
+  template <typename F>
+  void for_each_index(std::size_t count, F&& func)
+  {
+    job work{[](void* context, std::size_t idx) { (*static_cast<std::remove_reference_t<F>*>(context))(idx); }, &func, count};
+    run(work);
+  }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "block_array.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <fmt/core.h>
+
+champsim::block_array::block_array(std::size_t sets, std::size_t ways)
+    : m_sets(sets), m_ways(ways), m_pages((sets + sets_per_page - 1) / sets_per_page)
+{
+  // Small caches fit in one page, which holds the blocks from the start. Larger caches read untouched pages from a shared invalid page.
+  if (!std::empty(m_pages)) {
+    m_pages.front().resize(page_size());
+  }
+  if (std::size(m_pages) > 1) {
+    m_invalid_page.resize(page_size());
+  }
+}
+
+std::size_t champsim::block_array::page_size() const { return std::min(m_sets, sets_per_page) * m_ways; }
+
+auto champsim::block_array::set(std::size_t set_idx) -> cache_block*
+{
+  auto& page = m_pages[set_idx / sets_per_page];
+  if (std::empty(page)) {
+    page.resize(page_size());
+  }
+  return std::data(page) + (set_idx % sets_per_page) * m_ways;
+}
+
+auto champsim::block_array::set(std::size_t set_idx) const -> const cache_block*
+{
+  const auto& page = m_pages[set_idx / sets_per_page];
+  return std::data(std::empty(page) ? m_invalid_page : page) + (set_idx % sets_per_page) * m_ways;
+}
+
+auto champsim::block_array::at(std::size_t idx) -> cache_block&
+{
+  if (idx >= size()) {
+    throw std::out_of_range{fmt::format("Block {} is beyond the {} blocks of the cache", idx, size())};
+  }
+  return set(idx / m_ways)[idx % m_ways];
+}
+
+auto champsim::block_array::at(std::size_t idx) const -> const cache_block&
+{
+  if (idx >= size()) {
+    throw std::out_of_range{fmt::format("Block {} is beyond the {} blocks of the cache", idx, size())};
+  }
+  return set(idx / m_ways)[idx % m_ways];
+}
+
+void champsim::block_array::invalidate()
+{
+  for (auto& page : m_pages) {
+    std::for_each(std::begin(page), std::end(page), [](auto& blk) { blk.valid = false; });
+  }
+}
+
+std::size_t champsim::block_array::allocated_pages() const
+{
+  return static_cast<std::size_t>(std::count_if(std::cbegin(m_pages), std::cend(m_pages), [](const auto& page) { return !std::empty(page); }));
+}
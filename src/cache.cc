@@ -21,6 +21,7 @@
 #include <cmath>
 #include <iomanip>
 #include <numeric>
+#include <utility>
 #include <fmt/core.h>
 
 #include "bandwidth.h"
@@ -28,6 +29,7 @@
 #include "chrono.h"
 #include "deadlock.h"
 #include "instruction.h"
+#include "replay_log.h"
 #include "util/algorithm.h"
 #include "util/bits.h"
 #include "util/span.h"
@@ -40,7 +42,8 @@ CACHE::CACHE(CACHE&& other)
       cpu(other.cpu), NAME(std::move(other.NAME)), NUM_SET(other.NUM_SET), NUM_WAY(other.NUM_WAY), MSHR_SIZE(other.MSHR_SIZE), PQ_SIZE(other.PQ_SIZE),
       HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)), MAX_TAG(other.MAX_TAG),
       MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load), match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch),
-      pref_activate_mask(std::move(other.pref_activate_mask)),
+      pref_activate_mask(std::move(other.pref_activate_mask)), fixed_geometry(other.fixed_geometry),
+      sampler(std::move(other.sampler)),
 
       sim_stats(std::move(other.sim_stats)), roi_stats(std::move(other.roi_stats)),
 
@@ -79,6 +82,8 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
   this->match_offset_bits = other.match_offset_bits;
   this->virtual_prefetch = other.virtual_prefetch;
   this->pref_activate_mask = std::move(other.pref_activate_mask);
+  this->fixed_geometry = other.fixed_geometry;
+  this->sampler = std::move(other.sampler);
 
   this->sim_stats = std::move(other.sim_stats);
   this->roi_stats = std::move(other.roi_stats);
@@ -92,9 +97,9 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
   return *this;
 }
 
-CACHE::tag_lookup_type::tag_lookup_type(const request_type& req, bool local_pref, bool skip)
+CACHE::tag_lookup_type::tag_lookup_type(request_type req, bool local_pref, bool skip)
     : address(req.address), v_address(req.v_address), data(req.data), ip(req.ip), instr_id(req.instr_id), pf_metadata(req.pf_metadata), cpu(req.cpu),
-      type(req.type), prefetch_from_this(local_pref), skip_fill(skip), is_translated(req.is_translated), instr_depend_on_me(req.instr_depend_on_me)
+      type(req.type), prefetch_from_this(local_pref), skip_fill(skip), is_translated(req.is_translated), instr_depend_on_me(std::move(req.instr_depend_on_me))
 {
 }
 
@@ -104,24 +109,26 @@ CACHE::mshr_type::mshr_type(const tag_lookup_type& req, champsim::chrono::clock:
 {
 }
 
-CACHE::mshr_type CACHE::mshr_type::merge(mshr_type predecessor, mshr_type successor)
+CACHE::mshr_type CACHE::mshr_type::merge(mshr_type&& predecessor, mshr_type&& successor)
 {
-  std::vector<uint64_t> merged_instr{};
-  std::vector<std::deque<response_type>*> merged_return{};
+  champsim::pooled_list<uint64_t> merged_instr{};
+  champsim::pooled_list<std::deque<response_type>*> merged_return{};
 
   std::set_union(std::begin(predecessor.instr_depend_on_me), std::end(predecessor.instr_depend_on_me), std::begin(successor.instr_depend_on_me),
                  std::end(successor.instr_depend_on_me), std::back_inserter(merged_instr));
   std::set_union(std::begin(predecessor.to_return), std::end(predecessor.to_return), std::begin(successor.to_return), std::end(successor.to_return),
                  std::back_inserter(merged_return));
 
-  mshr_type retval{(successor.type == access_type::PREFETCH) ? predecessor : successor};
-
   // set the time enqueued to the predecessor unless its a demand into prefetch, in which case we use the successor
-  retval.time_enqueued =
+  auto time_enqueued =
       ((successor.type != access_type::PREFETCH && predecessor.type == access_type::PREFETCH)) ? successor.time_enqueued : predecessor.time_enqueued;
-  retval.instr_depend_on_me = merged_instr;
-  retval.to_return = merged_return;
-  retval.data_promise = predecessor.data_promise;
+  auto data_promise = predecessor.data_promise;
+
+  mshr_type retval{(successor.type == access_type::PREFETCH) ? std::move(predecessor) : std::move(successor)};
+  retval.time_enqueued = time_enqueued;
+  retval.instr_depend_on_me = std::move(merged_instr);
+  retval.to_return = std::move(merged_return);
+  retval.data_promise = data_promise;
 
   if constexpr (champsim::debug_print) {
     if (successor.type == access_type::PREFETCH) {
@@ -138,7 +145,7 @@ CACHE::mshr_type CACHE::mshr_type::merge(mshr_type predecessor, mshr_type succes
   return retval;
 }
 
-auto CACHE::fill_block(mshr_type mshr, uint32_t metadata) -> BLOCK
+auto CACHE::fill_block(const mshr_type& mshr, uint32_t metadata) -> BLOCK
 {
   CACHE::BLOCK to_fill;
   to_fill.valid = true;
@@ -155,14 +162,14 @@ auto CACHE::fill_block(mshr_type mshr, uint32_t metadata) -> BLOCK
 auto CACHE::matches_address(champsim::address addr) const
 {
   return [match = addr.slice_upper(OFFSET_BITS), shamt = OFFSET_BITS](const auto& entry) {
-    return entry.address.slice_upper(shamt) == match;
+    return champsim::address{entry.address}.slice_upper(shamt) == match;
   };
 }
 
 template <typename T>
 champsim::address CACHE::module_address(const T& element) const
 {
-  auto address = virtual_prefetch ? element.v_address : element.address;
+  champsim::address address = virtual_prefetch ? element.v_address : element.address;
   return champsim::address{address.slice_upper(match_offset_bits ? champsim::data::bits{} : OFFSET_BITS)};
 }
 
@@ -172,7 +179,8 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
 
   // find victim
   auto [set_begin, set_end] = get_set_span(fill_mshr.address);
-  auto way = std::find_if_not(set_begin, set_end, [](auto x) { return x.valid; });
+  auto way = fixed_geometry != nullptr ? std::next(set_begin, fixed_geometry->find_invalid(&*set_begin))
+                                       : std::find_if_not(set_begin, set_end, [](const auto& x) { return x.valid; });
   if (way == set_end) {
     way = std::next(set_begin, impl_find_victim(fill_mshr.cpu, fill_mshr.instr_id, get_set_index(fill_mshr.address), &*set_begin, fill_mshr.ip,
                                                 fill_mshr.address, fill_mshr.type));
@@ -206,7 +214,7 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
                  fill_mshr.data_promise->pf_metadata);
     }
 
-    auto success = lower_level->add_wq(writeback_packet);
+    auto success = lower_level->add_wq(std::move(writeback_packet));
     if (!success) {
       return false;
     }
@@ -234,9 +242,18 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
     *way = fill_block(fill_mshr, metadata_thru);
   }
 
+  if (replay_chain != nullptr) {
+    replay_chain->add(champsim::replay::event::fill, fill_mshr.address.to<uint64_t>());
+    replay_chain->add(champsim::replay::event::fill, static_cast<uint64_t>(way_idx));
+  }
+
   // COLLECT STATS
-  if (fill_mshr.type != access_type::PREFETCH)
+  if (fill_mshr.type != access_type::PREFETCH) {
     sim_stats.total_miss_latency_cycles += (current_time - (fill_mshr.time_enqueued + clock_period)) / clock_period;
+    if (sampler.enabled()) {
+      sampler.record_latency(HIT_LATENCY + (current_time - fill_mshr.time_enqueued));
+    }
+  }
   sim_stats.mshr_return.increment(std::pair{fill_mshr.type, fill_mshr.cpu});
 
   response_type response{fill_mshr.address, fill_mshr.v_address, fill_mshr.data_promise->data, metadata_thru, fill_mshr.instr_depend_on_me};
@@ -251,9 +268,11 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 {
   cpu = handle_pkt.cpu;
 
-  // access cache
-  auto [set_begin, set_end] = get_set_span(handle_pkt.address);
-  auto way = std::find_if(set_begin, set_end, [matcher = matches_address(handle_pkt.address)](const auto& x) { return x.valid && matcher(x); });
+  // access cache, without allocating the page of the set if the access misses
+  auto [set_begin, set_end] = std::as_const(*this).get_set_span(handle_pkt.address);
+  auto way = fixed_geometry != nullptr
+                 ? std::next(set_begin, fixed_geometry->find_valid(&*set_begin, handle_pkt.address))
+                 : std::find_if(set_begin, set_end, [matcher = matches_address(handle_pkt.address)](const auto& x) { return x.valid && matcher(x); });
   const auto hit = (way != set_end);
   const auto useful_prefetch = (hit && way->prefetch && !handle_pkt.prefetch_from_this);
 
@@ -275,18 +294,23 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 
   if (hit) {
     sim_stats.hits.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+    if (sampler.enabled() && handle_pkt.type != access_type::PREFETCH) {
+      sampler.record_latency(HIT_LATENCY);
+    }
 
     response_type response{handle_pkt.address, handle_pkt.v_address, way->data, metadata_thru, handle_pkt.instr_depend_on_me};
     for (auto* ret : handle_pkt.to_return) {
       ret->push_back(response);
     }
 
-    way->dirty |= (handle_pkt.type == access_type::WRITE);
+    // The set holds a valid block, so its page is already allocated
+    auto& hit_block = get_set_span(handle_pkt.address).first[way_idx];
+    hit_block.dirty |= (handle_pkt.type == access_type::WRITE);
 
     // update prefetch stats and reset prefetch bit
     if (useful_prefetch) {
       ++sim_stats.pf_useful;
-      way->prefetch = false;
+      hit_block.prefetch = false;
     }
   }
 
@@ -325,11 +349,9 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
                current_time.time_since_epoch() / clock_period);
   }
 
-  mshr_type to_allocate{handle_pkt, current_time};
-
   cpu = handle_pkt.cpu;
 
-  auto mshr_pkt = mshr_and_forward_packet(handle_pkt);
+  auto [to_allocate, fwd_pkt] = mshr_and_forward_packet(handle_pkt);
 
   // check mshr
   auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(handle_pkt.address));
@@ -347,30 +369,39 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
     // COLLECT STATS
     sim_stats.mshr_merge.increment(std::pair{to_allocate.type, to_allocate.cpu});
 
-    *mshr_entry = mshr_type::merge(*mshr_entry, to_allocate);
+    *mshr_entry = mshr_type::merge(std::move(*mshr_entry), std::move(to_allocate));
   } else {
     if (mshr_full) { // not enough MSHR resource
       return false;  // TODO should we allow prefetches anyway if they will not be filled to this level?
     }
 
     const bool send_to_rq = (prefetch_as_load || handle_pkt.type != access_type::PREFETCH);
-    bool success = send_to_rq ? lower_level->add_rq(mshr_pkt.second) : lower_level->add_pq(mshr_pkt.second);
+    const bool response_requested = fwd_pkt.response_requested;
+    bool success = send_to_rq ? lower_level->add_rq(std::move(fwd_pkt)) : lower_level->add_pq(std::move(fwd_pkt));
 
     if (!success) {
       return false;
     }
 
     // Allocate an MSHR
-    if (mshr_pkt.second.response_requested) {
-      MSHR.emplace_back(std::move(mshr_pkt.first));
+    if (response_requested) {
+      MSHR.emplace_back(std::move(to_allocate));
     }
   }
 
   sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+  record_sampled_miss(handle_pkt.address);
 
   return true;
 }
 
+void CACHE::record_sampled_miss(champsim::address address)
+{
+  if (sampler.enabled() && !std::empty(sim_stats.sampled_set_misses)) {
+    ++sim_stats.sampled_set_misses.at(static_cast<std::size_t>(sampler.sample_index(get_set_index(address))));
+  }
+}
+
 bool CACHE::handle_write(const tag_lookup_type& handle_pkt)
 {
   if constexpr (champsim::debug_print) {
@@ -381,9 +412,10 @@ bool CACHE::handle_write(const tag_lookup_type& handle_pkt)
 
   mshr_type to_allocate{handle_pkt, current_time};
   to_allocate.data_promise.ready_at(current_time + (warmup ? champsim::chrono::clock::duration{} : FILL_LATENCY));
-  inflight_writes.push_back(to_allocate);
+  inflight_writes.push_back(std::move(to_allocate));
 
   sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+  record_sampled_miss(handle_pkt.address);
 
   return true;
 }
@@ -391,16 +423,18 @@ bool CACHE::handle_write(const tag_lookup_type& handle_pkt)
 template <bool UpdateRequest>
 auto CACHE::initiate_tag_check(champsim::channel* ul)
 {
-  return [time = current_time + (warmup ? champsim::chrono::clock::duration{} : HIT_LATENCY), ul](const auto& entry) {
-    CACHE::tag_lookup_type retval{entry};
+  // The entry is removed from its queue once its tag check is initiated, so its lists can be moved
+  return [time = current_time + (warmup ? champsim::chrono::clock::duration{} : HIT_LATENCY), ul](auto& entry) {
+    bool response_requested = false;
+    if constexpr (UpdateRequest) {
+      response_requested = entry.response_requested;
+    }
+
+    CACHE::tag_lookup_type retval{std::move(entry)};
     retval.event_cycle = time;
 
-    if constexpr (UpdateRequest) {
-      if (entry.response_requested) {
-        retval.to_return = {&ul->returned};
-      }
-    } else {
-      (void)ul; // supress warning about ul being unused
+    if (response_requested) {
+      retval.to_return = {&ul->returned};
     }
 
     if constexpr (champsim::debug_print) {
@@ -478,7 +512,9 @@ long CACHE::operate()
       champsim::bandwidth per_upper_tag_bw{std::min(per_upper_bandwidth, champsim::bandwidth::maximum_type{initiate_tag_bw.amount_remaining()})};
       auto bandwidth_consumed =
           champsim::transform_while_n(q.get(), std::back_inserter(inflight_tag_check), per_upper_tag_bw, can_translate, initiate_tag_check<true>(ul));
-      channels_bandwidth_consumed.push_back(bandwidth_consumed);
+      if constexpr (champsim::debug_print) {
+        channels_bandwidth_consumed.push_back(bandwidth_consumed);
+      }
       initiate_tag_bw.consume(bandwidth_consumed);
     }
   }
@@ -497,6 +533,29 @@ long CACHE::operate()
   progress += std::distance(last_not_missed, std::end(inflight_tag_check));
   inflight_tag_check.erase(last_not_missed, std::end(inflight_tag_check));
 
+  // Accesses to sets that are not sampled skip the tag check, and return after the average latency of the sampled sets
+  if (sampler.enabled()) {
+    const auto first_unsampled = static_cast<long>(std::size(unsampled_returns));
+    auto [sampled_end, unsampled_end] =
+        champsim::extract_if(std::begin(inflight_tag_check), std::end(inflight_tag_check), std::back_inserter(unsampled_returns),
+                             [is_translated, this](const auto& x) { return is_translated(x) && !this->sampler.is_sampled(this->get_set_index(x.address)); });
+    inflight_tag_check.erase(sampled_end, std::end(inflight_tag_check));
+
+    const auto return_time = current_time + (warmup ? champsim::chrono::clock::duration{} : sampler.average_latency(HIT_LATENCY));
+    std::for_each(std::next(std::begin(unsampled_returns), first_unsampled), std::end(unsampled_returns),
+                  [return_time](auto& x) { x.event_cycle = return_time; });
+
+    auto returned_end = std::find_if_not(std::begin(unsampled_returns), std::end(unsampled_returns), is_ready);
+    std::for_each(std::begin(unsampled_returns), returned_end, [](const auto& pkt) {
+      response_type response{pkt.address, pkt.v_address, pkt.data, pkt.pf_metadata, pkt.instr_depend_on_me};
+      for (auto* ret : pkt.to_return) {
+        ret->push_back(response);
+      }
+    });
+    progress += std::distance(std::begin(unsampled_returns), returned_end);
+    unsampled_returns.erase(std::begin(unsampled_returns), returned_end);
+  }
+
   // Perform tag checks
   auto do_handle_miss = [this](const auto& pkt) {
     if (pkt.type == access_type::WRITE && !this->match_offset_bits) {
@@ -508,10 +567,11 @@ long CACHE::operate()
   auto [tag_check_ready_begin, tag_check_ready_end] =
       champsim::get_span_p(std::begin(inflight_tag_check), std::end(inflight_tag_check), tag_check_bw,
                            [is_ready, is_translated](const auto& pkt) { return is_ready(pkt) && is_translated(pkt); });
-  auto hits_end = std::stable_partition(tag_check_ready_begin, tag_check_ready_end, [this](const auto& pkt) { return this->try_hit(pkt); });
-  auto finish_tag_check_end = std::stable_partition(hits_end, tag_check_ready_end, do_handle_miss);
-  tag_check_bw.consume(std::distance(tag_check_ready_begin, finish_tag_check_end));
-  inflight_tag_check.erase(tag_check_ready_begin, finish_tag_check_end);
+  // Finished tag checks are removed in place, keeping the unfinished ones in order, so that no temporary buffer is allocated
+  auto misses_end = std::remove_if(tag_check_ready_begin, tag_check_ready_end, [this](const auto& pkt) { return this->try_hit(pkt); });
+  auto unfinished_end = std::remove_if(tag_check_ready_begin, misses_end, do_handle_miss);
+  tag_check_bw.consume(std::distance(unfinished_end, tag_check_ready_end));
+  inflight_tag_check.erase(unfinished_end, tag_check_ready_end);
 
   impl_prefetcher_cycle_operate();
 
@@ -529,27 +589,38 @@ long CACHE::operate()
 uint64_t CACHE::get_set(uint64_t address) const { return static_cast<uint64_t>(get_set_index(champsim::address{address})); }
 // LCOV_EXCL_STOP
 
-long CACHE::get_set_index(champsim::address address) const { return address.slice(champsim::dynamic_extent{OFFSET_BITS, champsim::lg2(NUM_SET)}).to<long>(); }
+long CACHE::get_set_index(champsim::address address) const
+{
+  if (fixed_geometry != nullptr) {
+    return fixed_geometry->set_index(address);
+  }
+  return address.slice(champsim::dynamic_extent{OFFSET_BITS, champsim::lg2(NUM_SET)}).to<long>();
+}
 
-template <typename It>
-std::pair<It, It> get_span(It anchor, typename std::iterator_traits<It>::difference_type set_idx, typename std::iterator_traits<It>::difference_type num_way)
+const champsim::cache_geometry_table* CACHE::checked_geometry(const champsim::cache_geometry_table* geometry, uint32_t sets, uint32_t ways,
+                                                              champsim::data::bits offset_bits)
 {
-  auto begin = std::next(anchor, set_idx * num_way);
-  return {std::move(begin), std::next(begin, num_way)};
+  // The geometry may have been changed after it was fixed, in which case the specialized operations do not apply
+  if (geometry == nullptr || geometry->sets != sets || geometry->ways != ways || geometry->offset_bits != offset_bits) {
+    return nullptr;
+  }
+  return geometry;
 }
 
-auto CACHE::get_set_span(champsim::address address) -> std::pair<set_type::iterator, set_type::iterator>
+auto CACHE::get_set_span(champsim::address address) -> std::pair<BLOCK*, BLOCK*>
 {
   const auto set_idx = get_set_index(address);
   assert(set_idx < NUM_SET);
-  return get_span(std::begin(block), static_cast<set_type::difference_type>(set_idx), NUM_WAY); // safe cast because of prior assert
+  auto* begin = block.set(static_cast<std::size_t>(set_idx)); // safe cast because of prior assert
+  return {begin, std::next(begin, NUM_WAY)};
 }
 
-auto CACHE::get_set_span(champsim::address address) const -> std::pair<set_type::const_iterator, set_type::const_iterator>
+auto CACHE::get_set_span(champsim::address address) const -> std::pair<const BLOCK*, const BLOCK*>
 {
   const auto set_idx = get_set_index(address);
   assert(set_idx < NUM_SET);
-  return get_span(std::cbegin(block), static_cast<set_type::difference_type>(set_idx), NUM_WAY); // safe cast because of prior assert
+  const auto* begin = block.set(static_cast<std::size_t>(set_idx)); // safe cast because of prior assert
+  return {begin, std::next(begin, NUM_WAY)};
 }
 
 // LCOV_EXCL_START exclude deprecated function
@@ -563,16 +634,20 @@ uint64_t CACHE::get_way(uint64_t address, uint64_t /*unused set index*/) const
 
 long CACHE::invalidate_entry(champsim::address inval_addr)
 {
-  auto [begin, end] = get_set_span(inval_addr);
-  auto inv_way = std::find_if(begin, end, matches_address(inval_addr));
+  auto [begin, end] = std::as_const(*this).get_set_span(inval_addr);
+  auto inv_way = fixed_geometry != nullptr ? std::next(begin, fixed_geometry->find_any(&*begin, inval_addr))
+                                           : std::find_if(begin, end, matches_address(inval_addr));
 
-  if (inv_way != end) {
-    inv_way->valid = false;
+  // Only a valid block is modified, so that invalidating an address that is not cached does not allocate the page of its set
+  if (inv_way != end && inv_way->valid) {
+    get_set_span(inval_addr).first[std::distance(begin, inv_way)].valid = false;
   }
 
   return std::distance(begin, inv_way);
 }
 
+void CACHE::invalidate_all() { block.invalidate(); }
+
 bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata)
 {
   ++sim_stats.pf_requested;
@@ -611,7 +686,7 @@ void CACHE::finish_packet(const response_type& packet)
 {
   // check MSHR information
   auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(packet.address));
-  auto first_unreturned = std::find_if(MSHR.begin(), MSHR.end(), [](auto x) { return x.data_promise.has_unknown_readiness(); });
+  auto first_unreturned = std::find_if(MSHR.begin(), MSHR.end(), [](const auto& x) { return x.data_promise.has_unknown_readiness(); });
 
   // sanity check
   if (mshr_entry == MSHR.end()) {
@@ -679,7 +754,7 @@ void CACHE::issue_translation(tag_lookup_type& q_entry) const
     fwd_pkt.instr_depend_on_me = q_entry.instr_depend_on_me;
     fwd_pkt.is_translated = true;
 
-    q_entry.translate_issued = lower_translate->add_rq(fwd_pkt);
+    q_entry.translate_issued = lower_translate->add_rq(std::move(fwd_pkt));
     if constexpr (champsim::debug_print) {
       if (q_entry.translate_issued) {
         fmt::print("[TRANSLATE] do_issue_translation instr_id: {} paddr: {} vaddr: {} type: {}\n", q_entry.instr_id, q_entry.address, q_entry.v_address,
@@ -850,6 +925,13 @@ void CACHE::begin_phase()
 
   new_roi_stats.name = NAME;
   new_sim_stats.name = NAME;
+  new_sim_stats.begin_cycles = cycle_count();
+
+  if (sampler.enabled()) {
+    new_sim_stats.sampled_sets = sampler.sampled_sets();
+    new_sim_stats.total_sets = sampler.total_sets();
+    new_sim_stats.sampled_set_misses.assign(static_cast<std::size_t>(sampler.sampled_sets()), 0);
+  }
 
   roi_stats = new_roi_stats;
   sim_stats = new_sim_stats;
@@ -862,9 +944,21 @@ void CACHE::begin_phase()
   }
 }
 
+void CACHE::clock_period_changed(champsim::chrono::picoseconds old_period)
+{
+  HIT_LATENCY = champsim::rescale_latency(HIT_LATENCY, old_period, clock_period);
+  FILL_LATENCY = champsim::rescale_latency(FILL_LATENCY, old_period, clock_period);
+}
+
 void CACHE::end_phase(unsigned finished_cpu)
 {
   finished_cpu = finished_cpu;
+
+  // Record where the phase ended (overwrite if this is later)
+  sim_stats.end_cycles = cycle_count();
+  roi_stats.begin_cycles = sim_stats.begin_cycles;
+  roi_stats.end_cycles = sim_stats.end_cycles;
+
   roi_stats.total_miss_latency_cycles = sim_stats.total_miss_latency_cycles;
 
   roi_stats.hits = sim_stats.hits;
@@ -878,6 +972,10 @@ void CACHE::end_phase(unsigned finished_cpu)
   roi_stats.pf_useless = sim_stats.pf_useless;
   roi_stats.pf_fill = sim_stats.pf_fill;
 
+  roi_stats.sampled_sets = sim_stats.sampled_sets;
+  roi_stats.total_sets = sim_stats.total_sets;
+  roi_stats.sampled_set_misses = sim_stats.sampled_set_misses;
+
   for (auto* ul : upper_levels) {
     ul->roi_stats.RQ_ACCESS = ul->sim_stats.RQ_ACCESS;
     ul->roi_stats.RQ_MERGED = ul->sim_stats.RQ_MERGED;
@@ -1,8 +1,16 @@
 #include "cache_stats.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+
 cache_stats operator-(cache_stats lhs, cache_stats rhs)
 {
   cache_stats result;
+  result.begin_cycles = lhs.begin_cycles - rhs.begin_cycles;
+  result.end_cycles = lhs.end_cycles - rhs.end_cycles;
+
   result.pf_requested = lhs.pf_requested - rhs.pf_requested;
   result.pf_issued = lhs.pf_issued - rhs.pf_issued;
   result.pf_useful = lhs.pf_useful - rhs.pf_useful;
@@ -13,5 +21,34 @@ cache_stats operator-(cache_stats lhs, cache_stats rhs)
   result.misses = lhs.misses - rhs.misses;
 
   result.total_miss_latency_cycles = lhs.total_miss_latency_cycles - rhs.total_miss_latency_cycles;
+
+  result.sampled_sets = lhs.sampled_sets;
+  result.total_sets = lhs.total_sets;
+  result.sampled_set_misses = lhs.sampled_set_misses;
+  if (std::size(lhs.sampled_set_misses) == std::size(rhs.sampled_set_misses)) {
+    std::transform(std::begin(lhs.sampled_set_misses), std::end(lhs.sampled_set_misses), std::begin(rhs.sampled_set_misses),
+                   std::begin(result.sampled_set_misses), std::minus<>{});
+  }
   return result;
 }
+
+bool champsim::is_sampled(const cache_stats& stats) { return stats.sampled_sets > 0 && stats.sampled_sets < stats.total_sets; }
+
+auto champsim::estimate_misses(const cache_stats& stats) -> sampled_estimate
+{
+  if (!is_sampled(stats) || std::empty(stats.sampled_set_misses)) {
+    return {static_cast<double>(stats.misses.total()), 0};
+  }
+
+  // The sampled sets are a sample without replacement from the sets of the cache
+  const auto n = static_cast<double>(std::size(stats.sampled_set_misses));
+  const auto N = static_cast<double>(stats.total_sets);
+  const auto mean = std::accumulate(std::begin(stats.sampled_set_misses), std::end(stats.sampled_set_misses), 0.0) / n;
+  const auto sum_squares = std::accumulate(std::begin(stats.sampled_set_misses), std::end(stats.sampled_set_misses), 0.0,
+                                           [mean](double acc, uint64_t x) { return acc + (static_cast<double>(x) - mean) * (static_cast<double>(x) - mean); });
+  const auto variance = (n > 1) ? sum_squares / (n - 1) : 0.0;
+  const auto standard_error = N * std::sqrt(variance / n * (1 - n / N));
+
+  constexpr double z_95 = 1.96;
+  return {N * mean, z_95 * standard_error};
+}
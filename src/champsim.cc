@@ -23,11 +23,18 @@
 #include <fmt/chrono.h>
 #include <fmt/core.h>
 
+#include "clock_schedule.h"
+#include "dvfs.h"
 #include "environment.h"
 #include "ooo_cpu.h"
 #include "operable.h"
+#include "os_scheduler.h"
 #include "phase_info.h"
+#include "ptw.h"
+#include "startup.h"
+#include "sync_manager.h"
 #include "tracereader.h"
+#include "vmem.h"
 
 constexpr int DEADLOCK_CYCLE{500};
 
@@ -37,30 +44,39 @@ std::chrono::seconds elapsed_time() { return std::chrono::duration_cast<std::chr
 
 namespace champsim
 {
-long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<std::size_t> trace_index, champsim::chrono::clock& global_clock)
+long do_cycle(clock_schedule& schedule, const std::vector<std::reference_wrapper<O3_CPU>>& cpus, std::vector<tracereader>& traces,
+              const std::vector<std::size_t>& trace_index, sync_manager& sync, os_scheduler& scheduler, champsim::chrono::clock& global_clock)
 {
-  auto operables = env.operable_view();
-  std::sort(std::begin(operables), std::end(operables),
-            [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
-
   // Operate
-  long progress{0};
-  for (champsim::operable& op : operables) {
-    progress += op.operate_on(global_clock);
+  long progress = schedule.operate_on(global_clock);
+
+  if (scheduler.enabled()) {
+    progress += scheduler.migrate(cpus);
   }
 
-  // Read from trace
-  for (O3_CPU& cpu : env.cpu_view()) {
-    auto& trace = traces.at(trace_index.at(cpu.cpu));
-    for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); !trace.eof() && pkt_count > 0; --pkt_count) {
-      cpu.input_queue.push_back(trace());
+  // Read from trace, unless the trace waits on a lock or barrier
+  for (O3_CPU& cpu : cpus) {
+    if (scheduler.enabled()) {
+      progress += scheduler.operate(cpu);
+    }
+
+    const auto thread = scheduler.enabled() ? scheduler.trace_on(cpu.cpu) : trace_index.at(cpu.cpu);
+    auto& trace = traces.at(thread);
+    const auto events_before = sync.events_passed(thread);
+    for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue));
+         scheduler.has_instruction(thread, trace) && pkt_count > 0 && sync.may_read(thread); --pkt_count) {
+      cpu.input_queue.push_back(scheduler.next_instruction(cpu.cpu, thread, trace));
+      sync.advance(thread);
     }
+    cpu.waiting_for_sync = sync.waiting_on(thread);
+    cpu.sim_stats.sync_events += sync.events_passed(thread) - events_before;
   }
 
   return progress;
 }
 
-phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock)
+phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, sync_manager& sync, os_scheduler& scheduler,
+                     dvfs_controller& dvfs, champsim::chrono::clock& global_clock)
 {
   auto operables = env.operable_view();
   auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
@@ -70,9 +86,19 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
     op.warmup = is_warmup;
     op.begin_phase();
   }
+  if (scheduler.enabled()) {
+    scheduler.begin_phase(env.cpu_view(), env.cache_view());
+  }
+  dvfs.begin_phase(global_clock.now());
+  const auto phase_begin = global_clock.now();
 
-  const auto time_quantum = std::accumulate(std::cbegin(operables), std::cend(operables), champsim::chrono::clock::duration::max(),
-                                            [](const auto acc, const operable& y) { return std::min(acc, y.clock_period); });
+  auto shortest_period = [&operables]() {
+    return std::accumulate(std::cbegin(operables), std::cend(operables), champsim::chrono::clock::duration::max(),
+                           [](const auto acc, const operable& y) { return std::min(acc, y.clock_period); });
+  };
+  auto time_quantum = shortest_period();
+  clock_schedule schedule{operables, time_quantum};
+  const auto cpus = env.cpu_view();
 
   bool livelock_trigger{false};
   uint64_t livelock_period{100000};
@@ -88,7 +114,13 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
     auto next_phase_complete = phase_complete;
     global_clock.tick(time_quantum);
 
-    auto progress = do_cycle(env, traces, trace_index, global_clock);
+    // A component whose frequency was raised may now be faster than the clock ticks
+    if (dvfs.operate(global_clock.now()) && shortest_period() != time_quantum) {
+      time_quantum = shortest_period();
+      schedule = clock_schedule{operables, time_quantum};
+    }
+
+    auto progress = do_cycle(schedule, cpus, traces, trace_index, sync, scheduler, global_clock);
 
     if (progress == 0) {
       ++stalled_cycle;
@@ -158,12 +190,12 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
 
   phase_stats stats;
   stats.name = phase.name;
+  stats.elapsed = global_clock.now() - phase_begin;
 
   for (std::size_t i = 0; i < std::size(trace_index); ++i) {
     stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
   }
 
-  auto cpus = env.cpu_view();
   std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu) { return cpu.sim_stats; });
   std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu) { return cpu.roi_stats; });
 
@@ -171,26 +203,53 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
   std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
 
-  auto dram = env.dram_view();
+  const auto& dram = env.dram_view();
   std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
                  [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
   std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
                  [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
 
+  for (const O3_CPU& cpu : cpus) {
+    auto type = std::find_if(std::begin(stats.sim_core_type_stats), std::end(stats.sim_core_type_stats),
+                             [&cpu](const auto& x) { return x.name == cpu.CORE_TYPE; });
+    if (type == std::end(stats.sim_core_type_stats)) {
+      type = stats.sim_core_type_stats.insert(type, core_type_stats{cpu.CORE_TYPE});
+    }
+    type->instrs += cpu.sim_stats.instrs();
+    type->cycles += cpu.sim_stats.cycles();
+  }
+  if (std::size(stats.sim_core_type_stats) < 2) {
+    stats.sim_core_type_stats.clear();
+  }
+
+  if (scheduler.enabled()) {
+    stats.sim_trace_stats = scheduler.end_phase(cpus);
+    for (std::size_t i = 0; i < std::size(stats.sim_trace_stats); ++i) {
+      stats.sim_trace_stats.at(i).name = trace_names.at(i);
+    }
+  }
+  if (dvfs.enabled()) {
+    stats.sim_dvfs_stats = dvfs.end_phase(global_clock.now());
+  }
+
   return stats;
 }
 
-// simulation entry point
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+// simulation entry point, for an environment whose components have been initialized
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, sync_manager& sync,
+                              os_scheduler& scheduler, dvfs_controller& dvfs)
 {
-  for (champsim::operable& op : env.operable_view()) {
-    op.initialize();
+  if (scheduler.enabled()) {
+    // Traces move between cores, so their translations follow the address space tag rather than the core
+    for (PageTableWalker& ptw : env.ptw_view()) {
+      ptw.vmem->tag_address_spaces(os_scheduler::address_space_shift);
+    }
   }
 
   champsim::chrono::clock global_clock;
   std::vector<phase_stats> results;
   for (auto phase : phases) {
-    auto stats = do_phase(phase, env, traces, global_clock);
+    auto stats = do_phase(phase, env, traces, sync, scheduler, dvfs, global_clock);
     if (!phase.is_warmup) {
       results.push_back(stats);
     }
@@ -198,4 +257,16 @@ std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases,
 
   return results;
 }
+
+// simulation entry point, for traces that neither synchronize with each other nor share cores, at fixed frequencies
+// The components of the environment are initialized here, one at a time
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+{
+  champsim::initialize(env, 1);
+
+  sync_manager sync{};
+  os_scheduler scheduler{};
+  dvfs_controller dvfs{};
+  return main(env, phases, traces, sync, scheduler, dvfs);
+}
 } // namespace champsim
\ No newline at end of file
@@ -115,7 +115,7 @@ void champsim::channel::check_collision()
 }
 
 template <typename R>
-bool champsim::channel::do_add_queue(R& queue, std::size_t queue_size, const typename R::value_type& packet)
+bool champsim::channel::do_add_queue(R& queue, std::size_t queue_size, typename R::value_type packet)
 {
   // check occupancy
   if (std::size(queue) >= queue_size) {
@@ -123,14 +123,13 @@ bool champsim::channel::do_add_queue(R& queue, std::size_t queue_size, const typ
   }
 
   // Insert the packet ahead of the translation misses
-  auto fwd_pkt = packet;
-  fwd_pkt.forward_checked = false;
-  queue.push_back(fwd_pkt);
+  packet.forward_checked = false;
+  queue.push_back(std::move(packet));
 
   return true;
 }
 
-bool champsim::channel::add_rq(const request_type& packet)
+bool champsim::channel::add_rq(request_type packet)
 {
   if constexpr (champsim::debug_print) {
     fmt::print("[channel_rq] {} instr_id: {} address: {} v_address: {} type: {}\n", __func__, packet.instr_id, packet.address, packet.v_address,
@@ -139,7 +138,7 @@ bool champsim::channel::add_rq(const request_type& packet)
 
   sim_stats.RQ_ACCESS++;
 
-  auto result = do_add_queue(RQ, RQ_SIZE, packet);
+  auto result = do_add_queue(RQ, RQ_SIZE, std::move(packet));
 
   if (result) {
     sim_stats.RQ_TO_CACHE++;
@@ -150,7 +149,7 @@ bool champsim::channel::add_rq(const request_type& packet)
   return result;
 }
 
-bool champsim::channel::add_wq(const request_type& packet)
+bool champsim::channel::add_wq(request_type packet)
 {
   if constexpr (champsim::debug_print) {
     fmt::print("[channel_wq] {} instr_id: {} address: {} v_address: {} type: {}\n", __func__, packet.instr_id, packet.address, packet.v_address,
@@ -159,7 +158,7 @@ bool champsim::channel::add_wq(const request_type& packet)
 
   sim_stats.WQ_ACCESS++;
 
-  auto result = do_add_queue(WQ, WQ_SIZE, packet);
+  auto result = do_add_queue(WQ, WQ_SIZE, std::move(packet));
 
   if (result) {
     sim_stats.WQ_TO_CACHE++;
@@ -170,7 +169,7 @@ bool champsim::channel::add_wq(const request_type& packet)
   return result;
 }
 
-bool champsim::channel::add_pq(const request_type& packet)
+bool champsim::channel::add_pq(request_type packet)
 {
   if constexpr (champsim::debug_print) {
     fmt::print("[channel_pq] {} instr_id: {} address: {} v_address: {} type: {}\n", __func__, packet.instr_id, packet.address, packet.v_address,
@@ -179,8 +178,7 @@ bool champsim::channel::add_pq(const request_type& packet)
 
   sim_stats.PQ_ACCESS++;
 
-  auto fwd_pkt = packet;
-  auto result = do_add_queue(PQ, PQ_SIZE, fwd_pkt);
+  auto result = do_add_queue(PQ, PQ_SIZE, std::move(packet));
   if (result) {
     sim_stats.PQ_TO_CACHE++;
   } else {
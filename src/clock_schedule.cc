@@ -0,0 +1,107 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "clock_schedule.h"
+
+#include <algorithm>
+#include <numeric>
+
+champsim::clock_schedule::clock_schedule(std::vector<std::reference_wrapper<operable>> operables, champsim::chrono::clock::duration quantum)
+    : m_operables(std::move(operables)), m_sorted(m_operables), m_quantum(quantum)
+{
+}
+
+bool champsim::clock_schedule::periods_changed() const
+{
+  return !std::equal(std::cbegin(m_operables), std::cend(m_operables), std::cbegin(m_periods), std::cend(m_periods),
+                     [](const operable& op, const auto& period) { return op.clock_period == period; });
+}
+
+bool champsim::clock_schedule::record(champsim::chrono::clock::time_point now)
+{
+  m_periods.clear();
+  std::transform(std::cbegin(m_operables), std::cend(m_operables), std::back_inserter(m_periods), [](const operable& op) { return op.clock_period; });
+  m_order.clear();
+  m_tick_begin.clear();
+
+  // The pattern repeats after the least common multiple of the periods, once every component has caught up to the clock
+  auto pattern_length = std::accumulate(std::cbegin(m_periods), std::cend(m_periods), m_quantum.count(),
+                                        [](auto acc, const auto& period) { return (acc == 0 || period.count() <= 0) ? 0 : std::lcm(acc, period.count()); });
+  auto caught_up = std::all_of(std::cbegin(m_operables), std::cend(m_operables), [now, quantum = m_quantum](const operable& op) {
+    return op.current_time >= now - quantum && op.current_time < now - quantum + op.clock_period;
+  });
+  if (!caught_up || pattern_length <= 0 || pattern_length / m_quantum.count() > static_cast<long long>(max_ticks)) {
+    return false;
+  }
+
+  std::vector<champsim::chrono::clock::time_point> times;
+  std::transform(std::cbegin(m_operables), std::cend(m_operables), std::back_inserter(times), [](const operable& op) { return op.current_time; });
+  std::vector<uint32_t> order(std::size(m_operables));
+  for (auto tick_now = now; tick_now < now + champsim::chrono::picoseconds{pattern_length}; tick_now += m_quantum) {
+    m_tick_begin.push_back(std::size(m_order));
+
+    // Sorting the indices compares the same times as sorting the components would, so ties are ordered the same way
+    std::iota(std::begin(order), std::end(order), 0);
+    std::sort(std::begin(order), std::end(order), [&times](auto lhs, auto rhs) { return times[lhs] < times[rhs]; });
+    for (auto idx : order) {
+      if (times[idx] < tick_now) {
+        m_order.push_back(idx);
+      }
+      while (times[idx] < tick_now) {
+        times[idx] += m_periods[idx];
+      }
+    }
+  }
+  m_tick_begin.push_back(std::size(m_order));
+
+  m_tick = 0;
+  return true;
+}
+
+long champsim::clock_schedule::operate_sorted(const champsim::chrono::clock& clock)
+{
+  std::copy(std::cbegin(m_operables), std::cend(m_operables), std::begin(m_sorted));
+  std::sort(std::begin(m_sorted), std::end(m_sorted),
+                   [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
+
+  long progress{0};
+  for (champsim::operable& op : m_sorted) {
+    progress += op.operate_on(clock);
+  }
+  return progress;
+}
+
+long champsim::clock_schedule::operate_on(const champsim::chrono::clock& clock)
+{
+  if (!m_precomputed || clock.now() != m_expected_now || periods_changed()) {
+    m_precomputed = record(clock.now());
+  }
+  m_expected_now = clock.now() + m_quantum;
+
+  if (!m_precomputed) {
+    return operate_sorted(clock);
+  }
+
+  long progress{0};
+  auto first = std::next(std::cbegin(m_order), static_cast<long>(m_tick_begin[m_tick]));
+  auto last = std::next(std::cbegin(m_order), static_cast<long>(m_tick_begin[m_tick + 1]));
+  for (auto idx = first; idx != last; ++idx) {
+    progress += m_operables[*idx].get().operate_on(clock);
+  }
+
+  m_tick = (m_tick + 1) % (std::size(m_tick_begin) - 1);
+  return progress;
+}
@@ -0,0 +1,244 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "columnar_trace.h"
+
+#include <iterator>
+#include <map>
+#include <utility>
+
+namespace
+{
+constexpr std::size_t num_register_operands = NUM_INSTR_DESTINATIONS + NUM_INSTR_SOURCES;
+constexpr std::size_t num_memory_streams = NUM_INSTR_DESTINATIONS + NUM_INSTR_SOURCES;
+using register_tuple = std::array<unsigned char, num_register_operands>;
+
+uint64_t zigzag_encode(uint64_t delta) { return (delta << 1) ^ (0 - (delta >> 63)); }
+uint64_t zigzag_decode(uint64_t value) { return (value >> 1) ^ (0 - (value & 1)); }
+
+void put_varint(uint64_t value, std::vector<char>& out)
+{
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+template <typename T>
+void put_raw(T value, std::vector<char>& out)
+{
+  std::array<char, sizeof(T)> bytes{};
+  std::memcpy(std::data(bytes), &value, sizeof(T));
+  out.insert(std::end(out), std::begin(bytes), std::end(bytes));
+}
+
+template <typename Pred>
+void put_bitmap(const input_instr* begin, const input_instr* end, Pred&& pred, std::vector<char>& out)
+{
+  auto num_bytes = (static_cast<std::size_t>(std::distance(begin, end)) + 7) / 8;
+  auto offset = std::size(out);
+  out.resize(offset + num_bytes, 0);
+  for (std::size_t i = 0; begin != end; ++begin, ++i) {
+    if (pred(*begin)) {
+      out[offset + i / 8] = static_cast<char>(out[offset + i / 8] | (1 << (i % 8)));
+    }
+  }
+}
+
+register_tuple get_registers(const input_instr& instr)
+{
+  register_tuple retval{};
+  auto it = std::copy(std::begin(instr.destination_registers), std::end(instr.destination_registers), std::begin(retval));
+  std::copy(std::begin(instr.source_registers), std::end(instr.source_registers), it);
+  return retval;
+}
+
+unsigned long long& memory_operand(input_instr& instr, std::size_t stream)
+{
+  if (stream < NUM_INSTR_DESTINATIONS) {
+    return instr.destination_memory[stream];
+  }
+  return instr.source_memory[stream - NUM_INSTR_DESTINATIONS];
+}
+
+unsigned long long memory_operand(const input_instr& instr, std::size_t stream)
+{
+  if (stream < NUM_INSTR_DESTINATIONS) {
+    return instr.destination_memory[stream];
+  }
+  return instr.source_memory[stream - NUM_INSTR_DESTINATIONS];
+}
+
+class payload_reader
+{
+  const char* pos;
+  const char* end;
+
+public:
+  payload_reader(const char* b, const char* e) : pos(b), end(e) {}
+
+  uint64_t get_varint()
+  {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      if (pos == end) {
+        throw std::invalid_argument{"Columnar trace block is truncated"};
+      }
+      auto byte = static_cast<unsigned char>(*pos++);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw std::invalid_argument{"Columnar trace block has an invalid integer"};
+  }
+
+  const char* get_bytes(std::size_t count)
+  {
+    if (static_cast<std::size_t>(std::distance(pos, end)) < count) {
+      throw std::invalid_argument{"Columnar trace block is truncated"};
+    }
+    return std::exchange(pos, std::next(pos, static_cast<long>(count)));
+  }
+};
+
+bool test_bit(const char* bitmap, std::size_t i) { return (static_cast<unsigned char>(bitmap[i / 8]) >> (i % 8)) & 1; }
+} // namespace
+
+auto champsim::columnar::file_header() -> std::array<char, file_header_size>
+{
+  std::array<char, file_header_size> retval{};
+  auto it = std::copy(std::begin(file_magic), std::end(file_magic), std::begin(retval));
+  *it = static_cast<char>(format_version);
+  return retval;
+}
+
+void champsim::columnar::check_file_header(const std::array<char, file_header_size>& header)
+{
+  if (!std::equal(std::begin(file_magic), std::end(file_magic), std::begin(header))) {
+    throw std::invalid_argument{"Trace is not in the columnar format"};
+  }
+  if (static_cast<uint8_t>(header[std::size(file_magic)]) != format_version) {
+    throw std::invalid_argument{"Unsupported columnar trace version"};
+  }
+}
+
+void champsim::columnar::encode_block(const input_instr* begin, const input_instr* end, std::vector<char>& out)
+{
+  auto num_instrs = static_cast<uint32_t>(std::distance(begin, end));
+  put_raw(num_instrs, out);
+  auto payload_size_offset = std::size(out);
+  put_raw(uint32_t{0}, out);
+  auto payload_offset = std::size(out);
+
+  // Instruction pointers
+  uint64_t prev_ip = 0;
+  std::for_each(begin, end, [&](const input_instr& instr) {
+    put_varint(::zigzag_encode(instr.ip - prev_ip), out);
+    prev_ip = instr.ip;
+  });
+
+  // Branch flags
+  put_bitmap(begin, end, [](const input_instr& instr) { return instr.is_branch != 0; }, out);
+  put_bitmap(begin, end, [](const input_instr& instr) { return instr.branch_taken != 0; }, out);
+
+  // Registers
+  std::map<::register_tuple, uint64_t> dictionary;
+  std::vector<::register_tuple> dictionary_order;
+  std::vector<uint64_t> register_indices;
+  std::transform(begin, end, std::back_inserter(register_indices), [&](const input_instr& instr) {
+    auto [it, inserted] = dictionary.try_emplace(::get_registers(instr), std::size(dictionary));
+    if (inserted) {
+      dictionary_order.push_back(it->first);
+    }
+    return it->second;
+  });
+  put_varint(std::size(dictionary_order), out);
+  for (const auto& entry : dictionary_order) {
+    out.insert(std::end(out), std::begin(entry), std::end(entry));
+  }
+  for (auto idx : register_indices) {
+    put_varint(idx, out);
+  }
+
+  // Memory operands
+  for (std::size_t stream = 0; stream < ::num_memory_streams; ++stream) {
+    put_bitmap(begin, end, [stream](const input_instr& instr) { return ::memory_operand(instr, stream) != 0; }, out);
+    uint64_t prev_addr = 0;
+    std::for_each(begin, end, [&](const input_instr& instr) {
+      if (auto addr = ::memory_operand(instr, stream); addr != 0) {
+        put_varint(::zigzag_encode(addr - prev_addr), out);
+        prev_addr = addr;
+      }
+    });
+  }
+
+  auto payload_size = static_cast<uint32_t>(std::size(out) - payload_offset);
+  std::memcpy(std::next(std::data(out), static_cast<long>(payload_size_offset)), &payload_size, sizeof(payload_size));
+}
+
+void champsim::columnar::decode_block(const char* begin, const char* end, std::size_t num_instrs, std::vector<input_instr>& out)
+{
+  ::payload_reader reader{begin, end};
+  auto first = std::size(out);
+  out.resize(first + num_instrs, input_instr{});
+  auto block = std::next(std::begin(out), static_cast<long>(first));
+
+  // Instruction pointers
+  uint64_t prev_ip = 0;
+  std::for_each(block, std::end(out), [&](input_instr& instr) {
+    prev_ip += ::zigzag_decode(reader.get_varint());
+    instr.ip = prev_ip;
+  });
+
+  // Branch flags
+  auto bitmap_size = (num_instrs + 7) / 8;
+  auto is_branch = reader.get_bytes(bitmap_size);
+  auto branch_taken = reader.get_bytes(bitmap_size);
+  for (std::size_t i = 0; i < num_instrs; ++i) {
+    block[static_cast<long>(i)].is_branch = ::test_bit(is_branch, i);
+    block[static_cast<long>(i)].branch_taken = ::test_bit(branch_taken, i);
+  }
+
+  // Registers
+  std::vector<::register_tuple> dictionary(reader.get_varint());
+  for (auto& entry : dictionary) {
+    auto bytes = reader.get_bytes(std::size(entry));
+    std::copy_n(bytes, std::size(entry), std::begin(entry));
+  }
+  std::for_each(block, std::end(out), [&](input_instr& instr) {
+    auto idx = reader.get_varint();
+    if (idx >= std::size(dictionary)) {
+      throw std::invalid_argument{"Columnar trace block has an invalid register index"};
+    }
+    const auto& entry = dictionary[idx];
+    std::copy_n(std::begin(entry), NUM_INSTR_DESTINATIONS, std::begin(instr.destination_registers));
+    std::copy_n(std::next(std::begin(entry), NUM_INSTR_DESTINATIONS), NUM_INSTR_SOURCES, std::begin(instr.source_registers));
+  });
+
+  // Memory operands
+  for (std::size_t stream = 0; stream < ::num_memory_streams; ++stream) {
+    auto present = reader.get_bytes(bitmap_size);
+    uint64_t prev_addr = 0;
+    for (std::size_t i = 0; i < num_instrs; ++i) {
+      if (::test_bit(present, i)) {
+        prev_addr += ::zigzag_decode(reader.get_varint());
+        ::memory_operand(block[static_cast<long>(i)], stream) = prev_addr;
+      }
+    }
+  }
+}
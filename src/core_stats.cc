@@ -7,6 +7,9 @@ cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
   lhs.end_instrs -= rhs.end_instrs;
   lhs.end_cycles -= rhs.end_cycles;
   lhs.total_rob_occupancy_at_branch_mispredict -= rhs.total_rob_occupancy_at_branch_mispredict;
+  lhs.lock_wait_cycles -= rhs.lock_wait_cycles;
+  lhs.barrier_wait_cycles -= rhs.barrier_wait_cycles;
+  lhs.sync_events -= rhs.sync_events;
 
   lhs.total_branch_types -= rhs.total_branch_types;
   lhs.branch_type_misses -= rhs.branch_type_misses;
@@ -19,10 +19,13 @@
 #include <algorithm>
 #include <cfenv>
 #include <cmath>
+#include <numeric>
+#include <stdexcept>
 #include <fmt/core.h>
 
 #include "deadlock.h"
 #include "instruction.h"
+#include "replay_log.h"
 #include "util/bits.h" // for lg2, bitmask
 #include "util/span.h"
 #include "util/units.h"
@@ -93,27 +96,40 @@ auto DRAM_ADDRESS_MAPPING::make_slicer(champsim::data::bytes channel_width, std:
 
 long MEMORY_CONTROLLER::operate()
 {
-  long progress{0};
-
   initiate_requests();
 
+  // The channels share nothing until their responses are returned, so they may operate concurrently
+  channel_progress.resize(std::size(channels));
+  workers->for_each_index(std::size(channels), [this](std::size_t idx) {
+    auto& channel = channels[idx];
+    channel.advance_cycle();
+    channel_progress[idx] = channel.operate();
+  });
+
+  // Responses and replay records are passed on in channel order, so that they do not depend on the number of threads
   for (auto& channel : channels) {
-    progress += channel._operate();
+    for (auto& [queue, response] : channel.finished) {
+      queue->push_back(std::move(response));
+    }
+    channel.finished.clear();
+
+    channel.finish_cycle();
   }
 
-  return progress;
+  return std::accumulate(std::begin(channel_progress), std::end(channel_progress), long{0});
 }
 
 long DRAM_CHANNEL::operate()
 {
   long progress{0};
+  sim_stats.elapsed += clock_period;
 
   if (warmup) {
     for (auto& entry : RQ) {
       if (entry.has_value()) {
         response_type response{entry->address, entry->v_address, entry->data, entry->pf_metadata, entry->instr_depend_on_me};
         for (auto* ret : entry.value().to_return) {
-          ret->push_back(response);
+          finished.emplace_back(ret, response);
         }
 
         ++progress;
@@ -145,10 +161,15 @@ long DRAM_CHANNEL::finish_dbus_request()
   long progress{0};
 
   if (active_request != std::end(bank_request) && active_request->ready_time <= current_time) {
+    if (active_request->pkt->value().cpu < NUM_CPUS) {
+      core_stats(sim_stats, active_request->pkt->value().cpu).queue_cycles +=
+          static_cast<uint64_t>((current_time - active_request->pkt->value().enqueue_time) / clock_period);
+    }
+
     response_type response{active_request->pkt->value().address, active_request->pkt->value().v_address, active_request->pkt->value().data,
                            active_request->pkt->value().pf_metadata, active_request->pkt->value().instr_depend_on_me};
     for (auto* ret : active_request->pkt->value().to_return) {
-      ret->push_back(response);
+      finished.emplace_back(ret, response);
     }
 
     active_request->valid = false;
@@ -270,6 +291,11 @@ long DRAM_CHANNEL::populate_dbus()
       // set when bankgroup dbus will be next ready
       bankgroup_readytime[op_bankgroup] = current_time + DRAM_DBUS_RETURN_TIME + DRAM_DBUS_BANKGROUP_STALL;
 
+      if (replay_chain != nullptr) {
+        replay_chain->add(champsim::replay::event::dram_issue, active_request->pkt->value().address.to<uint64_t>());
+        replay_chain->add(champsim::replay::event::dram_issue, static_cast<uint64_t>(write_mode));
+      }
+
       if (iter_next_process->row_buffer_hit) {
         if (write_mode) {
           ++sim_stats.WQ_ROW_BUFFER_HIT;
@@ -455,7 +481,7 @@ void DRAM_CHANNEL::check_read_collision()
         response_type response{rq_it->value().address, rq_it->value().v_address, wq_it->value().data, rq_it->value().pf_metadata,
                                rq_it->value().instr_depend_on_me};
         for (auto* ret : rq_it->value().to_return) {
-          ret->push_back(response);
+          finished.emplace_back(ret, response);
         }
 
         rq_it->reset();
@@ -492,39 +518,116 @@ void DRAM_CHANNEL::check_read_collision()
   }
 }
 
+template <typename Q, typename F>
+void MEMORY_CONTROLLER::admit(Q& queue, F&& add)
+{
+  if (std::empty(throttles)) {
+    // Packets are moved from only if they are accepted, and accepted packets are removed from the queue
+    auto [begin, end] = champsim::get_span_p(std::begin(queue), std::end(queue), std::forward<F>(add));
+    queue.erase(begin, end);
+    return;
+  }
+
+  // Offer the packets of higher-priority cores first, keeping the order of the packets of each core
+  auto priority = [this](uint32_t cpu) { return cpu < std::size(allocations) ? allocations[cpu].priority : 0u; };
+  std::vector<std::size_t> order(std::size(queue));
+  std::iota(std::begin(order), std::end(order), std::size_t{0});
+  std::stable_sort(std::begin(order), std::end(order), [&](auto lhs, auto rhs) { return priority(queue[lhs].cpu) > priority(queue[rhs].cpu); });
+
+  // A throttled packet is passed over, so that it does not hold back the packets of other cores. Admission stops when a channel queue is full.
+  std::vector<bool> admitted(std::size(queue), false);
+  for (auto idx : order) {
+    auto& pkt = queue[idx];
+    const auto cpu = pkt.cpu;
+    if (cpu < std::size(throttles) && !throttles[cpu].may_take(current_time)) {
+      ++core_stats(channels[address_mapping.get_channel(pkt.address)].sim_stats, cpu).throttled_request_cycles;
+      continue;
+    }
+
+    if (!add(pkt)) {
+      break;
+    }
+
+    if (cpu < std::size(throttles)) {
+      throttles[cpu].take(current_time);
+    }
+    admitted[idx] = true;
+  }
+
+  std::size_t kept = 0;
+  for (std::size_t idx = 0; idx < std::size(queue); ++idx) {
+    if (!admitted[idx]) {
+      if (kept != idx) {
+        queue[kept] = std::move(queue[idx]);
+      }
+      ++kept;
+    }
+  }
+  queue.erase(std::next(std::begin(queue), static_cast<long>(kept)), std::end(queue));
+}
+
 void MEMORY_CONTROLLER::initiate_requests()
 {
   // Initiate read requests
   for (auto* ul : queues) {
     for (auto q : {std::ref(ul->RQ), std::ref(ul->PQ)}) {
-      auto [begin, end] = champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), [ul, this](const auto& pkt) { return this->add_rq(pkt, ul); });
-      q.get().erase(begin, end);
+      admit(q.get(), [ul, this](auto& pkt) { return this->add_rq(std::move(pkt), ul); });
     }
 
     // Initiate write requests
-    auto [wq_begin, wq_end] = champsim::get_span_p(std::cbegin(ul->WQ), std::cend(ul->WQ), [this](const auto& pkt) { return this->add_wq(pkt); });
-    ul->WQ.erase(wq_begin, wq_end);
+    admit(ul->WQ, [this](auto& pkt) { return this->add_wq(std::move(pkt)); });
+  }
+}
+
+void MEMORY_CONTROLLER::set_threads(std::size_t threads) { workers = std::make_unique<champsim::worker_pool>(std::min(threads, std::size(channels))); }
+
+void MEMORY_CONTROLLER::set_allocations(std::vector<core_allocation> allocs)
+{
+  // The peak rate of requests is one per data transfer on each channel
+  const auto transfer_time = channels.front().DRAM_DBUS_RETURN_TIME;
+  const auto num_channels = static_cast<long long>(std::size(channels));
+
+  std::vector<champsim::token_bucket> new_throttles;
+  for (const auto& alloc : allocs) {
+    if (alloc.percent == 0 || alloc.percent > 100) {
+      throw std::invalid_argument{fmt::format("A core may be given between 1 and 100 percent of the memory bandwidth, not {}", alloc.percent)};
+    }
+
+    if (alloc.percent == 100) {
+      new_throttles.emplace_back();
+    } else {
+      new_throttles.emplace_back(transfer_time * 100 / (static_cast<long long>(alloc.percent) * num_channels), allocation_burst);
+    }
   }
+
+  allocations = std::move(allocs);
+  throttles = std::move(new_throttles);
 }
 
-DRAM_CHANNEL::request_type::request_type(const typename champsim::channel::request_type& req)
-    : pf_metadata(req.pf_metadata), address(req.address), v_address(req.address), data(req.data), instr_depend_on_me(req.instr_depend_on_me)
+DRAM_CHANNEL::request_type::request_type(typename champsim::channel::request_type req)
+    : pf_metadata(req.pf_metadata), cpu(req.cpu), address(req.address), v_address(req.address), data(req.data), instr_depend_on_me(std::move(req.instr_depend_on_me))
 {
   asid[0] = req.asid[0];
   asid[1] = req.asid[1];
 }
 
-bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul)
+bool MEMORY_CONTROLLER::add_rq(request_type&& packet, champsim::channel* ul)
 {
   auto& channel = channels[address_mapping.get_channel(packet.address)];
 
   if (auto rq_it = std::find_if_not(std::begin(channel.RQ), std::end(channel.RQ), [this](const auto& pkt) { return pkt.has_value(); });
       rq_it != std::end(channel.RQ)) {
-    *rq_it = DRAM_CHANNEL::request_type{packet};
+    const bool response_requested = packet.response_requested;
+    if (packet.cpu < NUM_CPUS) {
+      ++core_stats(channel.sim_stats, packet.cpu).requests;
+    }
+
+    *rq_it = DRAM_CHANNEL::request_type{std::move(packet)};
     rq_it->value().forward_checked = false;
     rq_it->value().scheduled = false;
     rq_it->value().ready_time = current_time;
-    if (packet.response_requested)
+    rq_it->value().enqueue_time = current_time;
+    if (response_requested)
       rq_it->value().to_return = {&ul->returned};
 
     return true;
@@ -533,17 +636,22 @@ bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul
   return false;
 }
 
-bool MEMORY_CONTROLLER::add_wq(const request_type& packet)
+bool MEMORY_CONTROLLER::add_wq(request_type&& packet)
 {
   auto& channel = channels[address_mapping.get_channel(packet.address)];
 
   // search for the empty index
   if (auto wq_it = std::find_if_not(std::begin(channel.WQ), std::end(channel.WQ), [](const auto& pkt) { return pkt.has_value(); });
       wq_it != std::end(channel.WQ)) {
-    *wq_it = DRAM_CHANNEL::request_type{packet};
+    if (packet.cpu < NUM_CPUS) {
+      ++core_stats(channel.sim_stats, packet.cpu).requests;
+    }
+
+    *wq_it = DRAM_CHANNEL::request_type{std::move(packet)};
     wq_it->value().forward_checked = false;
     wq_it->value().scheduled = false;
     wq_it->value().ready_time = current_time;
+    wq_it->value().enqueue_time = current_time;
 
     return true;
   }
@@ -9,5 +9,21 @@ dram_stats operator-(dram_stats lhs, dram_stats rhs)
   lhs.RQ_ROW_BUFFER_HIT -= rhs.RQ_ROW_BUFFER_HIT;
   lhs.RQ_ROW_BUFFER_MISS -= rhs.RQ_ROW_BUFFER_MISS;
   lhs.WQ_FULL -= rhs.WQ_FULL;
+  lhs.elapsed -= rhs.elapsed;
+
+  for (std::size_t cpu = 0; cpu < std::size(rhs.cores); ++cpu) {
+    auto& core = core_stats(lhs, cpu);
+    core.requests -= rhs.cores[cpu].requests;
+    core.throttled_request_cycles -= rhs.cores[cpu].throttled_request_cycles;
+    core.queue_cycles -= rhs.cores[cpu].queue_cycles;
+  }
   return lhs;
 }
+
+dram_core_stats& core_stats(dram_stats& stats, std::size_t cpu)
+{
+  if (cpu >= std::size(stats.cores)) {
+    stats.cores.resize(cpu + 1);
+  }
+  return stats.cores[cpu];
+}
@@ -0,0 +1,222 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "dvfs.h"
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#include "util/to_underlying.h"
+
+champsim::dvfs_controller::dvfs_controller(environment& env, std::vector<dvfs_event> schedule, std::optional<dvfs_governor_options> governor)
+    : m_schedule(std::move(schedule)), m_governor(std::move(governor))
+{
+  std::stable_sort(std::begin(m_schedule), std::end(m_schedule), [](const auto& lhs, const auto& rhs) { return lhs.time < rhs.time; });
+  for (const auto& event : m_schedule) {
+    if (event.frequency <= 0) {
+      throw std::invalid_argument{fmt::format("Frequency of domain {} must be positive, but is {} MHz", event.domain, event.frequency)};
+    }
+    m_event_domains.push_back(find_domain(env, event.domain));
+  }
+
+  if (m_governor.has_value()) {
+    auto& levels = m_governor->levels;
+    if (std::empty(levels) || std::any_of(std::begin(levels), std::end(levels), [](auto level) { return level <= 0; })) {
+      throw std::invalid_argument{"The DVFS governor requires at least one frequency level, and every level must be positive"};
+    }
+    if (m_governor->interval <= 0) {
+      throw std::invalid_argument{fmt::format("The DVFS governor interval must be positive, but is {} cycles", m_governor->interval)};
+    }
+    if (m_governor->down_threshold > m_governor->up_threshold) {
+      throw std::invalid_argument{fmt::format("The DVFS governor lowers frequencies below a utilization of {}, which is above the threshold {} to raise them",
+                                              m_governor->down_threshold, m_governor->up_threshold)};
+    }
+    std::sort(std::begin(levels), std::end(levels));
+    levels.erase(std::unique(std::begin(levels), std::end(levels)), std::end(levels));
+
+    for (O3_CPU& cpu : env.cpu_view()) {
+      auto& domain = m_domains.at(find_domain(env, fmt::format("cpu{0},cpu{0}_*", cpu.cpu)));
+      domain.core = &cpu;
+
+      // Begin at the level nearest the configured frequency
+      auto nearest = std::min_element(std::begin(levels), std::end(levels),
+                                      [freq = domain.frequency](auto lhs, auto rhs) { return std::abs(lhs - freq) < std::abs(rhs - freq); });
+      domain.level = static_cast<std::size_t>(std::distance(std::begin(levels), nearest));
+    }
+  }
+}
+
+std::size_t champsim::dvfs_controller::find_domain(environment& env, const std::string& name)
+{
+  auto found = std::find_if(std::begin(m_domains), std::end(m_domains), [&name](const auto& domain) { return domain.stats.name == name; });
+  if (found != std::end(m_domains)) {
+    return static_cast<std::size_t>(std::distance(std::begin(m_domains), found));
+  }
+
+  domain_state domain;
+  domain.stats.name = name;
+  std::istringstream patterns{name};
+  for (std::string pattern; std::getline(patterns, pattern, ',');) {
+    domain.patterns.push_back(pattern);
+  }
+
+  auto matches = [&domain](const std::string& component) {
+    return std::any_of(std::begin(domain.patterns), std::end(domain.patterns), [&component](const auto& pattern) {
+      if (!std::empty(pattern) && pattern.back() == '*') {
+        return component.compare(0, std::size(pattern) - 1, pattern, 0, std::size(pattern) - 1) == 0;
+      }
+      return component == pattern;
+    });
+  };
+
+  if (matches("DRAM")) {
+    throw std::invalid_argument{fmt::format("DVFS domain {} includes the DRAM, whose timings are fixed", name)};
+  }
+  for (O3_CPU& cpu : env.cpu_view()) {
+    if (matches(fmt::format("cpu{}", cpu.cpu))) {
+      domain.members.emplace_back(cpu);
+    }
+  }
+  for (CACHE& cache : env.cache_view()) {
+    if (matches(cache.NAME)) {
+      domain.members.emplace_back(cache);
+    }
+  }
+  for (PageTableWalker& ptw : env.ptw_view()) {
+    if (matches(ptw.NAME)) {
+      domain.members.emplace_back(ptw);
+    }
+  }
+
+  if (std::empty(domain.members)) {
+    throw std::invalid_argument{fmt::format("DVFS domain {} matches no component", name)};
+  }
+  for (const auto& other : m_domains) {
+    for (const operable& member : domain.members) {
+      if (std::any_of(std::begin(other.members), std::end(other.members), [&member](const operable& x) { return &x == &member; })) {
+        throw std::invalid_argument{fmt::format("DVFS domains {} and {} share a component", other.stats.name, name)};
+      }
+    }
+  }
+
+  domain.frequency = std::lround(1000000.0 / static_cast<double>(domain.members.front().get().clock_period.count()));
+  m_domains.push_back(std::move(domain));
+  return std::size(m_domains) - 1;
+}
+
+bool champsim::dvfs_controller::set_frequency(domain_state& domain, long frequency, champsim::chrono::clock::time_point now)
+{
+  if (frequency == domain.frequency) {
+    return false;
+  }
+
+  domain.stats.residency[domain.frequency] += now - domain.since;
+  ++domain.stats.transitions;
+  domain.since = now;
+  domain.frequency = frequency;
+  for (operable& member : domain.members) {
+    member.set_clock_period(period_of_frequency(frequency));
+  }
+  return true;
+}
+
+bool champsim::dvfs_controller::govern(domain_state& domain, champsim::chrono::clock::time_point now)
+{
+  if (domain.core == nullptr || now < domain.next_decision) {
+    return false;
+  }
+
+  const O3_CPU& core = *domain.core;
+  const auto& levels = m_governor->levels;
+  bool changed = false;
+  auto cycles = core.cycle_count() - domain.decision_cycles;
+  if (cycles > 0) {
+    auto utilization = static_cast<double>(core.num_retired - domain.decision_instrs)
+                       / (static_cast<double>(cycles) * static_cast<double>(champsim::to_underlying(core.RETIRE_WIDTH)));
+    if (utilization > m_governor->up_threshold && domain.level + 1 < std::size(levels)) {
+      ++domain.level;
+    } else if (utilization < m_governor->down_threshold && domain.level > 0) {
+      --domain.level;
+    }
+    changed = set_frequency(domain, levels.at(domain.level), now);
+  }
+
+  domain.decision_cycles = core.cycle_count();
+  domain.decision_instrs = core.num_retired;
+  domain.next_decision = now + m_governor->interval * core.clock_period;
+  return changed;
+}
+
+void champsim::dvfs_controller::begin_phase(champsim::chrono::clock::time_point now)
+{
+  for (auto& domain : m_domains) {
+    domain.stats.residency.clear();
+    domain.stats.transitions = 0;
+    domain.since = now;
+  }
+}
+
+bool champsim::dvfs_controller::operate(champsim::chrono::clock::time_point now)
+{
+  bool changed = false;
+  for (; m_next_event < std::size(m_schedule) && m_schedule.at(m_next_event).time <= now; ++m_next_event) {
+    changed = set_frequency(m_domains.at(m_event_domains.at(m_next_event)), m_schedule.at(m_next_event).frequency, now) || changed;
+  }
+  for (auto& domain : m_domains) {
+    changed = govern(domain, now) || changed;
+  }
+  return changed;
+}
+
+auto champsim::dvfs_controller::end_phase(champsim::chrono::clock::time_point now) -> std::vector<dvfs_stats>
+{
+  std::vector<dvfs_stats> result;
+  for (auto& domain : m_domains) {
+    domain.stats.residency[domain.frequency] += now - domain.since;
+    domain.since = now;
+    result.push_back(domain.stats);
+  }
+  return result;
+}
+
+champsim::chrono::picoseconds champsim::period_of_frequency(long frequency) { return champsim::chrono::picoseconds{1000000 / frequency}; }
+
+auto champsim::read_dvfs_schedule(std::istream& in) -> std::vector<dvfs_event>
+{
+  std::vector<dvfs_event> events;
+  std::string line;
+  for (long line_number = 1; std::getline(in, line); ++line_number) {
+    std::istringstream fields{line};
+    fields >> std::ws;
+    if (fields.eof() || fields.peek() == '#') {
+      continue;
+    }
+
+    long long time_ns = 0;
+    dvfs_event event{};
+    if (!(fields >> time_ns >> event.domain >> event.frequency) || time_ns < 0) {
+      throw std::invalid_argument{fmt::format("Frequency change on line {} is malformed: {}", line_number, line)};
+    }
+    event.time = champsim::chrono::clock::time_point{std::chrono::nanoseconds{time_ns}};
+    events.push_back(event);
+  }
+  return events;
+}
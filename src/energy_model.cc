@@ -0,0 +1,184 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "energy_model.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+#include "champsim.h"
+#include "util/to_underlying.h"
+
+namespace
+{
+struct sram_point {
+  double kibibytes;
+  double data_access;        // pJ per 64-byte block
+  double tag_access_per_way; // pJ
+};
+
+// Read energies of SRAM arrays, roughly as CACTI gives them for a 22 nm process
+constexpr std::array<sram_point, 5> sram_table{{{8, 5.0, 0.30}, {32, 9.0, 0.45}, {256, 22.0, 0.80}, {2048, 65.0, 1.50}, {16384, 190.0, 2.80}}};
+constexpr double table_block_size = 64;
+
+// About 0.25 mW per KiB at 4 GHz
+constexpr double leakage_per_kibibyte = 0.0625;
+
+// The size of a translation in a cache whose blocks are pages
+constexpr std::size_t translation_size = 8;
+
+template <typename T>
+void override_energy(T& energy, const std::map<std::string, double T::*>& fields, const std::string& component, const nlohmann::json& values)
+{
+  for (const auto& [key, value] : values.items()) {
+    auto field = fields.find(key);
+    if (field == std::end(fields)) {
+      throw std::invalid_argument{fmt::format("The energy model of {} has no energy named {}", component, key)};
+    }
+    energy.*(field->second) = value.template get<double>();
+  }
+}
+} // namespace
+
+auto champsim::default_cache_energy(std::size_t sets, std::size_t ways, std::size_t block_size) -> cache_energy
+{
+  const auto kibibytes = static_cast<double>(sets * ways * block_size) / 1024.0;
+
+  // Interpolate linearly between the logarithms, extending the first and last segments beyond the table
+  auto upper =
+      std::find_if(std::next(std::begin(sram_table)), std::prev(std::end(sram_table)), [kibibytes](const auto& x) { return x.kibibytes >= kibibytes; });
+  auto lower = std::prev(upper);
+  const auto fraction = std::log(kibibytes / lower->kibibytes) / std::log(upper->kibibytes / lower->kibibytes);
+  auto interpolate = [fraction](double lo, double hi) { return lo * std::pow(hi / lo, fraction); };
+
+  cache_energy result;
+  result.data_access = interpolate(lower->data_access, upper->data_access) * static_cast<double>(block_size) / table_block_size;
+  result.tag_access = interpolate(lower->tag_access_per_way, upper->tag_access_per_way) * static_cast<double>(ways);
+  result.leakage = leakage_per_kibibyte * kibibytes;
+  return result;
+}
+
+auto champsim::default_dram_energy(std::size_t ranks) -> dram_energy
+{
+  // A rank of 8Gb DDR4 devices consumes about 500 nJ in each refresh, and about 0.3 W in standby
+  dram_energy result;
+  result.refresh = 500000.0 * static_cast<double>(ranks);
+  result.background = 190.0 * static_cast<double>(ranks);
+  return result;
+}
+
+champsim::energy_model::energy_model(environment& env)
+{
+  for (O3_CPU& cpu : env.cpu_view()) {
+    m_cores.try_emplace(cpu.cpu);
+  }
+
+  for (CACHE& cache : env.cache_view()) {
+    const auto offset_bits = champsim::to_underlying(cache.OFFSET_BITS);
+    const auto block_size = (offset_bits >= LOG2_PAGE_SIZE) ? translation_size : (std::size_t{1} << offset_bits);
+    m_caches.try_emplace(cache.NAME, default_cache_energy(cache.NUM_SET, cache.NUM_WAY, block_size));
+  }
+
+  const auto& dram = env.dram_view();
+  if (!std::empty(dram.channels)) {
+    m_dram = default_dram_energy(dram.channels.front().address_mapping.ranks());
+    m_dram_period = dram.channels.front().clock_period;
+  }
+}
+
+champsim::energy_model::energy_model(environment& env, const nlohmann::json& overrides) : energy_model(env)
+{
+  const std::map<std::string, double core_energy::*> core_fields{
+      {"dispatch", &core_energy::dispatch}, {"retire", &core_energy::retire}, {"leakage", &core_energy::leakage}};
+  const std::map<std::string, double cache_energy::*> cache_fields{
+      {"tag_access", &cache_energy::tag_access}, {"data_access", &cache_energy::data_access}, {"leakage", &cache_energy::leakage}};
+  const std::map<std::string, double dram_energy::*> dram_fields{{"activate", &dram_energy::activate}, {"precharge", &dram_energy::precharge},
+                                                                 {"read", &dram_energy::read},         {"write", &dram_energy::write},
+                                                                 {"refresh", &dram_energy::refresh},   {"background", &dram_energy::background}};
+
+  for (const auto& [name, values] : overrides.items()) {
+    auto cache = m_caches.find(name);
+    auto cpu = std::find_if(std::begin(m_cores), std::end(m_cores), [&name](const auto& entry) { return name == fmt::format("cpu{}", entry.first); });
+    if (name == "DRAM") {
+      ::override_energy(m_dram, dram_fields, name, values);
+    } else if (cache != std::end(m_caches)) {
+      ::override_energy(cache->second, cache_fields, name, values);
+    } else if (cpu != std::end(m_cores)) {
+      ::override_energy(cpu->second, core_fields, name, values);
+    } else {
+      throw std::invalid_argument{fmt::format("The energy model names {}, which is not a core, cache, or the DRAM", name)};
+    }
+  }
+}
+
+auto champsim::energy_model::account(const phase_stats& stats) const -> std::vector<energy_stats>
+{
+  using double_picoseconds = std::chrono::duration<double, std::pico>;
+
+  std::vector<energy_stats> result;
+  energy_stats system{"System", 0, 0, stats.elapsed};
+  auto add = [&result, &system](energy_stats component) {
+    system.dynamic += component.dynamic;
+    system.leakage += component.leakage;
+    result.push_back(std::move(component));
+  };
+
+  for (const auto& cpu : stats.sim_cpu_stats) {
+    // Each core names its statistics by its index, as O3_CPU::begin_phase() does
+    auto core = std::find_if(std::begin(m_cores), std::end(m_cores), [&cpu](const auto& entry) { return cpu.name == fmt::format("CPU {}", entry.first); });
+    if (core == std::end(m_cores)) {
+      continue;
+    }
+    const auto& energy = core->second;
+    add(energy_stats{cpu.name, static_cast<double>(cpu.instrs()) * (energy.dispatch + energy.retire), static_cast<double>(cpu.cycles()) * energy.leakage,
+                     stats.elapsed});
+  }
+
+  for (const auto& cache : stats.sim_cache_stats) {
+    auto found = m_caches.find(cache.name);
+    if (found == std::end(m_caches)) {
+      continue;
+    }
+
+    const auto& energy = found->second;
+    const auto scale = champsim::is_sampled(cache) ? static_cast<double>(cache.total_sets) / static_cast<double>(cache.sampled_sets) : 1.0;
+    const auto hits = static_cast<double>(cache.hits.total());
+    const auto misses = static_cast<double>(cache.misses.total());
+    const auto fills = misses - static_cast<double>(cache.mshr_merge.total());
+    add(energy_stats{cache.name, scale * ((hits + misses) * energy.tag_access + (hits + fills) * energy.data_access),
+                     static_cast<double>(cache.cycles()) * energy.leakage, stats.elapsed});
+  }
+
+  for (const auto& channel : stats.sim_dram_stats) {
+    const auto activates = static_cast<double>(channel.RQ_ROW_BUFFER_MISS + channel.WQ_ROW_BUFFER_MISS);
+    const auto reads = static_cast<double>(channel.RQ_ROW_BUFFER_HIT + channel.RQ_ROW_BUFFER_MISS);
+    const auto writes = static_cast<double>(channel.WQ_ROW_BUFFER_HIT + channel.WQ_ROW_BUFFER_MISS);
+    const auto cycles = double_picoseconds{channel.elapsed} / double_picoseconds{m_dram_period};
+    add(energy_stats{channel.name,
+                     activates * (m_dram.activate + m_dram.precharge) + reads * m_dram.read + writes * m_dram.write
+                         + static_cast<double>(channel.refresh_cycles) * m_dram.refresh,
+                     cycles * m_dram.background, stats.elapsed});
+  }
+
+  result.push_back(system);
+  return result;
+}
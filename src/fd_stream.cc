@@ -0,0 +1,146 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fd_stream.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+int connect_unix_socket(const std::string& path)
+{
+  sockaddr_un addr{};
+  if (std::size(path) >= sizeof(addr.sun_path)) {
+    throw std::system_error{ENAMETOOLONG, std::generic_category(), "Socket path is too long: " + path};
+  }
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    throw std::system_error{errno, std::generic_category(), "Could not create socket for " + path};
+  }
+
+  addr.sun_family = AF_UNIX;
+  std::copy(std::begin(path), std::end(path), std::begin(addr.sun_path));
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast): required by the sockets API
+    auto err = errno;
+    ::close(fd);
+    throw std::system_error{err, std::generic_category(), "Could not connect to " + path};
+  }
+
+  return fd;
+}
+
+int open_source(const std::string& name)
+{
+  if (name == "-") {
+    return STDIN_FILENO;
+  }
+
+  struct stat st {
+  };
+  if (::stat(name.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+    return connect_unix_socket(name);
+  }
+
+  int fd = ::open(name.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+  if (fd < 0) {
+    throw std::system_error{errno, std::generic_category(), "Could not open " + name};
+  }
+  return fd;
+}
+} // namespace
+
+champsim::fd_istream::fd_istream(const std::string& name) : fd_istream(::open_source(name), name != "-") {}
+
+champsim::fd_istream::fd_istream(int fd, bool owns) : fd_(fd), owns_fd_(owns) {}
+
+champsim::fd_istream::fd_istream(fd_istream&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)), owns_fd_(std::exchange(other.owns_fd_, false)), eof_(other.eof_), fail_(other.fail_), gcount_(other.gcount_),
+      pushback_(std::move(other.pushback_))
+{
+}
+
+auto champsim::fd_istream::operator=(fd_istream&& other) noexcept -> fd_istream&
+{
+  std::swap(fd_, other.fd_);
+  std::swap(owns_fd_, other.owns_fd_);
+  std::swap(pushback_, other.pushback_);
+  eof_ = other.eof_;
+  fail_ = other.fail_;
+  gcount_ = other.gcount_;
+  return *this;
+}
+
+champsim::fd_istream::~fd_istream()
+{
+  if (owns_fd_ && fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+auto champsim::fd_istream::read(char* s, std::streamsize count) -> fd_istream&
+{
+  gcount_ = 0;
+
+  // Serve any returned bytes first
+  auto from_pushback = std::min(count, static_cast<std::streamsize>(std::size(pushback_)));
+  std::copy_n(std::begin(pushback_), from_pushback, s);
+  pushback_.erase(std::begin(pushback_), std::next(std::begin(pushback_), from_pushback));
+  gcount_ += from_pushback;
+
+  // Pipes and sockets may return fewer bytes than requested, so keep reading until the request is satisfied or the writer hangs up
+  while (gcount_ < count && !eof_) {
+    auto bytes_read = ::read(fd_, std::next(s, gcount_), static_cast<std::size_t>(count - gcount_));
+    if (bytes_read < 0 && errno == EINTR) {
+      continue;
+    }
+
+    // A failing source must not pass for the end of the trace, or the simulation would silently run on a truncated trace
+    if (bytes_read < 0) {
+      throw std::system_error{errno, std::generic_category(), "Could not read from the trace stream"};
+    }
+
+    if (bytes_read == 0) {
+      eof_ = true;
+    } else {
+      gcount_ += bytes_read;
+    }
+  }
+
+  fail_ = (gcount_ < count);
+  return *this;
+}
+
+void champsim::fd_istream::unread(const char* s, std::streamsize count) { pushback_.insert(std::begin(pushback_), s, std::next(s, count)); }
+
+bool champsim::is_stream_source(const std::string& name)
+{
+  if (name == "-") {
+    return true;
+  }
+
+  struct stat st {
+  };
+  return ::stat(name.c_str(), &st) == 0 && (S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode));
+}
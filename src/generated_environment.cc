@@ -1,8 +1,13 @@
 // NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers): generated magic numbers
 
 #include <forward_list>
+#include <memory>
 
-#include "core_inst.inc"
+// Each configuration compiles this file separately, with its own instantiation files on the include path
+#if __has_include("instantiation.inc")
+#include "instantiation.inc"
+#endif
+#include "champsim.h"
 #include "environment.h"
 
 #if __has_include("legacy_bridge.h")
@@ -24,8 +29,21 @@ auto build(PTWs... builders)
 }
 } // namespace champsim::configured
 
-#if __has_include("core_inst.cc.inc")
-#include "core_inst.cc.inc"
+#if __has_include("instantiation.cc.inc")
+#include "instantiation.cc.inc"
+#endif
+
+#if defined(CHAMPSIM_BUILD) && !defined(CHAMPSIM_TEST_BUILD)
+using configured_environment = champsim::configured::generated_environment<CHAMPSIM_BUILD>;
+
+const std::size_t NUM_CPUS = configured_environment::num_cpus;
+
+const unsigned BLOCK_SIZE = configured_environment::block_size;
+const unsigned PAGE_SIZE = configured_environment::page_size;
+const unsigned LOG2_BLOCK_SIZE = champsim::lg2(BLOCK_SIZE);
+const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
+
+std::unique_ptr<champsim::environment> champsim::configured::make_generated_environment() { return std::make_unique<configured_environment>(); }
 #endif
 
 // NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -15,6 +15,9 @@
  */
 
 #include <algorithm>
+#include <chrono>
+#include <ratio>
+#include <string>
 #include <utility>
 #include <nlohmann/json.hpp>
 
@@ -37,6 +40,12 @@ void to_json(nlohmann::json& j, const O3_CPU::stats_type& stats)
                      {"cycles", stats.cycles()},
                      {"Avg ROB occupancy at mispredict", std::ceil(stats.total_rob_occupancy_at_branch_mispredict) / std::ceil(total_mispredictions)},
                      {"mispredict", mpki}};
+
+  if (stats.sync_events > 0) {
+    j.emplace("synchronization", nlohmann::json{{"events", stats.sync_events},
+                                                 {"lock wait cycles", stats.lock_wait_cycles},
+                                                 {"barrier wait cycles", stats.barrier_wait_cycles}});
+  }
 }
 
 void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
@@ -71,6 +80,14 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
     statsmap.emplace(access_type_names.at(champsim::to_underlying(type)), nlohmann::json{{"hit", hits}, {"miss", misses}, {"mshr_merge", mshr_merges}});
   }
 
+  if (champsim::is_sampled(stats)) {
+    const auto misses = champsim::estimate_misses(stats);
+    statsmap.emplace("set sampling", nlohmann::json{{"sampled sets", stats.sampled_sets},
+                                                    {"total sets", stats.total_sets},
+                                                    {"extrapolated misses", misses.value},
+                                                    {"extrapolated misses 95% confidence", misses.confidence}});
+  }
+
   j = statsmap;
 }
 
@@ -82,6 +99,49 @@ void to_json(nlohmann::json& j, const DRAM_CHANNEL::stats_type stats)
                      {"WQ ROW_BUFFER_MISS", stats.WQ_ROW_BUFFER_MISS},
                      {"AVG DBUS CONGESTED CYCLE", (std::ceil(stats.dbus_cycle_congested) / std::ceil(stats.dbus_count_congested))},
                      {"REFRESHES ISSUED", stats.refresh_cycles}};
+
+  if (!std::empty(stats.cores)) {
+    const auto seconds = std::chrono::duration<double>{stats.elapsed}.count();
+    std::vector<nlohmann::json> cores;
+    for (const auto& core : stats.cores) {
+      cores.push_back(nlohmann::json{{"requests", core.requests},
+                                     {"bandwidth GB/s", seconds > 0 ? static_cast<double>(core.requests * BLOCK_SIZE) / (std::giga::num * seconds) : 0.0},
+                                     {"avg queue delay", std::ceil(core.queue_cycles + core.throttled_request_cycles) / std::ceil(core.requests)},
+                                     {"throttled request cycles", core.throttled_request_cycles}});
+    }
+    j.emplace("cores", cores);
+  }
+}
+
+void to_json(nlohmann::json& j, const core_type_stats& stats)
+{
+  j = nlohmann::json{{"name", stats.name}, {"instructions", stats.instrs}, {"cycles", stats.cycles}};
+}
+
+void to_json(nlohmann::json& j, const trace_stats& stats)
+{
+  std::map<std::string, uint64_t> misses{std::begin(stats.cache_misses), std::end(stats.cache_misses)};
+  j = nlohmann::json{{"name", stats.name},
+                     {"instructions", stats.instrs},
+                     {"cycles", stats.cycles},
+                     {"context switches", stats.context_switches},
+                     {"migrations", stats.migrations},
+                     {"core types", stats.core_types},
+                     {"cache misses", misses}};
+}
+
+void to_json(nlohmann::json& j, const dvfs_stats& stats)
+{
+  std::map<std::string, double> residency;
+  for (const auto& [frequency, time] : stats.residency) {
+    residency.emplace(std::to_string(frequency), std::chrono::duration<double, std::micro>{time}.count());
+  }
+  j = nlohmann::json{{"name", stats.name}, {"transitions", stats.transitions}, {"residency us", residency}};
+}
+
+void to_json(nlohmann::json& j, const energy_stats& stats)
+{
+  j = nlohmann::json{{"name", stats.name}, {"dynamic pJ", stats.dynamic}, {"leakage pJ", stats.leakage}, {"EDP J*s", stats.edp()}};
 }
 
 namespace champsim
@@ -98,6 +158,18 @@ void to_json(nlohmann::json& j, const champsim::phase_stats stats)
   std::map<std::string, nlohmann::json> sim_stats;
   sim_stats.emplace("cores", stats.sim_cpu_stats);
   sim_stats.emplace("DRAM", stats.sim_dram_stats);
+  if (!std::empty(stats.sim_core_type_stats)) {
+    sim_stats.emplace("core types", stats.sim_core_type_stats);
+  }
+  if (!std::empty(stats.sim_trace_stats)) {
+    sim_stats.emplace("traces", stats.sim_trace_stats);
+  }
+  if (!std::empty(stats.sim_dvfs_stats)) {
+    sim_stats.emplace("frequency domains", stats.sim_dvfs_stats);
+  }
+  if (!std::empty(stats.sim_energy_stats)) {
+    sim_stats.emplace("energy", stats.sim_energy_stats);
+  }
   for (auto x : stats.sim_cache_stats) {
     sim_stats.emplace(x.name, x);
   }
@@ -15,63 +15,81 @@
  */
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <memory>
 #include <numeric>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <CLI/CLI.hpp>
 #include <fmt/core.h>
+#include <nlohmann/json.hpp>
 
 #include "cache.h" // for CACHE
 #include "champsim.h"
-#ifndef CHAMPSIM_TEST_BUILD
-#include "core_inst.inc"
-#endif
 #include "defaults.hpp"
+#include "dvfs.h"
+#include "energy_model.h"
 #include "environment.h"
 #include "ooo_cpu.h" // for O3_CPU
+#include "os_scheduler.h"
 #include "phase_info.h"
+#include "ptw.h" // for PageTableWalker
+#include "replay_log.h"
+#include "runtime_environment.h"
+#include "startup.h"
 #include "stats_printer.h"
+#include "sync_manager.h"
 #include "tracereader.h"
 #include "vmem.h"
 
 namespace champsim
 {
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, sync_manager& sync,
+                              os_scheduler& scheduler, dvfs_controller& dvfs);
 }
 
-#ifndef CHAMPSIM_TEST_BUILD
-using configured_environment = champsim::configured::generated_environment<CHAMPSIM_BUILD>;
-
-const std::size_t NUM_CPUS = configured_environment::num_cpus;
-
-const unsigned BLOCK_SIZE = configured_environment::block_size;
-const unsigned PAGE_SIZE = configured_environment::page_size;
-#endif
+#ifdef CHAMPSIM_TEST_BUILD
 const unsigned LOG2_BLOCK_SIZE = champsim::lg2(BLOCK_SIZE);
 const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
+#endif
 
 #ifndef CHAMPSIM_TEST_BUILD
 int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
 {
-  configured_environment gen_environment{};
-
   CLI::App app{"A microarchitecture simulator for research and education"};
 
   bool knob_cloudsuite{false};
+  bool hide_heartbeat{false};
+  bool startup_log{false};
+  unsigned init_threads{1};
+  unsigned dram_threads{1};
   long long warmup_instructions = 0;
   long long simulation_instructions = std::numeric_limits<long long>::max();
   std::string json_file_name;
+  std::string replay_log_name;
+  std::string runtime_config_name;
+  std::string sync_markers_name;
+  champsim::scheduler_options scheduler_options{10000000, 5000, false, champsim::migration_policy::none, 1000000};
+  std::string migration_policy_name;
+  bool report_energy{false};
+  std::string energy_model_name;
+  std::string dvfs_schedule_name;
+  std::string dvfs_levels;
+  champsim::dvfs_governor_options governor_options{{}, 100000, 0.6, 0.3};
   std::vector<std::string> trace_names;
 
-  auto set_heartbeat_callback = [&](auto) {
-    for (O3_CPU& cpu : gen_environment.cpu_view()) {
-      cpu.show_heartbeat = false;
-    }
-  };
-
   app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
-  app.add_flag("--hide-heartbeat", set_heartbeat_callback, "Hide the heartbeat output");
+  app.add_flag("--hide-heartbeat", hide_heartbeat, "Hide the heartbeat output");
+  app.add_flag("--startup-log", startup_log, "Print the time taken to prepare each part of the simulation");
+  app.add_option("--init-threads", init_threads,
+                 "The number of threads that initialize the simulated components. Modules that share state between instances require 1 (the default).")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--dram-threads", dram_threads, "The number of threads that operate the DRAM channels in parallel, including the simulation thread")
+      ->check(CLI::PositiveNumber);
   auto* warmup_instr_option = app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions in the warmup phase");
   auto* deprec_warmup_instr_option =
       app.add_option("--warmup_instructions", warmup_instructions, "[deprecated] use --warmup-instructions instead")->excludes(warmup_instr_option);
@@ -83,10 +101,81 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   auto* json_option =
       app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
 
-  app.add_option("traces", trace_names, "The paths to the traces")->required()->expected(NUM_CPUS)->check(CLI::ExistingFile);
+  app.add_flag("--energy", report_energy, "Estimate the energy of each core, cache, and DRAM channel from its activity");
+  app.add_option("--energy-model", energy_model_name,
+                 "A JSON file of energies in picojoules, keyed by component name, that replace the estimated defaults. Implies --energy.")
+      ->check(CLI::ExistingFile);
+
+  app.add_option("--replay-log", replay_log_name, "The name of the file to receive a replay log, which can be compared against another run with replay_check");
+
+  app.add_option("--config", runtime_config_name,
+                 "A configuration written by config.sh --runtime-config, to be simulated instead of the configuration this simulator was built with")
+      ->check(CLI::ExistingFile);
+
+  app.add_option("--sync-markers", sync_markers_name,
+                 "A file of lock and barrier events that synchronize the traces of a multithreaded workload, keyed by trace and instruction count")
+      ->check(CLI::ExistingFile);
+
+  auto* time_slice_option = app.add_option("--time-slice", scheduler_options.time_slice,
+                                           "The number of cycles a trace runs before its core switches to another trace. Traces are scheduled onto the cores "
+                                           "if this is given, or if there are more traces than cores.")
+                                ->check(CLI::PositiveNumber);
+  app.add_option("--context-switch-cost", scheduler_options.switch_cost, "The number of cycles for which a core stops fetching at each context switch");
+  app.add_flag("--flush-tlbs-on-switch", scheduler_options.flush_translations, "Empty the TLBs of a core at each context switch");
+  app.add_option("--migration-policy", migration_policy_name,
+                 "How traces migrate between cores of different types: \"periodic\" rotates the traces through the largest cores, and \"phase\" places the "
+                 "traces that use the most of their core's width on the largest cores")
+      ->check(CLI::IsMember({"periodic", "phase"}));
+  app.add_option("--migration-interval", scheduler_options.migration_interval, "The number of cycles of the first core between migration decisions")
+      ->check(CLI::PositiveNumber);
+
+  app.add_option("--dvfs-schedule", dvfs_schedule_name,
+                 "A file of frequency changes, each given by the simulated time in nanoseconds, the frequency domain, and the frequency in MHz")
+      ->check(CLI::ExistingFile);
+  app.add_option("--dvfs-levels", dvfs_levels,
+                 "A comma-separated list of frequencies in MHz. If this is given, a governor moves each core and its private caches between these "
+                 "frequencies according to the fraction of the retire width it uses.");
+  app.add_option("--dvfs-interval", governor_options.interval, "The number of core cycles between the decisions of the frequency governor")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--dvfs-up-threshold", governor_options.up_threshold, "The fraction of the retire width above which the governor raises the frequency");
+  app.add_option("--dvfs-down-threshold", governor_options.down_threshold,
+                 "The fraction of the retire width below which the governor lowers the frequency");
+
+  app.add_option("traces", trace_names, "The paths to the traces. There may be more traces than cores.")
+      ->required()
+      ->expected(static_cast<int>(NUM_CPUS), static_cast<int>(champsim::os_scheduler::max_traces))
+      ->check(CLI::ExistingFile | CLI::IsMember({"-"}));
 
   CLI11_PARSE(app, argc, argv);
 
+  std::vector<champsim::startup_time> startup_times;
+  auto time_startup = [&startup_times](std::string name, auto&& func) {
+    auto begin = std::chrono::steady_clock::now();
+    func();
+    startup_times.push_back({std::move(name), std::chrono::steady_clock::now() - begin});
+  };
+
+  std::unique_ptr<champsim::environment> environment_storage;
+  time_startup("environment", [&]() {
+    if (runtime_config_name.empty()) {
+      environment_storage = champsim::configured::make_generated_environment();
+    } else {
+      std::ifstream runtime_config_file{runtime_config_name};
+      environment_storage = std::make_unique<champsim::runtime_environment>(nlohmann::json::parse(runtime_config_file));
+    }
+  });
+  champsim::environment& gen_environment = *environment_storage;
+
+  if (dram_threads > 1) {
+    gen_environment.dram_view().set_threads(dram_threads);
+  }
+
+  if (hide_heartbeat) {
+    for (O3_CPU& cpu : gen_environment.cpu_view()) {
+      cpu.show_heartbeat = false;
+    }
+  }
+
   const bool warmup_given = (warmup_instr_option->count() > 0) || (deprec_warmup_instr_option->count() > 0);
   const bool simulation_given = (sim_instr_option->count() > 0) || (deprec_sim_instr_option->count() > 0);
 
@@ -105,9 +194,53 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   }
 
   std::vector<champsim::tracereader> traces;
-  std::transform(
-      std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
-      [knob_cloudsuite, repeat = simulation_given, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+  time_startup("traces", [&]() {
+    std::transform(
+        std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
+        [knob_cloudsuite, repeat = simulation_given, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+  });
+
+  champsim::sync_manager sync;
+  if (!sync_markers_name.empty()) {
+    time_startup("synchronization markers", [&]() {
+      std::ifstream sync_markers_file{sync_markers_name};
+      sync = champsim::sync_manager{champsim::read_sync_markers(sync_markers_file)};
+    });
+    if (sync.thread_count() > std::size(trace_names)) {
+      throw std::invalid_argument{
+          fmt::format("Synchronization markers name trace {}, but only {} traces were given", sync.thread_count() - 1, std::size(trace_names))};
+    }
+  }
+
+  champsim::os_scheduler scheduler;
+  if (migration_policy_name == "periodic") {
+    scheduler_options.migration = champsim::migration_policy::periodic;
+  } else if (migration_policy_name == "phase") {
+    scheduler_options.migration = champsim::migration_policy::phase;
+  }
+  if (time_slice_option->count() > 0 || std::size(trace_names) > NUM_CPUS || scheduler_options.migration != champsim::migration_policy::none) {
+    scheduler = champsim::os_scheduler{std::size(trace_names), NUM_CPUS, scheduler_options};
+  }
+
+  champsim::dvfs_controller dvfs;
+  if (!dvfs_schedule_name.empty() || !dvfs_levels.empty()) {
+    std::vector<champsim::dvfs_event> dvfs_schedule;
+    if (!dvfs_schedule_name.empty()) {
+      std::ifstream dvfs_schedule_file{dvfs_schedule_name};
+      dvfs_schedule = champsim::read_dvfs_schedule(dvfs_schedule_file);
+    }
+
+    std::optional<champsim::dvfs_governor_options> governor;
+    if (!dvfs_levels.empty()) {
+      std::istringstream levels{dvfs_levels};
+      for (std::string level; std::getline(levels, level, ',');) {
+        governor_options.levels.push_back(std::stol(level));
+      }
+      governor = governor_options;
+    }
+
+    dvfs = champsim::dvfs_controller{gen_environment, dvfs_schedule, governor};
+  }
 
   std::vector<champsim::phase_info> phases{
       {champsim::phase_info{"Warmup", true, warmup_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names},
@@ -120,7 +253,49 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n",
              phases.at(0).length, phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
 
-  auto phase_stats = champsim::main(gen_environment, phases, traces);
+  std::ofstream replay_file;
+  std::optional<champsim::replay::log> replay;
+  if (!replay_log_name.empty()) {
+    replay_file.open(replay_log_name, std::ios::binary);
+    replay.emplace(replay_file);
+    for (O3_CPU& cpu : gen_environment.cpu_view()) {
+      replay->attach(cpu, fmt::format("cpu{}", cpu.cpu));
+    }
+    for (CACHE& cache : gen_environment.cache_view()) {
+      replay->attach(cache, cache.NAME);
+    }
+    for (PageTableWalker& ptw : gen_environment.ptw_view()) {
+      replay->attach(ptw, ptw.NAME);
+    }
+    auto& dram = gen_environment.dram_view();
+    for (std::size_t i = 0; i < std::size(dram.channels); ++i) {
+      replay->attach(dram.channels.at(i), fmt::format("DRAM_CHANNEL{}", i));
+    }
+  }
+
+  auto component_times = champsim::initialize(gen_environment, init_threads);
+  if (startup_log) {
+    startup_times.insert(std::end(startup_times), std::begin(component_times), std::end(component_times));
+    for (const auto& [name, elapsed] : startup_times) {
+      fmt::print("[STARTUP] {}: {:.3f} ms\n", name, std::chrono::duration<double, std::milli>{elapsed}.count());
+    }
+    fmt::print("\n");
+  }
+
+  auto phase_stats = champsim::main(gen_environment, phases, traces, sync, scheduler, dvfs);
+
+  if (report_energy || !energy_model_name.empty()) {
+    nlohmann::json energy_overrides = nlohmann::json::object();
+    if (!energy_model_name.empty()) {
+      std::ifstream energy_model_file{energy_model_name};
+      energy_overrides = nlohmann::json::parse(energy_model_file);
+    }
+
+    champsim::energy_model energy{gen_environment, energy_overrides};
+    for (auto& stats : phase_stats) {
+      stats.sim_energy_stats = energy.account(stats);
+    }
+  }
 
   fmt::print("\nChampSim completed all CPUs\n\n");
 
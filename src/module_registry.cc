@@ -0,0 +1,117 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "module_registry.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+#include "plugin.h"
+
+#if __has_include("legacy_bridge.h")
+#include "legacy_bridge.h"
+#endif
+
+#if __has_include("module_registry.inc")
+#include "module_registry.inc"
+#endif
+
+namespace
+{
+template <typename Concept, typename Owner, template <typename...> typename Model>
+struct module_table {
+  std::string_view kind;
+  std::map<std::string, std::unique_ptr<Concept> (*)(Owner*), std::less<>> factories{};
+
+  template <typename... Ts>
+  void add(std::string name)
+  {
+    // The same module may be listed by several configurations, so the first listing wins
+    factories.try_emplace(std::move(name), [](Owner* owner) -> std::unique_ptr<Concept> { return std::make_unique<Model<Ts...>>(owner); });
+  }
+
+  std::unique_ptr<Concept> make(std::string_view name, Owner* owner) const
+  {
+    if (auto found = factories.find(name); found != std::end(factories)) {
+      return found->second(owner);
+    }
+    throw std::invalid_argument{fmt::format("No {} named '{}' was compiled into this simulator. Known modules: {}", kind, name, fmt::join(names(), ", "))};
+  }
+
+  std::vector<std::string> names() const
+  {
+    std::vector<std::string> retval;
+    std::transform(std::begin(factories), std::end(factories), std::back_inserter(retval), [](const auto& entry) { return entry.first; });
+    return retval;
+  }
+};
+
+struct module_registry {
+  module_table<CACHE::prefetcher_module_concept, CACHE, CACHE::prefetcher_module_model> prefetcher{"prefetcher"};
+  module_table<CACHE::replacement_module_concept, CACHE, CACHE::replacement_module_model> replacement{"replacement policy"};
+  module_table<O3_CPU::branch_module_concept, O3_CPU, O3_CPU::branch_module_model> branch_predictor{"branch predictor"};
+  module_table<O3_CPU::btb_module_concept, O3_CPU, O3_CPU::btb_module_model> btb{"BTB"};
+};
+
+const module_registry& get_registry()
+{
+  static const module_registry instance = [] {
+    module_registry retval;
+#define CHAMPSIM_REGISTER_MODULE(kind, name, ...) retval.kind.add<__VA_ARGS__>(name);
+#if __has_include("module_registry_entries.inc")
+#include "module_registry_entries.inc"
+#endif
+#undef CHAMPSIM_REGISTER_MODULE
+    return retval;
+  }();
+  return instance;
+}
+} // namespace
+
+std::unique_ptr<CACHE::prefetcher_module_concept> champsim::modules::registry::make_prefetcher(std::string_view name, CACHE* cache)
+{
+  if (champsim::plugin::is_plugin_name(name)) {
+    return champsim::plugin::make_prefetcher(champsim::plugin::load_prefetcher(std::string{name}), cache);
+  }
+  return ::get_registry().prefetcher.make(name, cache);
+}
+
+std::unique_ptr<CACHE::replacement_module_concept> champsim::modules::registry::make_replacement(std::string_view name, CACHE* cache)
+{
+  if (champsim::plugin::is_plugin_name(name)) {
+    return champsim::plugin::make_replacement(champsim::plugin::load_replacement(std::string{name}), cache);
+  }
+  return ::get_registry().replacement.make(name, cache);
+}
+
+std::unique_ptr<O3_CPU::branch_module_concept> champsim::modules::registry::make_branch_predictor(std::string_view name, O3_CPU* cpu)
+{
+  return ::get_registry().branch_predictor.make(name, cpu);
+}
+
+std::unique_ptr<O3_CPU::btb_module_concept> champsim::modules::registry::make_btb(std::string_view name, O3_CPU* cpu)
+{
+  return ::get_registry().btb.make(name, cpu);
+}
+
+std::vector<std::string> champsim::modules::registry::prefetcher_names() { return ::get_registry().prefetcher.names(); }
+std::vector<std::string> champsim::modules::registry::replacement_names() { return ::get_registry().replacement.names(); }
+std::vector<std::string> champsim::modules::registry::branch_predictor_names() { return ::get_registry().branch_predictor.names(); }
+std::vector<std::string> champsim::modules::registry::btb_names() { return ::get_registry().btb.names(); }
@@ -28,6 +28,7 @@
 #include "champsim.h"
 #include "deadlock.h"
 #include "instruction.h"
+#include "replay_log.h"
 #include "util/span.h"
 
 std::chrono::seconds elapsed_time();
@@ -37,35 +38,47 @@ constexpr long long STAT_PRINTING_PERIOD = 10000000;
 long O3_CPU::operate()
 {
   long progress{0};
-  progress += retire_rob();                    // retire
-  progress += complete_inflight_instruction(); // finalize execution
-  progress += execute_instruction();           // execute instructions
-  progress += schedule_instruction();          // schedule instructions
-  progress += handle_memory_return();          // finalize memory transactions
-  progress += operate_lsq();                   // execute memory transactions
+  if (waiting_for_sync.has_value() && std::empty(input_queue)) {
+    if (waiting_for_sync == champsim::sync_kind::barrier) {
+      ++sim_stats.barrier_wait_cycles;
+    } else {
+      ++sim_stats.lock_wait_cycles;
+    }
+  }
 
-  progress += dispatch_instruction(); // dispatch
-  progress += decode_instruction();   // decode
-  progress += promote_to_decode();
+  if (MODEL == champsim::core_model::interval) {
+    progress += operate_interval();
+  } else {
+    progress += retire_rob();                    // retire
+    progress += complete_inflight_instruction(); // finalize execution
+    progress += execute_instruction();           // execute instructions
+    progress += schedule_instruction();          // schedule instructions
+    progress += handle_memory_return();          // finalize memory transactions
+    progress += operate_lsq();                   // execute memory transactions
 
-  progress += fetch_instruction(); // fetch
-  progress += check_dib();
-  initialize_instruction();
+    progress += dispatch_instruction(); // dispatch
+    progress += decode_instruction();   // decode
+    progress += promote_to_decode();
+
+    progress += fetch_instruction(); // fetch
+    progress += check_dib();
+    initialize_instruction();
+  }
 
   // heartbeat
   if (show_heartbeat && (num_retired >= (last_heartbeat_instr + STAT_PRINTING_PERIOD))) {
-    using double_duration = std::chrono::duration<double, typename champsim::chrono::picoseconds::period>;
     auto heartbeat_instr{std::ceil(num_retired - last_heartbeat_instr)};
-    auto heartbeat_cycle{double_duration{current_time - last_heartbeat_time} / clock_period};
+    auto heartbeat_cycle{std::ceil(cycle_count() - last_heartbeat_cycle)};
 
     auto phase_instr{std::ceil(num_retired - begin_phase_instr)};
-    auto phase_cycle{double_duration{current_time - begin_phase_time} / clock_period};
+    auto phase_cycle{std::ceil(sim_cycle())};
 
     fmt::print("Heartbeat CPU {} instructions: {} cycles: {} heartbeat IPC: {:.4g} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", cpu,
-               num_retired, current_time.time_since_epoch() / clock_period, heartbeat_instr / heartbeat_cycle, phase_instr / phase_cycle, elapsed_time());
+               num_retired, cycle_count(), heartbeat_instr / heartbeat_cycle, phase_instr / phase_cycle, elapsed_time());
 
     last_heartbeat_instr = num_retired;
     last_heartbeat_time = current_time;
+    last_heartbeat_cycle = cycle_count();
   }
 
   return progress;
@@ -87,7 +100,7 @@ void O3_CPU::begin_phase()
   stats_type stats;
   stats.name = "CPU " + std::to_string(cpu);
   stats.begin_instrs = num_retired;
-  stats.begin_cycles = begin_phase_time.time_since_epoch() / clock_period;
+  stats.begin_cycles = cycle_count();
   sim_stats = stats;
 }
 
@@ -95,7 +108,7 @@ void O3_CPU::end_phase(unsigned finished_cpu)
 {
   // Record where the phase ended (overwrite if this is later)
   sim_stats.end_instrs = num_retired;
-  sim_stats.end_cycles = current_time.time_since_epoch() / clock_period;
+  sim_stats.end_cycles = cycle_count();
 
   if (finished_cpu == this->cpu) {
     finish_phase_instr = num_retired;
@@ -105,6 +118,16 @@ void O3_CPU::end_phase(unsigned finished_cpu)
   }
 }
 
+void O3_CPU::clock_period_changed(champsim::chrono::picoseconds old_period)
+{
+  BRANCH_MISPREDICT_PENALTY = champsim::rescale_latency(BRANCH_MISPREDICT_PENALTY, old_period, clock_period);
+  DISPATCH_LATENCY = champsim::rescale_latency(DISPATCH_LATENCY, old_period, clock_period);
+  DECODE_LATENCY = champsim::rescale_latency(DECODE_LATENCY, old_period, clock_period);
+  SCHEDULING_LATENCY = champsim::rescale_latency(SCHEDULING_LATENCY, old_period, clock_period);
+  EXEC_LATENCY = champsim::rescale_latency(EXEC_LATENCY, old_period, clock_period);
+  DIB_HIT_LATENCY = champsim::rescale_latency(DIB_HIT_LATENCY, old_period, clock_period);
+}
+
 void O3_CPU::initialize_instruction()
 {
   champsim::bandwidth instrs_to_read_this_cycle{
@@ -717,12 +740,19 @@ long O3_CPU::retire_rob()
 
   // commit register writes to backend RAT
   // and recycle the old physical registers
-  for (auto rob_it = retire_begin; rob_it != retire_end; ++rob_it) {
-    for (auto dreg : rob_it->destination_registers) {
-      reg_allocator.retire_dest_register(dreg);
+  if (MODEL == champsim::core_model::out_of_order) {
+    for (auto rob_it = retire_begin; rob_it != retire_end; ++rob_it) {
+      for (auto dreg : rob_it->destination_registers) {
+        reg_allocator.retire_dest_register(dreg);
+      }
     }
   }
 
+  if (replay_chain != nullptr) {
+    std::for_each(retire_begin, retire_end,
+                  [chain = replay_chain](const auto& x) { chain->add(champsim::replay::event::retire, x.ip.template to<uint64_t>()); });
+  }
+
   auto retire_count = std::distance(retire_begin, retire_end);
   num_retired += retire_count;
   ROB.erase(retire_begin, retire_end);
@@ -730,6 +760,103 @@ long O3_CPU::retire_rob()
   return retire_count;
 }
 
+long O3_CPU::operate_interval()
+{
+  // The interval model keeps the fetch stage, the load and store queues, and the reorder buffer, but it replaces decode, scheduling, and execution
+  // with dispatch at full width. The miss events (instruction cache misses, branch mispredictions, and long-latency loads) stall dispatch for as long
+  // as they are outstanding, and the reorder buffer bounds how many loads may overlap.
+  long progress{0};
+  progress += retire_rob();           // retire
+  progress += handle_memory_return(); // finalize memory transactions
+  progress += complete_interval();    // finalize execution
+  progress += operate_lsq();          // execute memory transactions
+
+  progress += dispatch_interval(); // dispatch
+
+  progress += fetch_instruction(); // fetch
+  progress += check_dib();
+  initialize_instruction();
+
+  return progress;
+}
+
+long O3_CPU::dispatch_interval()
+{
+  champsim::bandwidth available_dispatch_bandwidth{DISPATCH_WIDTH};
+
+  // dispatch DISPATCH_WIDTH fetched instructions into the ROB
+  while (available_dispatch_bandwidth.has_remaining() && !std::empty(IFETCH_BUFFER) && IFETCH_BUFFER.front().fetch_completed && std::size(ROB) != ROB_SIZE
+         && ((std::size_t)std::count_if(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return !lq_entry.has_value(); })
+             >= std::size(IFETCH_BUFFER.front().source_memory))
+         && ((std::size(IFETCH_BUFFER.front().destination_memory) + std::size(SQ)) <= SQ_SIZE)) {
+    do_dib_update(IFETCH_BUFFER.front());
+    ROB.push_back(std::move(IFETCH_BUFFER.front()));
+    IFETCH_BUFFER.pop_front();
+    do_memory_scheduling(ROB.back());
+    do_interval_dispatch(ROB.back());
+
+    available_dispatch_bandwidth.consume();
+  }
+
+  return available_dispatch_bandwidth.amount_consumed();
+}
+
+void O3_CPU::do_interval_dispatch(ooo_model_instr& instr)
+{
+  // Wait on each producer of a source register that has not completed
+  auto rob_end = std::prev(std::end(ROB));
+  for (auto src_reg : instr.source_registers) {
+    auto producer_id = interval_producers.at(static_cast<uint8_t>(src_reg));
+    auto producer = std::partition_point(std::begin(ROB), rob_end, ooo_model_instr::precedes(producer_id));
+    bool waits = producer != rob_end && producer->instr_id == producer_id && !producer->completed;
+    if (waits && (std::empty(producer->registers_instrs_depend_on_me) || &producer->registers_instrs_depend_on_me.back().get() != &instr)) {
+      producer->registers_instrs_depend_on_me.emplace_back(instr);
+      ++instr.num_reg_dependent;
+    }
+  }
+
+  for (auto dreg : instr.destination_registers) {
+    interval_producers.at(static_cast<uint8_t>(dreg)) = instr.instr_id;
+  }
+
+  instr.decoded = true;
+  instr.scheduled = true;
+  if (instr.num_reg_dependent == 0) {
+    do_execution(instr);
+  }
+}
+
+long O3_CPU::complete_interval()
+{
+  long progress{0};
+  for (auto& instr : ROB) {
+    if (instr.executed && !instr.completed && instr.ready_time <= current_time && instr.completed_mem_ops == instr.num_mem_ops()) {
+      do_interval_completion(instr);
+      ++progress;
+    }
+  }
+
+  return progress;
+}
+
+void O3_CPU::do_interval_completion(ooo_model_instr& instr)
+{
+  instr.completed = true;
+
+  // The front end refills after the branch resolves, through the stages that the interval model does not simulate
+  if (instr.branch_mispredicted) {
+    fetch_resume_time = current_time + BRANCH_MISPREDICT_PENALTY + DECODE_LATENCY + DISPATCH_LATENCY + SCHEDULING_LATENCY;
+  }
+
+  // Dependents are younger than this instruction, so completing them in the same pass of the ROB is in order
+  for (ooo_model_instr& dependent : instr.registers_instrs_depend_on_me) {
+    if (--dependent.num_reg_dependent == 0) {
+      do_execution(dependent);
+    }
+  }
+  instr.registers_instrs_depend_on_me.clear();
+}
+
 void O3_CPU::impl_initialize_branch_predictor() const { branch_module_pimpl->impl_initialize_branch_predictor(); }
 
 void O3_CPU::impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
@@ -834,7 +961,7 @@ bool CacheBus::issue_read(request_type data_packet)
   data_packet.cpu = cpu;
   data_packet.type = access_type::LOAD;
 
-  return lower_level->add_rq(data_packet);
+  return lower_level->add_rq(std::move(data_packet));
 }
 
 bool CacheBus::issue_write(request_type data_packet)
@@ -845,5 +972,5 @@ bool CacheBus::issue_write(request_type data_packet)
   data_packet.type = access_type::WRITE;
   data_packet.response_requested = false;
 
-  return lower_level->add_wq(data_packet);
+  return lower_level->add_wq(std::move(data_packet));
 }
@@ -16,6 +16,8 @@
 
 #include "operable.h"
 
+#include "replay_log.h"
+
 champsim::operable::operable() : operable(champsim::chrono::picoseconds{1}) {}
 
 champsim::operable::operable(champsim::chrono::picoseconds clock_period_) : clock_period(clock_period_) {}
@@ -32,8 +34,31 @@ long champsim::operable::operate_on(const champsim::chrono::clock& clock)
 
 long champsim::operable::_operate()
 {
-  current_time += clock_period;
-  return operate();
+  advance_cycle();
+  auto progress = operate();
+  finish_cycle();
+  return progress;
+}
+
+void champsim::operable::advance_cycle() { current_time += clock_period; }
+
+void champsim::operable::finish_cycle()
+{
+  if (replay_chain != nullptr) {
+    replay_chain->end_cycle(current_time, static_cast<uint64_t>(cycle_count()));
+  }
+}
+
+void champsim::operable::set_clock_period(champsim::chrono::picoseconds new_period)
+{
+  cycles_before_period = cycle_count();
+  period_begin = current_time;
+
+  auto old_period = clock_period;
+  clock_period = new_period;
+  clock_period_changed(old_period);
 }
 
-uint64_t champsim::operable::current_cycle() const { return static_cast<uint64_t>(current_time.time_since_epoch() / clock_period); }
+long long champsim::operable::cycle_count() const { return cycles_before_period + (current_time - period_begin) / clock_period; }
+
+uint64_t champsim::operable::current_cycle() const { return static_cast<uint64_t>(cycle_count()); }
@@ -0,0 +1,324 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "os_scheduler.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <fmt/core.h>
+
+namespace
+{
+// Place the trace index in the top bits of an address. Zero addresses (for example, the target of a branch that is not taken) are left unchanged.
+champsim::address tag_address(champsim::address addr, std::size_t trace)
+{
+  if (addr == champsim::address{}) {
+    return addr;
+  }
+  constexpr uint64_t mask = (uint64_t{1} << champsim::os_scheduler::address_space_shift) - 1;
+  return champsim::address{(addr.to<uint64_t>() & mask) | (uint64_t{trace} << champsim::os_scheduler::address_space_shift)};
+}
+
+uint64_t misses_of(const CACHE& cache, uint32_t cpu)
+{
+  using key_type = std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>;
+  uint64_t misses = 0;
+  for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION}) {
+    misses += cache.sim_stats.misses.value_or(key_type{type, cpu}, 0);
+  }
+  return misses;
+}
+
+// The caches that hold translations for the core: those reached through the translation path of any cache on the core's data path
+std::vector<std::reference_wrapper<CACHE>> translation_caches_of(const O3_CPU& cpu, const std::vector<std::reference_wrapper<CACHE>>& caches)
+{
+  auto cache_below = [&caches](const champsim::channel* chan) -> CACHE* {
+    auto found = std::find_if(std::begin(caches), std::end(caches), [chan](const CACHE& cache) {
+      return chan != nullptr && std::find(std::begin(cache.upper_levels), std::end(cache.upper_levels), chan) != std::end(cache.upper_levels);
+    });
+    return found == std::end(caches) ? nullptr : &found->get();
+  };
+
+  auto follow = [&cache_below](CACHE* first, std::vector<CACHE*>& seen) {
+    for (auto* cache = first; cache != nullptr && std::find(std::begin(seen), std::end(seen), cache) == std::end(seen); cache = cache_below(cache->lower_level)) {
+      seen.push_back(cache);
+    }
+  };
+
+  std::vector<CACHE*> data_caches;
+  follow(cache_below(cpu.L1I_bus.lower_channel()), data_caches);
+  follow(cache_below(cpu.L1D_bus.lower_channel()), data_caches);
+
+  std::vector<CACHE*> tlbs;
+  for (auto* cache : data_caches) {
+    follow(cache_below(cache->lower_translate), tlbs);
+  }
+
+  std::vector<std::reference_wrapper<CACHE>> retval;
+  std::transform(std::begin(tlbs), std::end(tlbs), std::back_inserter(retval), [](CACHE* cache) { return std::ref(*cache); });
+  return retval;
+}
+} // namespace
+
+champsim::os_scheduler::os_scheduler(std::size_t num_traces, std::size_t num_cores, scheduler_options options)
+    : m_options(options), m_pending(num_traces), m_stats(num_traces)
+{
+  if (num_traces > max_traces) {
+    throw std::invalid_argument{fmt::format("At most {} traces may be scheduled, but {} were given", max_traces, num_traces)};
+  }
+  if (num_traces < num_cores) {
+    throw std::invalid_argument{fmt::format("Each of the {} cores needs a trace, but only {} were given", num_cores, num_traces)};
+  }
+  if (m_options.time_slice <= 0) {
+    throw std::invalid_argument{fmt::format("The time slice must be positive, but was {}", m_options.time_slice)};
+  }
+  if (m_options.migration != migration_policy::none && m_options.migration_interval <= 0) {
+    throw std::invalid_argument{fmt::format("The migration interval must be positive, but was {}", m_options.migration_interval)};
+  }
+
+  for (std::size_t core = 0; core < num_cores; ++core) {
+    m_cores.push_back(core_state{core, champsim::chrono::clock::time_point::max()});
+  }
+  for (std::size_t trace = num_cores; trace < num_traces; ++trace) {
+    m_ready.push_back(trace);
+  }
+}
+
+bool champsim::os_scheduler::has_instruction(std::size_t trace, const tracereader& reader) const
+{
+  return (trace < std::size(m_pending) && !std::empty(m_pending.at(trace))) || !reader.eof();
+}
+
+ooo_model_instr champsim::os_scheduler::next_instruction(std::size_t core, std::size_t trace, tracereader& reader)
+{
+  if (!enabled()) {
+    return reader();
+  }
+
+  auto& pending = m_pending.at(trace);
+  if (std::empty(pending)) {
+    auto instr = reader();
+    instr.ip = ::tag_address(instr.ip, trace);
+    instr.branch_target = ::tag_address(instr.branch_target, trace);
+    auto tag = [trace](auto addr) { return ::tag_address(addr, trace); };
+    std::transform(std::begin(instr.source_memory), std::end(instr.source_memory), std::begin(instr.source_memory), tag);
+    std::transform(std::begin(instr.destination_memory), std::end(instr.destination_memory), std::begin(instr.destination_memory), tag);
+    instr.asid = {static_cast<uint8_t>(trace), static_cast<uint8_t>(trace)};
+    pending.push_back(std::move(instr));
+  }
+
+  auto instr = std::move(pending.front());
+  pending.pop_front();
+  instr.instr_id = m_cores.at(core).next_instr_id++;
+  return instr;
+}
+
+void champsim::os_scheduler::account(O3_CPU& cpu)
+{
+  auto& core = m_cores.at(cpu.cpu);
+  auto& stats = m_stats.at(core.trace);
+
+  const auto instrs = cpu.num_retired - core.accounted_instrs;
+  const auto cycles = cpu.cycle_count() - core.accounted_cycles;
+  stats.instrs += instrs;
+  stats.cycles += cycles;
+
+  auto type = std::find_if(std::begin(stats.core_types), std::end(stats.core_types), [&cpu](const auto& x) { return x.name == cpu.CORE_TYPE; });
+  if (type == std::end(stats.core_types)) {
+    type = stats.core_types.insert(type, core_type_stats{cpu.CORE_TYPE});
+  }
+  type->instrs += instrs;
+  type->cycles += cycles;
+
+  for (std::size_t i = 0; i < std::size(m_caches); ++i) {
+    auto misses = ::misses_of(m_caches.at(i), cpu.cpu);
+    stats.cache_misses.at(i).second += misses - core.accounted_misses.at(i);
+    core.accounted_misses.at(i) = misses;
+  }
+
+  core.accounted_instrs = cpu.num_retired;
+  core.accounted_cycles = cpu.cycle_count();
+}
+
+void champsim::os_scheduler::release_trace(O3_CPU& cpu)
+{
+  auto& core = m_cores.at(cpu.cpu);
+  account(cpu);
+
+  // Instructions that have not been fetched are returned to the trace, to be fetched when it next runs
+  auto& pending = m_pending.at(core.trace);
+  pending.insert(std::begin(pending), std::make_move_iterator(std::begin(cpu.input_queue)), std::make_move_iterator(std::end(cpu.input_queue)));
+  cpu.input_queue.clear();
+  cpu.waiting_for_sync.reset();
+}
+
+void champsim::os_scheduler::switch_trace(O3_CPU& cpu)
+{
+  auto& core = m_cores.at(cpu.cpu);
+  release_trace(cpu);
+
+  m_ready.push_back(core.trace);
+  auto next = m_ready.front();
+  m_ready.pop_front();
+  ++m_stats.at(next).context_switches;
+
+  core.slice_end = cpu.current_time + m_options.time_slice * cpu.clock_period;
+  resume_trace(cpu, next);
+}
+
+void champsim::os_scheduler::resume_trace(O3_CPU& cpu, std::size_t trace)
+{
+  auto& core = m_cores.at(cpu.cpu);
+  core.trace = trace;
+  core.switch_end = cpu.current_time + m_options.switch_cost * cpu.clock_period;
+  cpu.fetch_resume_time = std::max(cpu.fetch_resume_time, core.switch_end);
+
+  if (m_options.flush_translations) {
+    for (CACHE& cache : core.translation_caches) {
+      cache.invalidate_all();
+    }
+  }
+}
+
+long champsim::os_scheduler::operate(O3_CPU& cpu)
+{
+  auto& core = m_cores.at(cpu.cpu);
+  const bool slice_ended = cpu.current_time >= core.slice_end;
+  const bool yields = cpu.waiting_for_sync.has_value() && std::empty(cpu.input_queue);
+
+  if (std::empty(m_ready) || !(slice_ended || yields)) {
+    if (slice_ended) {
+      core.slice_end = cpu.current_time + m_options.time_slice * cpu.clock_period;
+    }
+    return cpu.current_time < core.switch_end ? 1 : 0;
+  }
+
+  switch_trace(cpu);
+  return 1;
+}
+
+long champsim::os_scheduler::migrate(const std::vector<std::reference_wrapper<O3_CPU>>& cpus)
+{
+  if (m_options.migration == migration_policy::none || std::empty(cpus)) {
+    return 0;
+  }
+
+  const O3_CPU& first = cpus.front();
+  if (first.current_time < m_next_migration) {
+    return 0;
+  }
+  m_next_migration = first.current_time + m_options.migration_interval * first.clock_period;
+
+  // The cores, from largest to smallest
+  std::vector<std::size_t> by_size(std::size(cpus));
+  std::iota(std::begin(by_size), std::end(by_size), std::size_t{0});
+  auto size_of = [&cpus](std::size_t i) {
+    const O3_CPU& cpu = cpus.at(i);
+    return std::pair{cpu.ROB_SIZE, champsim::to_underlying(cpu.DISPATCH_WIDTH)};
+  };
+  std::stable_sort(std::begin(by_size), std::end(by_size), [&size_of](auto x, auto y) { return size_of(x) > size_of(y); });
+
+  // The fraction of its retire width that each core used since the last decision
+  std::vector<double> utilization;
+  for (O3_CPU& cpu : cpus) {
+    auto& core = m_cores.at(cpu.cpu);
+    const auto width = static_cast<double>((cpu.cycle_count() - core.decision_cycles) * champsim::to_underlying(cpu.RETIRE_WIDTH));
+    utilization.push_back(width > 0 ? static_cast<double>(cpu.num_retired - core.decision_instrs) / width : 0.0);
+    core.decision_cycles = cpu.cycle_count();
+    core.decision_instrs = cpu.num_retired;
+  }
+
+  const auto largest = size_of(by_size.front());
+  const auto num_largest =
+      static_cast<std::size_t>(std::count_if(std::begin(by_size), std::end(by_size), [&size_of, largest](auto i) { return size_of(i) == largest; }));
+  if (num_largest == std::size(cpus)) {
+    return 0;
+  }
+
+  // The cores whose traces are to be placed on each core, in the order of by_size
+  auto sources = by_size;
+  if (m_options.migration == migration_policy::periodic) {
+    std::rotate(std::begin(sources), std::next(std::begin(sources), static_cast<std::ptrdiff_t>(num_largest)), std::end(sources));
+  } else {
+    std::stable_sort(std::begin(sources), std::end(sources), [&utilization](auto x, auto y) { return utilization.at(x) > utilization.at(y); });
+  }
+
+  std::vector<std::size_t> placement(std::size(cpus));
+  for (std::size_t i = 0; i < std::size(by_size); ++i) {
+    placement.at(by_size.at(i)) = m_cores.at(cpus.at(sources.at(i)).get().cpu).trace;
+  }
+
+  // Every moving trace gives up its unfetched instructions before any core takes its new trace
+  long moved = 0;
+  for (std::size_t i = 0; i < std::size(cpus); ++i) {
+    if (placement.at(i) != trace_on(cpus.at(i).get().cpu)) {
+      release_trace(cpus.at(i));
+    }
+  }
+  for (std::size_t i = 0; i < std::size(cpus); ++i) {
+    if (placement.at(i) != trace_on(cpus.at(i).get().cpu)) {
+      ++m_stats.at(placement.at(i)).migrations;
+      resume_trace(cpus.at(i), placement.at(i));
+      ++moved;
+    }
+  }
+  return moved;
+}
+
+void champsim::os_scheduler::begin_phase(const std::vector<std::reference_wrapper<O3_CPU>>& cpus, const std::vector<std::reference_wrapper<CACHE>>& caches)
+{
+  m_caches = caches;
+  for (auto& stats : m_stats) {
+    stats = trace_stats{};
+    std::transform(std::begin(m_caches), std::end(m_caches), std::back_inserter(stats.cache_misses),
+                   [](const CACHE& cache) { return std::pair{cache.NAME, uint64_t{}}; });
+  }
+
+  for (O3_CPU& cpu : cpus) {
+    auto& core = m_cores.at(cpu.cpu);
+    core.accounted_instrs = cpu.num_retired;
+    core.accounted_cycles = cpu.cycle_count();
+    core.decision_instrs = cpu.num_retired;
+    core.decision_cycles = cpu.cycle_count();
+    core.accounted_misses.clear();
+    std::transform(std::begin(m_caches), std::end(m_caches), std::back_inserter(core.accounted_misses),
+                   [cpu_idx = cpu.cpu](const CACHE& cache) { return ::misses_of(cache, cpu_idx); });
+
+    if (core.slice_end == champsim::chrono::clock::time_point::max()) {
+      core.slice_end = cpu.current_time + m_options.time_slice * cpu.clock_period;
+    }
+    if (m_options.flush_translations) {
+      core.translation_caches = ::translation_caches_of(cpu, m_caches);
+    }
+  }
+
+  if (!std::empty(cpus)) {
+    const O3_CPU& first = cpus.front();
+    m_next_migration = first.current_time + m_options.migration_interval * first.clock_period;
+  }
+}
+
+std::vector<trace_stats> champsim::os_scheduler::end_phase(const std::vector<std::reference_wrapper<O3_CPU>>& cpus)
+{
+  for (O3_CPU& cpu : cpus) {
+    account(cpu);
+  }
+  return m_stats;
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <cmath>
 #include <numeric>
 #include <ratio>
@@ -56,6 +57,12 @@ std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stat
                               ::print_ratio(std::kilo::num * total_mispredictions, stats.instrs()),
                               ::print_ratio(stats.total_rob_occupancy_at_branch_mispredict, total_mispredictions)));
 
+  if (stats.sync_events > 0) {
+    lines.push_back(fmt::format("{} SYNC EVENTS: {} LOCK WAIT: {} cycles BARRIER WAIT: {} cycles ({}% of cycles)", stats.name, stats.sync_events,
+                                stats.lock_wait_cycles, stats.barrier_wait_cycles,
+                                ::print_ratio(100 * (stats.lock_wait_cycles + stats.barrier_wait_cycles), stats.cycles())));
+  }
+
   lines.emplace_back("Branch type MPKI");
   for (auto idx : types) {
     lines.push_back(fmt::format("{}: {}", branch_type_names.at(champsim::to_underlying(idx)),
@@ -124,6 +131,14 @@ std::vector<std::string> champsim::plain_printer::format(CACHE::stats_type stats
         fmt::format("cpu{}->{} AVERAGE MISS LATENCY: {} cycles", cpu, stats.name, ::print_ratio(stats.total_miss_latency_cycles, total_downstream_demands)));
   }
 
+  if (champsim::is_sampled(stats)) {
+    const auto scale = static_cast<double>(stats.total_sets) / static_cast<double>(stats.sampled_sets);
+    const auto misses = champsim::estimate_misses(stats);
+    lines.push_back(fmt::format("{} SET SAMPLING: {} of {} sets EXTRAPOLATED ACCESS: {:.0f} HIT: {:.0f} MISS: {:.0f} +/- {:.0f} (95% confidence)", stats.name,
+                                stats.sampled_sets, stats.total_sets, scale * static_cast<double>(stats.hits.total() + stats.misses.total()),
+                                scale * static_cast<double>(stats.hits.total()), misses.value, misses.confidence));
+  }
+
   return lines;
 }
 
@@ -142,9 +157,68 @@ std::vector<std::string> champsim::plain_printer::format(DRAM_CHANNEL::stats_typ
   else
     lines.push_back(fmt::format("{} REFRESHES ISSUED: -", stats.name));
 
+  for (std::size_t cpu = 0; cpu < std::size(stats.cores); ++cpu) {
+    const auto& core = stats.cores[cpu];
+    if (core.requests > 0 || core.throttled_request_cycles > 0) {
+      const auto bandwidth = ::print_ratio(core.requests * BLOCK_SIZE, std::giga::num * std::chrono::duration<double>{stats.elapsed}.count());
+      lines.push_back(fmt::format("{} cpu{} REQUESTS: {:10} BANDWIDTH: {} GB/s AVG QUEUE DELAY: {} THROTTLED REQUEST-CYCLES: {:10}", stats.name, cpu,
+                                  core.requests, bandwidth, ::print_ratio(core.queue_cycles + core.throttled_request_cycles, core.requests),
+                                  core.throttled_request_cycles));
+    }
+  }
+
+  return lines;
+}
+
+std::vector<std::string> champsim::plain_printer::format(trace_stats stats)
+{
+  std::vector<std::string> lines{};
+  lines.push_back(fmt::format("{} cumulative IPC: {} instructions: {} cycles: {} context switches: {}", stats.name, ::print_ratio(stats.instrs, stats.cycles),
+                              stats.instrs, stats.cycles, stats.context_switches));
+  if (stats.migrations > 0) {
+    lines.push_back(fmt::format("{} migrations: {}", stats.name, stats.migrations));
+  }
+  if (std::size(stats.core_types) > 1) {
+    for (auto type : stats.core_types) {
+      type.name = fmt::format("{} on {}", stats.name, type.name);
+      auto sublines = format(type);
+      std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+    }
+  }
+  for (const auto& [cache_name, misses] : stats.cache_misses) {
+    if (misses > 0) {
+      lines.push_back(fmt::format("{} {} MISS: {:10d} MPKI: {}", stats.name, cache_name, misses, ::print_ratio(std::kilo::num * misses, stats.instrs)));
+    }
+  }
+  return lines;
+}
+
+std::vector<std::string> champsim::plain_printer::format(core_type_stats stats)
+{
+  return {fmt::format("{} cores cumulative IPC: {} instructions: {} cycles: {}", stats.name, ::print_ratio(stats.instrs, stats.cycles), stats.instrs,
+                      stats.cycles)};
+}
+
+std::vector<std::string> champsim::plain_printer::format(dvfs_stats stats)
+{
+  const auto total = std::accumulate(std::begin(stats.residency), std::end(stats.residency), champsim::chrono::clock::duration{},
+                                     [](auto acc, const auto& x) { return acc + x.second; });
+  std::vector<std::string> lines{};
+  lines.push_back(fmt::format("{} FREQUENCY CHANGES: {}", stats.name, stats.transitions));
+  for (const auto& [frequency, time] : stats.residency) {
+    lines.push_back(fmt::format("{} {} MHz TIME: {:.4g} us ({}%)", stats.name, frequency, std::chrono::duration<double, std::micro>{time}.count(),
+                                ::print_ratio(100 * time.count(), total.count())));
+  }
   return lines;
 }
 
+std::vector<std::string> champsim::plain_printer::format(energy_stats stats)
+{
+  auto in_microjoules = [](double picojoules) { return picojoules / std::mega::num; };
+  return {fmt::format("{} DYNAMIC ENERGY: {:.4g} uJ LEAKAGE ENERGY: {:.4g} uJ TOTAL ENERGY: {:.4g} uJ EDP: {:.4g} J*s", stats.name,
+                      in_microjoules(stats.dynamic), in_microjoules(stats.leakage), in_microjoules(stats.total()), stats.edp())};
+}
+
 void champsim::plain_printer::print(champsim::phase_stats& stats)
 {
   auto lines = format(stats);
@@ -158,7 +232,11 @@ std::vector<std::string> champsim::plain_printer::format(champsim::phase_stats&
 
   int i = 0;
   for (auto tn : stats.trace_names) {
-    lines.push_back(fmt::format("CPU {} runs {}", i++, tn));
+    if (std::empty(stats.sim_trace_stats)) {
+      lines.push_back(fmt::format("CPU {} runs {}", i++, tn));
+    } else {
+      lines.push_back(fmt::format("Trace {} runs {}", i++, tn));
+    }
   }
 
   if (NUM_CPUS > 1) {
@@ -193,6 +271,46 @@ std::vector<std::string> champsim::plain_printer::format(champsim::phase_stats&
     std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
   }
 
+  if (!std::empty(stats.sim_core_type_stats)) {
+    lines.emplace_back("");
+    lines.emplace_back("Core Type Statistics (not including warmup)");
+    lines.emplace_back("");
+    for (const auto& stat : stats.sim_core_type_stats) {
+      auto sublines = format(stat);
+      std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+    }
+  }
+
+  if (!std::empty(stats.sim_trace_stats)) {
+    lines.emplace_back("");
+    lines.emplace_back("Trace Statistics (not including warmup)");
+    for (const auto& stat : stats.sim_trace_stats) {
+      auto sublines = format(stat);
+      lines.emplace_back("");
+      std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+    }
+  }
+
+  if (!std::empty(stats.sim_dvfs_stats)) {
+    lines.emplace_back("");
+    lines.emplace_back("Frequency Statistics (not including warmup)");
+    for (const auto& stat : stats.sim_dvfs_stats) {
+      auto sublines = format(stat);
+      lines.emplace_back("");
+      std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+    }
+  }
+
+  if (!std::empty(stats.sim_energy_stats)) {
+    lines.emplace_back("");
+    lines.emplace_back("Energy Statistics (not including warmup)");
+    lines.emplace_back("");
+    for (const auto& stat : stats.sim_energy_stats) {
+      auto sublines = format(stat);
+      std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+    }
+  }
+
   lines.emplace_back("");
   lines.emplace_back("DRAM Statistics");
   for (const auto& stat : stats.roi_dram_stats) {
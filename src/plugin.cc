@@ -0,0 +1,257 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin.h"
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <dlfcn.h>
+#include <fmt/core.h>
+
+// The plugin only ever sees a pointer to this. Models own it, so that it stays valid when the cache is moved and the model is rebound.
+struct champsim_plugin_cache {
+  CACHE* cache;
+};
+
+namespace
+{
+int service_prefetch_line(champsim_plugin_cache* handle, uint64_t pf_addr, int fill_this_level, uint32_t prefetch_metadata)
+{
+  return handle->cache->prefetch_line(champsim::address{pf_addr}, fill_this_level != 0, prefetch_metadata) ? 1 : 0;
+}
+
+uint32_t service_num_set(const champsim_plugin_cache* handle) { return handle->cache->NUM_SET; }
+uint32_t service_num_way(const champsim_plugin_cache* handle) { return handle->cache->NUM_WAY; }
+uint32_t service_cpu(const champsim_plugin_cache* handle) { return handle->cache->cpu; }
+uint32_t service_offset_bits(const champsim_plugin_cache* handle) { return static_cast<uint32_t>(champsim::to_underlying(handle->cache->OFFSET_BITS)); }
+
+const CACHE::BLOCK& block_at(const champsim_plugin_cache* handle, long set, long way)
+{
+  // Reading through the const array leaves the pages of sets that were never modified unallocated
+  return std::as_const(handle->cache->block).at(static_cast<std::size_t>(set * handle->cache->NUM_WAY + way));
+}
+
+int service_block_valid(const champsim_plugin_cache* handle, long set, long way) { return ::block_at(handle, set, way).valid ? 1 : 0; }
+uint64_t service_block_address(const champsim_plugin_cache* handle, long set, long way) { return champsim::address{::block_at(handle, set, way).address}.to<uint64_t>(); }
+
+const champsim_plugin_services services{CHAMPSIM_PLUGIN_ABI_VERSION, ::service_prefetch_line, ::service_num_set,     ::service_num_way,
+                                        ::service_cpu,                ::service_offset_bits,   ::service_block_valid, ::service_block_address};
+
+uint32_t to_abi(access_type type) { return static_cast<uint32_t>(type); }
+
+void check_version(uint32_t version, std::string_view name)
+{
+  if (version != CHAMPSIM_PLUGIN_ABI_VERSION) {
+    throw std::invalid_argument{fmt::format("The plugin {} was built against version {} of the plugin interface, but this simulator uses version {}", name,
+                                            version, CHAMPSIM_PLUGIN_ABI_VERSION)};
+  }
+}
+
+// The state of a plugin instance, which is created and destroyed through its table
+template <typename VTable>
+class plugin_instance
+{
+  const VTable* vtable_;
+  champsim_plugin_cache handle_;
+  void* self_;
+
+public:
+  plugin_instance(const VTable* vtable, CACHE* cache)
+      : vtable_(vtable), handle_{cache}, self_(vtable_->create != nullptr ? vtable_->create(&::services, &handle_) : nullptr)
+  {
+  }
+
+  ~plugin_instance()
+  {
+    if (vtable_->destroy != nullptr) {
+      vtable_->destroy(self_);
+    }
+  }
+
+  plugin_instance(const plugin_instance&) = delete;
+  plugin_instance& operator=(const plugin_instance&) = delete;
+  plugin_instance(plugin_instance&&) = delete;
+  plugin_instance& operator=(plugin_instance&&) = delete;
+
+  void bind(CACHE* cache) { handle_.cache = cache; }
+
+  // Call the hook if the plugin has one, or return the fallback value
+  template <typename R, typename... Args, typename... Ts>
+  R call(R (*VTable::*hook)(void*, Args...), R fallback, Ts&&... args)
+  {
+    if (auto fn = vtable_->*hook; fn != nullptr) {
+      return fn(self_, std::forward<Ts>(args)...);
+    }
+    return fallback;
+  }
+
+  template <typename... Args, typename... Ts>
+  void call(void (*VTable::*hook)(void*, Args...), Ts&&... args)
+  {
+    if (auto fn = vtable_->*hook; fn != nullptr) {
+      fn(self_, std::forward<Ts>(args)...);
+    }
+  }
+};
+
+struct prefetcher_model final : CACHE::prefetcher_module_concept {
+  using vtable_type = champsim_prefetcher_plugin_vtable;
+  plugin_instance<vtable_type> instance;
+
+  prefetcher_model(const vtable_type* vtable, CACHE* cache) : instance(vtable, cache) {}
+
+  void bind(CACHE* cache) final { instance.bind(cache); }
+
+  void impl_prefetcher_initialize() final { instance.call(&vtable_type::initialize); }
+
+  uint32_t impl_prefetcher_cache_operate(champsim::address addr, champsim::address ip, bool cache_hit, bool useful_prefetch, access_type type,
+                                         uint32_t metadata_in) final
+  {
+    return instance.call(&vtable_type::cache_operate, metadata_in, addr.to<uint64_t>(), ip.to<uint64_t>(), int{cache_hit}, int{useful_prefetch},
+                         ::to_abi(type), metadata_in);
+  }
+
+  uint32_t impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr, uint32_t metadata_in) final
+  {
+    return instance.call(&vtable_type::cache_fill, metadata_in, addr.to<uint64_t>(), set, way, int{prefetch}, evicted_addr.to<uint64_t>(), metadata_in);
+  }
+
+  void impl_prefetcher_cycle_operate() final { instance.call(&vtable_type::cycle_operate); }
+  void impl_prefetcher_final_stats() final { instance.call(&vtable_type::final_stats); }
+
+  void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) final
+  {
+    instance.call(&vtable_type::branch_operate, ip.to<uint64_t>(), branch_type, branch_target.to<uint64_t>());
+  }
+};
+
+struct replacement_model final : CACHE::replacement_module_concept {
+  using vtable_type = champsim_replacement_plugin_vtable;
+  plugin_instance<vtable_type> instance;
+
+  replacement_model(const vtable_type* vtable, CACHE* cache) : instance(vtable, cache) {}
+
+  void bind(CACHE* cache) final { instance.bind(cache); }
+
+  void impl_initialize_replacement() final { instance.call(&vtable_type::initialize); }
+
+  long impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const CACHE::BLOCK* /*current_set*/, champsim::address ip,
+                        champsim::address full_addr, access_type type) final
+  {
+    return instance.call(&vtable_type::find_victim, 0L, triggering_cpu, instr_id, set, ip.to<uint64_t>(), full_addr.to<uint64_t>(), ::to_abi(type));
+  }
+
+  void impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                     champsim::address victim_addr, access_type type, bool hit) final
+  {
+    instance.call(&vtable_type::update_replacement_state, triggering_cpu, set, way, full_addr.to<uint64_t>(), ip.to<uint64_t>(), victim_addr.to<uint64_t>(),
+                  ::to_abi(type), int{hit});
+  }
+
+  void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                   champsim::address victim_addr, access_type type) final
+  {
+    instance.call(&vtable_type::cache_fill, triggering_cpu, set, way, full_addr.to<uint64_t>(), ip.to<uint64_t>(), victim_addr.to<uint64_t>(), ::to_abi(type));
+  }
+
+  void impl_replacement_final_stats() final { instance.call(&vtable_type::final_stats); }
+};
+
+// Each shared object is opened once, and stays open for as long as modules created from it may exist
+const champsim::plugin::library& open_library(const std::string& path)
+{
+  static std::mutex libraries_mutex;
+  static std::map<std::string, champsim::plugin::library, std::less<>> libraries;
+
+  std::lock_guard lock{libraries_mutex};
+  auto found = libraries.find(path);
+  if (found == std::end(libraries)) {
+    found = libraries.emplace(path, champsim::plugin::library{path}).first;
+  }
+  return found->second;
+}
+
+template <typename Entry>
+auto load_entry(const std::string& path, const char* entry_name, std::string_view kind)
+{
+  auto entry = reinterpret_cast<Entry>(::open_library(path).symbol(entry_name)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast): dlsym returns void*
+  if (entry == nullptr) {
+    throw std::invalid_argument{fmt::format("The plugin {} does not export a {} ({} was not found)", path, kind, entry_name)};
+  }
+
+  auto vtable = entry();
+  if (vtable == nullptr) {
+    throw std::invalid_argument{fmt::format("The plugin {} did not provide a {}", path, kind)};
+  }
+  ::check_version(vtable->abi_version, path);
+  return vtable;
+}
+} // namespace
+
+champsim::plugin::library::library(std::string path_) : path(std::move(path_)), handle(dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL))
+{
+  if (handle == nullptr) {
+    throw std::runtime_error{fmt::format("Could not open plugin {}: {}", path, dlerror())};
+  }
+}
+
+champsim::plugin::library::~library()
+{
+  if (handle != nullptr) {
+    dlclose(handle);
+  }
+}
+
+champsim::plugin::library::library(library&& other) noexcept : path(std::move(other.path)), handle(std::exchange(other.handle, nullptr)) {}
+
+auto champsim::plugin::library::operator=(library&& other) noexcept -> library&
+{
+  std::swap(path, other.path);
+  std::swap(handle, other.handle);
+  return *this;
+}
+
+void* champsim::plugin::library::symbol(const char* name) const { return dlsym(handle, name); }
+
+bool champsim::plugin::is_plugin_name(std::string_view name)
+{
+  constexpr std::string_view suffix{".so"};
+  return std::size(name) > std::size(suffix) && name.substr(std::size(name) - std::size(suffix)) == suffix;
+}
+
+const champsim_prefetcher_plugin_vtable* champsim::plugin::load_prefetcher(const std::string& path)
+{
+  return ::load_entry<champsim_prefetcher_plugin_entry>(path, "champsim_prefetcher_plugin", "prefetcher");
+}
+
+const champsim_replacement_plugin_vtable* champsim::plugin::load_replacement(const std::string& path)
+{
+  return ::load_entry<champsim_replacement_plugin_entry>(path, "champsim_replacement_plugin", "replacement policy");
+}
+
+std::unique_ptr<CACHE::prefetcher_module_concept> champsim::plugin::make_prefetcher(const champsim_prefetcher_plugin_vtable* vtable, CACHE* cache)
+{
+  ::check_version(vtable->abi_version, "prefetcher");
+  return std::make_unique<::prefetcher_model>(vtable, cache);
+}
+
+std::unique_ptr<CACHE::replacement_module_concept> champsim::plugin::make_replacement(const champsim_replacement_plugin_vtable* vtable, CACHE* cache)
+{
+  ::check_version(vtable->abi_version, "replacement policy");
+  return std::make_unique<::replacement_model>(vtable, cache);
+}
@@ -25,6 +25,7 @@
 #include "deadlock.h"
 #include "instruction.h"
 #include "ptw_builder.h" // for ptw_builder
+#include "replay_log.h"
 #include "util/bits.h"   // for bitmask, lg2, splice_bits
 #include "util/span.h"
 #include "vmem.h"
@@ -111,7 +112,7 @@ auto PageTableWalker::step_translation(const mshr_type& source) -> std::optional
   packet.is_translated = true;
   packet.type = access_type::TRANSLATION;
 
-  bool success = lower_level->add_rq(packet);
+  bool success = lower_level->add_rq(std::move(packet));
   if (success) {
     return source;
   }
@@ -218,6 +219,13 @@ void PageTableWalker::finish_packet(const response_type& packet)
     mshr_entry.data = is_last_step(mshr_entry) ? finish_step(mshr_entry) : finish_last_step(mshr_entry);
   });
 
+  if (replay_chain != nullptr) {
+    std::for_each(std::begin(MSHR), last_finished, [chain = replay_chain](const auto& mshr_entry) {
+      chain->add(champsim::replay::event::walk_step, mshr_entry.v_address.template to<uint64_t>());
+      chain->add(champsim::replay::event::walk_step, static_cast<uint64_t>(mshr_entry.translation_level));
+    });
+  }
+
   std::partition_copy(std::begin(MSHR), last_finished, std::back_inserter(finished), std::back_inserter(completed), is_last_step);
   MSHR.erase(std::begin(MSHR), last_finished);
 }
@@ -232,6 +240,11 @@ void PageTableWalker::begin_phase()
   }
 }
 
+void PageTableWalker::clock_period_changed(champsim::chrono::picoseconds old_period)
+{
+  HIT_LATENCY = champsim::rescale_latency(HIT_LATENCY, old_period, clock_period);
+}
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void PageTableWalker::print_deadlock()
 {
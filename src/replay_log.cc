@@ -0,0 +1,182 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "replay_log.h"
+
+#include <array>
+#include <cstring>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <fmt/core.h>
+
+#include "operable.h"
+
+namespace
+{
+constexpr char component_tag = 'C';
+constexpr char record_tag = 'R';
+constexpr uint64_t chain_seed = 0xcbf29ce484222325ULL;
+
+// A SplitMix64-style mixer, which is cheap and spreads every input bit over the whole chain value
+uint64_t mix(uint64_t hash, uint64_t value)
+{
+  hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  return hash ^ (hash >> 31);
+}
+
+template <typename T>
+void put(std::ostream& out, T value)
+{
+  std::array<char, sizeof(T)> bytes{};
+  std::memcpy(std::data(bytes), &value, sizeof(T));
+  out.write(std::data(bytes), std::size(bytes));
+}
+
+template <typename T>
+bool get(std::istream& in, T& value)
+{
+  std::array<char, sizeof(T)> bytes{};
+  if (!in.read(std::data(bytes), std::size(bytes))) {
+    return false;
+  }
+  std::memcpy(&value, std::data(bytes), sizeof(T));
+  return true;
+}
+
+struct log_record {
+  uint32_t id = 0;
+  int64_t time = 0;
+  uint64_t cycle = 0;
+  uint64_t hash = 0;
+  uint32_t events = 0;
+};
+
+// Read entries until the next record, collecting component declarations along the way
+std::optional<log_record> next_record(std::istream& in, std::map<uint32_t, std::string>& names)
+{
+  char tag{};
+  while (in.get(tag)) {
+    if (tag == component_tag) {
+      uint32_t id = 0;
+      uint32_t length = 0;
+      if (!get(in, id) || !get(in, length)) {
+        return std::nullopt;
+      }
+      std::string name(length, '\0');
+      in.read(std::data(name), length);
+      names[id] = name;
+    } else if (tag == record_tag) {
+      log_record rec;
+      if (get(in, rec.id) && get(in, rec.time) && get(in, rec.cycle) && get(in, rec.hash) && get(in, rec.events)) {
+        return rec;
+      }
+      return std::nullopt;
+    } else {
+      throw std::invalid_argument{"Malformed replay log"};
+    }
+  }
+  return std::nullopt;
+}
+
+std::string name_of(const std::map<uint32_t, std::string>& names, uint32_t id)
+{
+  if (auto found = names.find(id); found != std::end(names)) {
+    return found->second;
+  }
+  return fmt::format("component {}", id);
+}
+} // namespace
+
+champsim::replay::chain::chain(log* owner_, uint32_t id_) : owner(owner_), id(id_), hash(::mix(::chain_seed, id_)) {}
+
+void champsim::replay::chain::add(event kind, uint64_t value)
+{
+  hash = ::mix(::mix(hash, static_cast<uint64_t>(kind)), value);
+  ++events;
+}
+
+void champsim::replay::chain::end_cycle(champsim::chrono::clock::time_point now, uint64_t cycle)
+{
+  if (events == 0) {
+    return;
+  }
+
+  owner->out.put(::record_tag);
+  ::put(owner->out, id);
+  ::put(owner->out, static_cast<int64_t>(now.time_since_epoch().count()));
+  ::put(owner->out, cycle);
+  ::put(owner->out, hash);
+  ::put(owner->out, events);
+  events = 0;
+}
+
+champsim::replay::log::log(std::ostream& stream) : out(stream) {}
+
+void champsim::replay::log::attach(champsim::operable& op, const std::string& name)
+{
+  auto id = static_cast<uint32_t>(std::size(chains));
+  op.replay_chain = chains.emplace_back(std::make_unique<chain>(this, id)).get();
+
+  out.put(::component_tag);
+  ::put(out, id);
+  ::put(out, static_cast<uint32_t>(std::size(name)));
+  out.write(std::data(name), static_cast<std::streamsize>(std::size(name)));
+}
+
+auto champsim::replay::find_divergence(std::istream& lhs, std::istream& rhs) -> std::optional<divergence>
+{
+  std::map<uint32_t, std::string> lhs_names;
+  std::map<uint32_t, std::string> rhs_names;
+
+  // Both simulations emit records in the same order until they diverge, so the logs can be compared in lockstep
+  while (true) {
+    auto lhs_rec = ::next_record(lhs, lhs_names);
+    auto rhs_rec = ::next_record(rhs, rhs_names);
+
+    if (lhs_names != rhs_names) {
+      return divergence{"", 0, "the logs contain different components"};
+    }
+
+    if (!lhs_rec.has_value() && !rhs_rec.has_value()) {
+      return std::nullopt;
+    }
+    if (!lhs_rec.has_value()) {
+      return divergence{::name_of(rhs_names, rhs_rec->id), rhs_rec->cycle, "the first log ends before this cycle"};
+    }
+    if (!rhs_rec.has_value()) {
+      return divergence{::name_of(lhs_names, lhs_rec->id), lhs_rec->cycle, "the second log ends before this cycle"};
+    }
+
+    if (lhs_rec->id != rhs_rec->id || lhs_rec->time != rhs_rec->time) {
+      // One simulation observed events where the other did not. Report whichever happened first.
+      if (rhs_rec->time < lhs_rec->time) {
+        return divergence{::name_of(rhs_names, rhs_rec->id), rhs_rec->cycle, "only the second log has events in this cycle"};
+      }
+      return divergence{::name_of(lhs_names, lhs_rec->id), lhs_rec->cycle, "only the first log has events in this cycle"};
+    }
+
+    if (lhs_rec->events != rhs_rec->events) {
+      return divergence{::name_of(lhs_names, lhs_rec->id), lhs_rec->cycle, fmt::format("{} events versus {} events", lhs_rec->events, rhs_rec->events)};
+    }
+
+    if (lhs_rec->hash != rhs_rec->hash) {
+      return divergence{::name_of(lhs_names, lhs_rec->id), lhs_rec->cycle, "the events differ"};
+    }
+  }
+}
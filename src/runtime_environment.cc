@@ -0,0 +1,397 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime_environment.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+#include "defaults.hpp"
+#include "module_registry.h"
+
+namespace
+{
+using json = nlohmann::json;
+
+// A connection between an element and the element below it, which is served by one channel
+struct link {
+  std::string lower;
+  std::string upper;
+};
+
+template <typename T>
+T as(const json& value)
+{
+  if constexpr (std::is_enum_v<T>) {
+    return T{value.get<std::underlying_type_t<T>>()};
+  } else if constexpr (std::is_same_v<T, champsim::data::bytes>) {
+    return T{value.get<long long>()};
+  } else {
+    return value.get<T>();
+  }
+}
+
+// Apply a builder parameter only if the configuration gives it, so that the builder's default is kept otherwise
+template <typename Builder, typename Arg>
+void set_if_present(Builder& builder, Builder& (Builder::*setter)(Arg), const json& element, const char* key)
+{
+  if (auto it = element.find(key); it != std::end(element) && !it->is_null()) {
+    (builder.*setter)(::as<std::decay_t<Arg>>(*it));
+  }
+}
+
+bool has_key(const json& element, const char* key) { return element.contains(key) && !element.at(key).is_null(); }
+
+champsim::core_model core_model_of(const std::string& name)
+{
+  if (name == "out_of_order") {
+    return champsim::core_model::out_of_order;
+  }
+  if (name == "interval") {
+    return champsim::core_model::interval;
+  }
+  throw std::invalid_argument{fmt::format("Unknown core model {}. The core model must be \"out_of_order\" or \"interval\"", name)};
+}
+
+champsim::chrono::picoseconds clock_period_of(double frequency) { return champsim::chrono::picoseconds{static_cast<std::intmax_t>(1000000 / frequency)}; }
+
+const json* find_named(const json& elements, const std::string& name)
+{
+  auto found = std::find_if(std::begin(elements), std::end(elements), [&name](const json& elem) { return elem.at("name").get<std::string>() == name; });
+  return (found == std::end(elements)) ? nullptr : &*found;
+}
+
+// The links are listed in the same order as the configuration system lists them
+std::vector<link> get_links(const json& config)
+{
+  std::vector<link> retval;
+  auto add_links = [&](const json& elements, const char* key) {
+    for (const auto& elem : elements) {
+      if (::has_key(elem, key)) {
+        retval.push_back({elem.at(key).get<std::string>(), elem.at("name").get<std::string>()});
+      }
+    }
+  };
+
+  add_links(config.at("ptws"), "lower_level");
+  add_links(config.at("caches"), "lower_level");
+  add_links(config.at("caches"), "lower_translate");
+  add_links(config.at("cores"), "L1I");
+  add_links(config.at("cores"), "L1D");
+  return retval;
+}
+
+champsim::channel make_channel(const json& config, const link& l)
+{
+  if (const auto* cache = ::find_named(config.at("caches"), l.lower); cache != nullptr) {
+    auto factor = cache->at("queue_factor").get<std::size_t>();
+    return champsim::channel{cache->value("rq_size", factor), cache->value("pq_size", factor), cache->value("wq_size", factor),
+                             champsim::data::bits{cache->at("offset_bits").get<uint64_t>()}, cache->value("queue_check_full_addr", false)};
+  }
+
+  if (const auto* ptw = ::find_named(config.at("ptws"), l.lower); ptw != nullptr) {
+    return champsim::channel{ptw->value("rq_size", ptw->at("queue_factor").get<std::size_t>()), 0, 0, champsim::data::bits{LOG2_PAGE_SIZE}, false};
+  }
+
+  if (config.at("pmem").at("name").get<std::string>() == l.lower) {
+    constexpr auto unbounded = std::numeric_limits<std::size_t>::max();
+    return champsim::channel{unbounded, unbounded, unbounded, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+  }
+
+  throw std::invalid_argument{fmt::format("{} is connected to {}, but no element named {} is defined", l.upper, l.lower, l.lower)};
+}
+
+std::vector<std::string> module_names(const json& element, const char* key, const char* fallback)
+{
+  if (!::has_key(element, key)) {
+    return {fallback};
+  }
+  if (element.at(key).is_string()) {
+    return {element.at(key).get<std::string>()};
+  }
+  return element.at(key).get<std::vector<std::string>>();
+}
+
+// Replace the empty module that the element was built with, if the configuration names one
+template <typename Concept, typename Owner, typename Factory>
+void select_module(std::unique_ptr<Concept>& pimpl, Owner* owner, const json& element, const char* key, const char* fallback, Factory&& make)
+{
+  auto names = ::module_names(element, key, fallback);
+  if (std::size(names) > 1) {
+    throw std::invalid_argument{fmt::format("{} lists {} modules for '{}', but a runtime configuration may select only one", element.at("name").get<std::string>(),
+                                            std::size(names), key)};
+  }
+  if (!std::empty(names)) {
+    pimpl = make(names.front(), owner);
+  }
+}
+
+auto default_cache_builder(const std::string& name)
+{
+  using namespace champsim::defaults;
+  const std::array<std::pair<std::string_view, const std::decay_t<decltype(default_llc)>*>, 7> defaults{
+      {{"l1i", &default_l1i}, {"l1d", &default_l1d}, {"l2c", &default_l2c}, {"itlb", &default_itlb}, {"dtlb", &default_dtlb}, {"stlb", &default_stlb}, {"llc", &default_llc}}};
+
+  std::decay_t<decltype(default_llc)> retval{};
+  if (!std::empty(name)) {
+    auto found = std::find_if(std::begin(defaults), std::end(defaults), [&name](const auto& entry) { return entry.first == name; });
+    if (found == std::end(defaults)) {
+      throw std::invalid_argument{fmt::format("There are no cache defaults named {}", name)};
+    }
+    retval = *found->second;
+  }
+
+  // The modules are selected after the cache is built
+  return retval.prefetcher<>().replacement<>();
+}
+
+std::vector<access_type> prefetch_activate_mask(const json& names)
+{
+  std::vector<access_type> retval;
+  for (const auto& name : names) {
+    auto found = std::find(std::begin(access_type_names), std::end(access_type_names), name.get<std::string>());
+    if (found == std::end(access_type_names)) {
+      throw std::invalid_argument{fmt::format("{} is not an access type", name.get<std::string>())};
+    }
+    retval.push_back(static_cast<access_type>(std::distance(std::begin(access_type_names), found)));
+  }
+  return retval;
+}
+} // namespace
+
+champsim::runtime_environment::runtime_environment(const nlohmann::json& config)
+{
+  if (std::size(config.at("cores")) != NUM_CPUS) {
+    throw std::invalid_argument{fmt::format("The configuration has {} cores, but this simulator was built for {}", std::size(config.at("cores")), NUM_CPUS)};
+  }
+  if (config.value("block_size", BLOCK_SIZE) != BLOCK_SIZE || config.value("page_size", PAGE_SIZE) != PAGE_SIZE) {
+    throw std::invalid_argument{fmt::format("The configuration's block and page sizes do not match this simulator's ({} and {})", BLOCK_SIZE, PAGE_SIZE)};
+  }
+
+  const auto links = ::get_links(config);
+  std::transform(std::begin(links), std::end(links), std::back_inserter(channels), [&config](const auto& l) { return ::make_channel(config, l); });
+
+  auto channel_for = [&](const std::string& lower, const std::string& upper) {
+    auto found = std::find_if(std::begin(links), std::end(links), [&](const auto& l) { return l.lower == lower && l.upper == upper; });
+    return &channels.at(static_cast<std::size_t>(std::distance(std::begin(links), found)));
+  };
+  auto upper_levels_of = [&](const std::string& lower) {
+    std::vector<champsim::channel*> retval;
+    for (std::size_t i = 0; i < std::size(links); ++i) {
+      if (links.at(i).lower == lower) {
+        retval.push_back(&channels.at(i));
+      }
+    }
+    return retval;
+  };
+
+  // Physical memory
+  const auto& pmem = config.at("pmem");
+  const auto pmem_name = pmem.at("name").get<std::string>();
+  auto bank_columns = ::has_key(pmem, "columns") ? 8 * pmem.at("columns").get<std::size_t>() : pmem.at("bank_columns").get<std::size_t>();
+  DRAM.emplace(::clock_period_of(pmem.at("data_rate").get<double>()), ::clock_period_of(pmem.at("frequency").get<double>()), pmem.at("tRP").get<std::size_t>(),
+               pmem.at("tRCD").get<std::size_t>(), pmem.at("tCAS").get<std::size_t>(), pmem.at("tRAS").get<std::size_t>(),
+               champsim::chrono::microseconds{static_cast<long long>(1000 * pmem.at("refresh_period").get<double>())}, upper_levels_of(pmem_name),
+               pmem.at("rq_size").get<std::size_t>(), pmem.at("wq_size").get<std::size_t>(), pmem.at("channels").get<std::size_t>(),
+               champsim::data::bytes{pmem.at("channel_width").get<long long>()}, pmem.at("bank_rows").get<std::size_t>(), bank_columns,
+               pmem.at("ranks").get<std::size_t>(), pmem.at("bankgroups").get<std::size_t>(), pmem.at("banks").get<std::size_t>(),
+               pmem.at("refreshes_per_period").get<std::size_t>());
+  if (::has_key(pmem, "bandwidth_allocation")) {
+    std::vector<MEMORY_CONTROLLER::core_allocation> allocations;
+    for (const auto& alloc : pmem.at("bandwidth_allocation")) {
+      allocations.push_back({alloc.value("percent", 100u), alloc.value("priority", 0u)});
+    }
+    DRAM->set_allocations(std::move(allocations));
+  }
+
+  // Virtual memory, whose penalty is given in cycles of the fastest clock
+  double max_frequency = pmem.at("frequency").get<double>();
+  for (const auto* kind : {"cores", "caches", "ptws"}) {
+    for (const auto& elem : config.at(kind)) {
+      max_frequency = std::max(max_frequency, elem.at("frequency").get<double>());
+    }
+  }
+  const auto& vmem_config = config.at("vmem");
+  std::optional<uint64_t> randomization{};
+  if (const auto& rand = vmem_config.at("randomization"); !rand.is_boolean() || rand.get<bool>()) {
+    randomization = rand.is_boolean() ? 1 : rand.get<uint64_t>();
+  }
+  vmem.emplace(champsim::data::bytes{vmem_config.at("pte_page_size").get<long long>()}, vmem_config.at("num_levels").get<std::size_t>(),
+               ::clock_period_of(max_frequency) * vmem_config.at("minor_fault_penalty").get<long long>(), *DRAM, randomization);
+
+  // Page table walkers
+  for (const auto& ptw : config.at("ptws")) {
+    const auto& name = ptw.at("name").get_ref<const std::string&>();
+    champsim::ptw_builder builder{champsim::defaults::default_ptw};
+    builder.name(name).upper_levels(upper_levels_of(name)).virtual_memory(&*vmem);
+    ::set_if_present(builder, &champsim::ptw_builder::cpu, ptw, "cpu");
+    if (::has_key(ptw, "lower_level")) {
+      builder.lower_level(channel_for(ptw.at("lower_level").get<std::string>(), name));
+    }
+    ::set_if_present(builder, &champsim::ptw_builder::mshr_size, ptw, "mshr_size");
+    ::set_if_present(builder, &champsim::ptw_builder::tag_bandwidth, ptw, "max_read");
+    ::set_if_present(builder, &champsim::ptw_builder::fill_bandwidth, ptw, "max_write");
+    if (::has_key(ptw, "frequency")) {
+      builder.clock_period(::clock_period_of(ptw.at("frequency").get<double>()));
+    }
+    for (uint8_t level = 5; level > 1; --level) {
+      if (auto set_key = fmt::format("pscl{}_set", level); ::has_key(ptw, set_key.c_str())) {
+        builder.add_pscl(level, ptw.at(set_key).get<uint32_t>(), ptw.at(fmt::format("pscl{}_way", level)).get<uint32_t>());
+      }
+    }
+    ptws.emplace_back(builder);
+  }
+
+  // Caches
+  for (const auto& cache : config.at("caches")) {
+    const auto name = cache.at("name").get<std::string>();
+    auto builder = ::default_cache_builder(cache.value("defaults", std::string{}));
+    builder.name(name).upper_levels(upper_levels_of(name));
+
+    using builder_type = decltype(builder);
+    ::set_if_present(builder, &builder_type::size, cache, "size");
+    ::set_if_present(builder, &builder_type::log2_size, cache, "log2_size");
+    ::set_if_present(builder, &builder_type::sets, cache, "sets");
+    ::set_if_present(builder, &builder_type::log2_sets, cache, "log2_sets");
+    ::set_if_present(builder, &builder_type::ways, cache, "ways");
+    ::set_if_present(builder, &builder_type::log2_ways, cache, "log2_ways");
+    ::set_if_present(builder, &builder_type::pq_size, cache, "pq_size");
+    ::set_if_present(builder, &builder_type::mshr_size, cache, "mshr_size");
+    ::set_if_present(builder, &builder_type::latency, cache, "latency");
+    ::set_if_present(builder, &builder_type::hit_latency, cache, "hit_latency");
+    ::set_if_present(builder, &builder_type::fill_latency, cache, "fill_latency");
+    ::set_if_present(builder, &builder_type::tag_bandwidth, cache, "max_tag_check");
+    ::set_if_present(builder, &builder_type::fill_bandwidth, cache, "max_fill");
+    ::set_if_present(builder, &builder_type::offset_bits, cache, "offset_bits");
+    ::set_if_present(builder, &builder_type::set_sample_mask, cache, "set_sample_mask");
+    if (::has_key(cache, "prefetch_activate")) {
+      builder.prefetch_activate(::prefetch_activate_mask(cache.at("prefetch_activate")));
+    }
+    if (::has_key(cache, "lower_translate")) {
+      builder.lower_translate(channel_for(cache.at("lower_translate").get<std::string>(), name));
+    }
+    if (::has_key(cache, "lower_level")) {
+      builder.lower_level(channel_for(cache.at("lower_level").get<std::string>(), name));
+    }
+    if (::has_key(cache, "frequency")) {
+      builder.clock_period(::clock_period_of(cache.at("frequency").get<double>()));
+    }
+    if (::has_key(cache, "prefetch_as_load")) {
+      cache.at("prefetch_as_load").get<bool>() ? builder.set_prefetch_as_load() : builder.reset_prefetch_as_load();
+    }
+    if (::has_key(cache, "wq_check_full_addr")) {
+      cache.at("wq_check_full_addr").get<bool>() ? builder.set_wq_checks_full_addr() : builder.reset_wq_checks_full_addr();
+    }
+    if (::has_key(cache, "virtual_prefetch")) {
+      cache.at("virtual_prefetch").get<bool>() ? builder.set_virtual_prefetch() : builder.reset_virtual_prefetch();
+    }
+
+    auto& built = caches.emplace_back(builder);
+    ::select_module(built.pref_module_pimpl, &built, cache, "prefetcher", "no", champsim::modules::registry::make_prefetcher);
+    ::select_module(built.repl_module_pimpl, &built, cache, "replacement", "lru", champsim::modules::registry::make_replacement);
+  }
+
+  // Cores
+  auto cache_named = [this](const std::string& name) -> CACHE& {
+    auto found = std::find_if(std::begin(caches), std::end(caches), [&name](const CACHE& c) { return c.NAME == name; });
+    if (found == std::end(caches)) {
+      throw std::invalid_argument{fmt::format("No cache named {} is defined", name)};
+    }
+    return *found;
+  };
+  for (const auto& cpu : config.at("cores")) {
+    const auto name = cpu.at("name").get<std::string>();
+    auto builder = champsim::core_builder{champsim::defaults::default_core}.branch_predictor<>().btb<>();
+
+    using builder_type = decltype(builder);
+    ::set_if_present(builder, &builder_type::ifetch_buffer_size, cpu, "ifetch_buffer_size");
+    ::set_if_present(builder, &builder_type::decode_buffer_size, cpu, "decode_buffer_size");
+    ::set_if_present(builder, &builder_type::dispatch_buffer_size, cpu, "dispatch_buffer_size");
+    ::set_if_present(builder, &builder_type::register_file_size, cpu, "register_file_size");
+    ::set_if_present(builder, &builder_type::rob_size, cpu, "rob_size");
+    ::set_if_present(builder, &builder_type::lq_size, cpu, "lq_size");
+    ::set_if_present(builder, &builder_type::sq_size, cpu, "sq_size");
+    ::set_if_present(builder, &builder_type::fetch_width, cpu, "fetch_width");
+    ::set_if_present(builder, &builder_type::decode_width, cpu, "decode_width");
+    ::set_if_present(builder, &builder_type::dispatch_width, cpu, "dispatch_width");
+    ::set_if_present(builder, &builder_type::schedule_width, cpu, "scheduler_size");
+    ::set_if_present(builder, &builder_type::execute_width, cpu, "execute_width");
+    ::set_if_present(builder, &builder_type::lq_width, cpu, "lq_width");
+    ::set_if_present(builder, &builder_type::sq_width, cpu, "sq_width");
+    ::set_if_present(builder, &builder_type::retire_width, cpu, "retire_width");
+    ::set_if_present(builder, &builder_type::mispredict_penalty, cpu, "mispredict_penalty");
+    ::set_if_present(builder, &builder_type::decode_latency, cpu, "decode_latency");
+    ::set_if_present(builder, &builder_type::dispatch_latency, cpu, "dispatch_latency");
+    ::set_if_present(builder, &builder_type::schedule_latency, cpu, "schedule_latency");
+    ::set_if_present(builder, &builder_type::execute_latency, cpu, "execute_latency");
+    ::set_if_present(builder, &builder_type::dib_set, cpu, "dib_set");
+    ::set_if_present(builder, &builder_type::dib_way, cpu, "dib_way");
+    ::set_if_present(builder, &builder_type::dib_window, cpu, "dib_window");
+    ::set_if_present(builder, &builder_type::index, cpu, "index");
+    if (::has_key(cpu, "L1I")) {
+      auto& l1i = cache_named(cpu.at("L1I").get<std::string>());
+      builder.l1i(&l1i).l1i_bandwidth(l1i.MAX_TAG).fetch_queues(channel_for(l1i.NAME, name));
+    }
+    if (::has_key(cpu, "L1D")) {
+      auto& l1d = cache_named(cpu.at("L1D").get<std::string>());
+      builder.l1d_bandwidth(l1d.MAX_TAG).data_queues(channel_for(l1d.NAME, name));
+    }
+    if (::has_key(cpu, "model")) {
+      builder.model(::core_model_of(cpu.at("model").get<std::string>()));
+    }
+    if (::has_key(cpu, "core_type")) {
+      builder.core_type(cpu.at("core_type").get<std::string>());
+    }
+    if (::has_key(cpu, "frequency")) {
+      builder.clock_period(::clock_period_of(cpu.at("frequency").get<double>()));
+    }
+    if (::has_key(cpu, "DIB")) {
+      const auto& dib = cpu.at("DIB");
+      ::set_if_present(builder, &builder_type::dib_set, dib, "sets");
+      ::set_if_present(builder, &builder_type::dib_way, dib, "ways");
+      ::set_if_present(builder, &builder_type::dib_window, dib, "window_size");
+    }
+
+    auto& built = cores.emplace_back(builder);
+    ::select_module(built.branch_module_pimpl, &built, cpu, "branch_predictor", "hashed_perceptron", champsim::modules::registry::make_branch_predictor);
+    ::select_module(built.btb_module_pimpl, &built, cpu, "btb", "basic_btb", champsim::modules::registry::make_btb);
+  }
+}
+
+std::vector<std::reference_wrapper<O3_CPU>> champsim::runtime_environment::cpu_view() { return {std::begin(cores), std::end(cores)}; }
+
+std::vector<std::reference_wrapper<CACHE>> champsim::runtime_environment::cache_view() { return {std::begin(caches), std::end(caches)}; }
+
+std::vector<std::reference_wrapper<PageTableWalker>> champsim::runtime_environment::ptw_view() { return {std::begin(ptws), std::end(ptws)}; }
+
+MEMORY_CONTROLLER& champsim::runtime_environment::dram_view() { return *DRAM; }
+
+std::vector<std::reference_wrapper<champsim::operable>> champsim::runtime_environment::operable_view()
+{
+  std::vector<std::reference_wrapper<champsim::operable>> retval{};
+  auto make_ref = [](auto& x) { return std::ref<champsim::operable>(x); };
+  std::transform(std::begin(cores), std::end(cores), std::back_inserter(retval), make_ref);
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(retval), make_ref);
+  std::transform(std::begin(ptws), std::end(ptws), std::back_inserter(retval), make_ref);
+  retval.push_back(std::ref<champsim::operable>(*DRAM));
+  return retval;
+}
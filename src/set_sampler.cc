@@ -0,0 +1,41 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "set_sampler.h"
+
+champsim::set_sampler::set_sampler(long sets, uint64_t mask) : m_mask(mask), m_sample_index(static_cast<std::size_t>(sets), -1)
+{
+  for (long set = 0; set < sets; ++set) {
+    if (is_sampled(set)) {
+      m_sample_index.at(static_cast<std::size_t>(set)) = m_sampled_sets++;
+    }
+  }
+}
+
+void champsim::set_sampler::record_latency(champsim::chrono::clock::duration latency)
+{
+  m_total_latency += latency;
+  ++m_accesses;
+}
+
+auto champsim::set_sampler::average_latency(champsim::chrono::clock::duration fallback) const -> champsim::chrono::clock::duration
+{
+  if (m_accesses == 0) {
+    return fallback;
+  }
+  return m_total_latency / m_accesses;
+}
@@ -0,0 +1,75 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "startup.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <thread>
+#include <fmt/core.h>
+
+std::vector<champsim::startup_time> champsim::initialize(environment& env, unsigned threads)
+{
+  std::map<const operable*, std::string> names;
+  for (O3_CPU& cpu : env.cpu_view()) {
+    names.try_emplace(&cpu, fmt::format("cpu{}", cpu.cpu));
+  }
+  for (CACHE& cache : env.cache_view()) {
+    names.try_emplace(&cache, cache.NAME);
+  }
+  for (PageTableWalker& ptw : env.ptw_view()) {
+    names.try_emplace(&ptw, ptw.NAME);
+  }
+  names.try_emplace(&env.dram_view(), "DRAM");
+
+  auto operables = env.operable_view();
+  std::vector<startup_time> result;
+  std::transform(std::cbegin(operables), std::cend(operables), std::back_inserter(result), [&names, i = std::size_t{0}](const operable& op) mutable {
+    auto found = names.find(&op);
+    auto name = (found != std::end(names)) ? found->second : fmt::format("component {}", i);
+    ++i;
+    return startup_time{name, {}};
+  });
+
+  std::vector<std::exception_ptr> failures(std::size(operables));
+  std::atomic<std::size_t> next{0};
+  auto worker = [&]() {
+    for (auto idx = next++; idx < std::size(operables); idx = next++) {
+      auto begin = std::chrono::steady_clock::now();
+      try {
+        operables[idx].get().initialize();
+      } catch (...) {
+        failures[idx] = std::current_exception();
+      }
+      result[idx].elapsed = std::chrono::steady_clock::now() - begin;
+    }
+  };
+
+  // The calling thread is one of the workers, so a single thread initializes everything in order
+  std::vector<std::thread> helpers;
+  auto helper_count = std::min(std::max<std::size_t>(threads, 1), std::max<std::size_t>(std::size(operables), 1)) - 1;
+  std::generate_n(std::back_inserter(helpers), helper_count, [&worker]() { return std::thread{worker}; });
+  worker();
+  std::for_each(std::begin(helpers), std::end(helpers), [](auto& t) { t.join(); });
+
+  if (auto failure = std::find_if(std::cbegin(failures), std::cend(failures), [](const auto& f) { return f != nullptr; }); failure != std::cend(failures)) {
+    std::rethrow_exception(*failure);
+  }
+
+  return result;
+}
@@ -0,0 +1,161 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sync_manager.h"
+
+#include <algorithm>
+#include <istream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <fmt/core.h>
+
+champsim::sync_manager::sync_manager(std::vector<sync_event> events)
+{
+  for (const auto& event : events) {
+    if (event.thread >= std::size(m_threads)) {
+      m_threads.resize(event.thread + 1);
+    }
+    m_threads.at(event.thread).events.push_back(event);
+  }
+
+  for (auto& state : m_threads) {
+    std::stable_sort(std::begin(state.events), std::end(state.events), [](const auto& lhs, const auto& rhs) { return lhs.instr < rhs.instr; });
+
+    // Each barrier waits for every trace that uses it
+    std::set<uint64_t> barrier_ids;
+    for (const auto& event : state.events) {
+      if (event.kind == sync_kind::barrier) {
+        barrier_ids.insert(event.id);
+      }
+    }
+    for (auto id : barrier_ids) {
+      ++m_barriers[id].participants;
+    }
+  }
+}
+
+bool champsim::sync_manager::try_pass(std::size_t thread, const sync_event& event)
+{
+  switch (event.kind) {
+  case sync_kind::acquire: {
+    auto [owner, inserted] = m_lock_owners.try_emplace(event.id, thread);
+    return inserted || owner->second == thread;
+  }
+  case sync_kind::release: {
+    auto owner = m_lock_owners.find(event.id);
+    if (owner != std::end(m_lock_owners) && owner->second == thread) {
+      m_lock_owners.erase(owner);
+    }
+    return true;
+  }
+  case sync_kind::barrier: {
+    auto& barrier = m_barriers.at(event.id);
+    auto& state = m_threads.at(thread);
+    if (!state.barrier_generation.has_value()) {
+      state.barrier_generation = barrier.generation;
+      if (++barrier.arrived == barrier.participants) {
+        barrier.arrived = 0;
+        ++barrier.generation;
+      }
+    }
+
+    if (barrier.generation == state.barrier_generation.value()) {
+      return false;
+    }
+    state.barrier_generation.reset();
+    return true;
+  }
+  }
+  return true;
+}
+
+bool champsim::sync_manager::may_read(std::size_t thread)
+{
+  if (thread >= std::size(m_threads)) {
+    return true;
+  }
+
+  auto& state = m_threads.at(thread);
+  while (state.next_event < std::size(state.events) && state.events.at(state.next_event).instr <= state.instrs_read) {
+    const auto& event = state.events.at(state.next_event);
+    if (!try_pass(thread, event)) {
+      state.waiting = event.kind;
+      return false;
+    }
+    ++state.next_event;
+    ++state.events_passed;
+  }
+
+  state.waiting.reset();
+  return true;
+}
+
+void champsim::sync_manager::advance(std::size_t thread)
+{
+  if (thread < std::size(m_threads)) {
+    ++m_threads.at(thread).instrs_read;
+  }
+}
+
+auto champsim::sync_manager::waiting_on(std::size_t thread) const -> std::optional<sync_kind>
+{
+  if (thread >= std::size(m_threads)) {
+    return std::nullopt;
+  }
+  return m_threads.at(thread).waiting;
+}
+
+uint64_t champsim::sync_manager::events_passed(std::size_t thread) const
+{
+  if (thread >= std::size(m_threads)) {
+    return 0;
+  }
+  return m_threads.at(thread).events_passed;
+}
+
+auto champsim::read_sync_markers(std::istream& in) -> std::vector<sync_event>
+{
+  std::vector<sync_event> events;
+  std::string line;
+  for (long line_number = 1; std::getline(in, line); ++line_number) {
+    std::istringstream fields{line};
+    std::string kind_name;
+    sync_event event{};
+    fields >> std::ws;
+    if (fields.eof() || fields.peek() == '#') {
+      continue;
+    }
+
+    if (!(fields >> event.thread >> event.instr >> kind_name >> event.id)) {
+      throw std::invalid_argument{fmt::format("Synchronization marker on line {} is malformed: {}", line_number, line)};
+    }
+
+    if (kind_name == "acquire") {
+      event.kind = sync_kind::acquire;
+    } else if (kind_name == "release") {
+      event.kind = sync_kind::release;
+    } else if (kind_name == "barrier") {
+      event.kind = sync_kind::barrier;
+    } else {
+      throw std::invalid_argument{fmt::format("Synchronization marker on line {} has unknown kind {}", line_number, kind_name)};
+    }
+
+    events.push_back(event);
+  }
+  return events;
+}
@@ -0,0 +1,38 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "token_bucket.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+champsim::token_bucket::token_bucket(champsim::chrono::clock::duration interval, std::size_t burst)
+    : m_interval(interval), m_tolerance(interval * (static_cast<long long>(burst) - 1))
+{
+  if (burst == 0) {
+    throw std::invalid_argument{"A token bucket must hold at least one token"};
+  }
+}
+
+bool champsim::token_bucket::may_take(champsim::chrono::clock::time_point now) const { return !limited() || m_empty_time <= now + m_tolerance; }
+
+void champsim::token_bucket::take(champsim::chrono::clock::time_point now)
+{
+  if (limited()) {
+    m_empty_time = std::max(m_empty_time, now) + m_interval;
+  }
+}
@@ -16,9 +16,16 @@
 
 #include "tracereader.h"
 
+#include <array>
+#include <cstring>
 #include <fstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <fmt/core.h>
 
+#include "columnar_trace.h"
+#include "fd_stream.h"
 #include "inf_stream.h"
 #include "repeatable.h"
 
@@ -32,22 +39,113 @@ ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_inst
   return branch;
 }
 
-template <template <class, class> typename R, typename T>
+namespace
+{
+using compression_type = champsim::trace_stream_header::compression_type;
+using format_type = champsim::trace_stream_header::format_type;
+
+bool ends_with(std::string_view str, std::string_view suffix)
+{
+  return std::size(str) >= std::size(suffix) && str.substr(std::size(str) - std::size(suffix)) == suffix;
+}
+
+compression_type compression_from_name(std::string_view fname)
+{
+  if (ends_with(fname, "gz")) {
+    return compression_type::gzip;
+  }
+  if (ends_with(fname, "xz")) {
+    return compression_type::xz;
+  }
+  if (ends_with(fname, "bz2")) {
+    return compression_type::bzip2;
+  }
+  return compression_type::none;
+}
+
+// Columnar traces are named like "name.csct", optionally followed by a compression suffix
+bool is_columnar_name(std::string_view fname)
+{
+  for (std::string_view suffix : {".gz", ".xz", ".bz2"}) {
+    if (ends_with(fname, suffix)) {
+      fname.remove_suffix(std::size(suffix));
+      break;
+    }
+  }
+  return ends_with(fname, ".csct");
+}
+
+template <typename S>
+using raw_stream = S;
+} // namespace
+
+template <template <class, class> typename R, typename T, template <class> typename W = raw_stream>
 champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
 {
-  if (bool is_gzip_compressed = (fname.substr(std::size(fname) - 2) == "gz"); is_gzip_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>(cpu, fname)};
+  switch (compression_from_name(fname)) {
+  case compression_type::gzip:
+    return champsim::tracereader{R<T, W<champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>>(cpu, fname)};
+  case compression_type::xz:
+    return champsim::tracereader{R<T, W<champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>>(cpu, fname)};
+  case compression_type::bzip2:
+    return champsim::tracereader{R<T, W<champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>>(cpu, fname)};
+  default:
+    return champsim::tracereader{R<T, W<std::ifstream>>(cpu, fname)};
   }
+}
+
+template <typename T, template <class> typename W = raw_stream>
+champsim::tracereader get_stream_tracereader_for_type(champsim::fd_istream&& strm, uint8_t cpu, compression_type compression)
+{
+  using gzip_stream = champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>, champsim::fd_istream>;
+  using lzma_stream = champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>, champsim::fd_istream>;
+  using bzip2_stream = champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t, champsim::fd_istream>;
 
-  if (bool is_lzma_compressed = (fname.substr(std::size(fname) - 2) == "xz"); is_lzma_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>(cpu, fname)};
+  switch (compression) {
+  case compression_type::gzip:
+    return champsim::tracereader{champsim::bulk_tracereader<T, W<gzip_stream>>(cpu, W<gzip_stream>{gzip_stream{std::move(strm)}})};
+  case compression_type::xz:
+    return champsim::tracereader{champsim::bulk_tracereader<T, W<lzma_stream>>(cpu, W<lzma_stream>{lzma_stream{std::move(strm)}})};
+  case compression_type::bzip2:
+    return champsim::tracereader{champsim::bulk_tracereader<T, W<bzip2_stream>>(cpu, W<bzip2_stream>{bzip2_stream{std::move(strm)}})};
+  default:
+    return champsim::tracereader{champsim::bulk_tracereader<T, W<champsim::fd_istream>>(cpu, W<champsim::fd_istream>{std::move(strm)})};
   }
+}
 
-  if (bool is_bzip2_compressed = (fname.substr(std::size(fname) - 3) == "bz2"); is_bzip2_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>(cpu, fname)};
+champsim::tracereader get_stream_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite)
+{
+  champsim::fd_istream strm{fname};
+
+  // Peek at the beginning of the stream for a framing header
+  std::array<char, sizeof(champsim::trace_stream_header)> raw_header{};
+  strm.read(std::data(raw_header), std::size(raw_header));
+  auto header_bytes = static_cast<std::size_t>(strm.gcount());
+
+  champsim::trace_stream_header header{};
+  if (header_bytes == std::size(raw_header)) {
+    std::memcpy(&header, std::data(raw_header), std::size(raw_header));
   }
 
-  return champsim::tracereader{R<T, std::ifstream>(cpu, fname)};
+  if (header_bytes != std::size(raw_header) || header.magic != champsim::trace_stream_header::expected_magic) {
+    // No header is present. Return the bytes and deduce the format as for a regular file.
+    strm.unread(std::data(raw_header), static_cast<std::streamsize>(header_bytes));
+    header.format = is_cloudsuite ? format_type::cloudsuite_instr : format_type::input_instr;
+    if (is_columnar_name(fname)) {
+      header.format = format_type::columnar;
+    }
+    header.compression = compression_from_name(fname);
+  } else if (header.version != champsim::trace_stream_header::current_version) {
+    throw std::invalid_argument{"Unsupported trace stream header version in " + fname};
+  }
+
+  if (header.format == format_type::cloudsuite_instr) {
+    return get_stream_tracereader_for_type<cloudsuite_instr>(std::move(strm), cpu, header.compression);
+  }
+  if (header.format == format_type::columnar) {
+    return get_stream_tracereader_for_type<input_instr, champsim::columnar::columnar_istream>(std::move(strm), cpu, header.compression);
+  }
+  return get_stream_tracereader_for_type<input_instr>(std::move(strm), cpu, header.compression);
 }
 } // namespace champsim
 
@@ -56,6 +154,23 @@ using repeatable_reader_t = champsim::repeatable<champsim::bulk_tracereader<T, S
 
 champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat)
 {
+  if (champsim::is_stream_source(fname)) {
+    if (repeat) {
+      fmt::print(stderr, "[TRACE] {} is a stream and cannot be repeated. The simulation will end when the stream is exhausted.\n", fname);
+    }
+    return champsim::get_stream_tracereader(fname, cpu, is_cloudsuite);
+  }
+
+  if (champsim::is_columnar_name(fname)) {
+    if (is_cloudsuite) {
+      throw std::invalid_argument{"Columnar traces hold only the standard instruction format: " + fname};
+    }
+    if (repeat) {
+      return champsim::get_tracereader_for_type<repeatable_reader_t, input_instr, champsim::columnar::columnar_istream>(fname, cpu);
+    }
+    return champsim::get_tracereader_for_type<champsim::bulk_tracereader, input_instr, champsim::columnar::columnar_istream>(fname, cpu);
+  }
+
   if (is_cloudsuite && repeat) {
     return champsim::get_tracereader_for_type<repeatable_reader_t, cloudsuite_instr>(fname, cpu);
   }
@@ -17,9 +17,11 @@
 #include "vmem.h"
 
 #include <cassert>
+#include <stdexcept>
 #include <fmt/core.h>
 
 #include "champsim.h"
+#include "compact_address.h"
 #include "dram_controller.h"
 #include "util/bits.h"
 
@@ -44,6 +46,15 @@ VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::si
   if (required_bits > champsim::data::bits{champsim::lg2(dram.size().count())}) {
     fmt::print("[VMEM] WARNING: physical memory size is smaller than virtual memory size.\n"); // LCOV_EXCL_LINE
   }
+
+  // Cache blocks may hold their addresses in fewer bits than a full address, so that addresses beyond the configured spaces could not be cached
+  const champsim::data::bits virtual_bits = extent(pt_levels).upper;
+  const champsim::data::bits physical_bits{champsim::lg2(dram.size().count())};
+  if (virtual_bits > champsim::block_address_storage_bits() || physical_bits > champsim::block_address_storage_bits()) {
+    throw std::invalid_argument{fmt::format("The virtual memory spans {} bits and the physical memory {} bits, but cache blocks of this build hold addresses of {} "
+                                            "bits. Rebuild with a larger COMPACT_ADDRESS_BITS, or use fewer page table levels.",
+                                            virtual_bits, physical_bits, champsim::block_address_storage_bits())};
+  }
   populate_pages();
   shuffle_pages();
 }
@@ -57,20 +68,25 @@ VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::si
 void VirtualMemory::populate_pages()
 {
   assert(dram.size() > 1_MiB);
-  ppage_free_list.resize(((dram.size() - 1_MiB) / PAGE_SIZE).count());
-  assert(ppage_free_list.size() != 0);
-  champsim::page_number base_address =
-      champsim::page_number{champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes{PAGE_SIZE}, 1_MiB))};
-  for (auto it = ppage_free_list.begin(); it != ppage_free_list.end(); it++) {
-    *it = base_address;
-    base_address++;
+  ppage_range_begin = champsim::page_number{champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes{PAGE_SIZE}, 1_MiB))};
+  ppage_range_size = static_cast<std::size_t>(((dram.size() - 1_MiB) / PAGE_SIZE).count());
+  ppage_range_taken = 0;
+  assert(ppage_range_size != 0);
+
+  if (randomization_seed.has_value()) {
+    ppage_shuffled.resize(ppage_range_size);
+    champsim::page_number base_address = ppage_range_begin;
+    for (auto it = ppage_shuffled.begin(); it != ppage_shuffled.end(); it++) {
+      *it = base_address;
+      base_address++;
+    }
   }
 }
 
 void VirtualMemory::shuffle_pages()
 {
   if (randomization_seed.has_value())
-    std::shuffle(ppage_free_list.begin(), ppage_free_list.end(), std::mt19937_64{randomization_seed.value()});
+    std::shuffle(ppage_shuffled.begin(), ppage_shuffled.end(), std::mt19937_64{randomization_seed.value()});
 }
 
 champsim::dynamic_extent VirtualMemory::extent(std::size_t level) const
@@ -89,12 +105,15 @@ uint64_t VirtualMemory::get_offset(champsim::page_number vaddr, std::size_t leve
 champsim::page_number VirtualMemory::ppage_front() const
 {
   assert(available_ppages() > 0);
-  return ppage_free_list.front();
+  if (std::empty(ppage_shuffled)) {
+    return ppage_range_begin + static_cast<champsim::page_number::difference_type>(ppage_range_taken);
+  }
+  return ppage_shuffled[ppage_range_taken];
 }
 
 void VirtualMemory::ppage_pop()
 {
-  ppage_free_list.pop_front();
+  ++ppage_range_taken;
   if (available_ppages() == 0) {
     fmt::print("[VMEM] WARNING: Out of physical memory, freeing ppages\n");
     populate_pages();
@@ -102,11 +121,21 @@ void VirtualMemory::ppage_pop()
   }
 }
 
-std::size_t VirtualMemory::available_ppages() const { return (ppage_free_list.size()); }
+std::size_t VirtualMemory::available_ppages() const { return ppage_range_size - ppage_range_taken; }
+
+void VirtualMemory::tag_address_spaces(unsigned shift) { address_space_shift = shift; }
+
+uint32_t VirtualMemory::address_space(uint32_t cpu_num, champsim::page_number vaddr) const
+{
+  if (address_space_shift.has_value()) {
+    return static_cast<uint32_t>(champsim::address{vaddr}.to<uint64_t>() >> address_space_shift.value());
+  }
+  return cpu_num;
+}
 
 std::pair<champsim::page_number, champsim::chrono::clock::duration> VirtualMemory::va_to_pa(uint32_t cpu_num, champsim::page_number vaddr)
 {
-  auto [ppage, fault] = vpage_to_ppage_map.try_emplace({cpu_num, champsim::page_number{vaddr}}, ppage_front());
+  auto [ppage, fault] = vpage_to_ppage_map.try_emplace({address_space(cpu_num, vaddr), champsim::page_number{vaddr}}, ppage_front());
 
   // this vpage doesn't yet have a ppage mapping
   if (fault) {
@@ -130,8 +159,8 @@ std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::g
   }
 
   champsim::dynamic_extent pte_table_entry_extent{champsim::address::bits, shamt(level)};
-  auto [ppage, fault] =
-      page_table.try_emplace({cpu_num, level, champsim::address_slice{pte_table_entry_extent, vaddr}}, champsim::splice(active_pte_page, next_pte_page));
+  auto [ppage, fault] = page_table.try_emplace({address_space(cpu_num, vaddr), level, champsim::address_slice{pte_table_entry_extent, vaddr}},
+                                               champsim::splice(active_pte_page, next_pte_page));
 
   // this PTE doesn't yet have a mapping
   if (fault) {
@@ -0,0 +1,78 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "worker_pool.h"
+
+#include <algorithm>
+
+champsim::worker_pool::worker_pool(std::size_t threads)
+{
+  auto helper_count = std::max<std::size_t>(threads, 1) - 1;
+  std::generate_n(std::back_inserter(m_helpers), helper_count, [this]() { return std::thread{&worker_pool::help, this}; });
+}
+
+champsim::worker_pool::~worker_pool()
+{
+  m_stop = true;
+  std::for_each(std::begin(m_helpers), std::end(m_helpers), [](auto& t) { t.join(); });
+}
+
+void champsim::worker_pool::drain(job& work)
+{
+  for (auto idx = work.next++; idx < work.count; idx = work.next++) {
+    work.run(work.context, idx);
+    ++work.done;
+  }
+}
+
+void champsim::worker_pool::help()
+{
+  uint64_t seen = 0;
+  while (!m_stop) {
+    if (auto generation = m_generation.load(); generation != seen) {
+      // A job is only reclaimed once no thread is visiting it, so it must be loaded after this thread is counted
+      ++m_visitors;
+      if (auto* work = m_job.load(); work != nullptr) {
+        drain(*work);
+      }
+      --m_visitors;
+      seen = generation;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void champsim::worker_pool::run(job& work)
+{
+  if (std::empty(m_helpers)) {
+    drain(work);
+    return;
+  }
+
+  m_job = &work;
+  ++m_generation;
+  drain(work);
+
+  while (work.done < work.count) {
+    std::this_thread::yield();
+  }
+  m_job = nullptr;
+  while (m_visitors > 0) {
+    std::this_thread::yield();
+  }
+}
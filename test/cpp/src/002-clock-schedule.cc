@@ -0,0 +1,152 @@
+#include <catch.hpp>
+#include "clock_schedule.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using log_type = std::vector<std::pair<int, champsim::chrono::clock::time_point>>;
+
+struct logging_operable : champsim::operable {
+  int id;
+  log_type* log;
+  logging_operable(int id_, champsim::chrono::picoseconds period, log_type* log_) : operable(period), id(id_), log(log_) {}
+  long operate() override
+  {
+    log->emplace_back(id, current_time);
+    return 1;
+  }
+};
+
+std::vector<std::reference_wrapper<champsim::operable>> refs(std::vector<logging_operable>& ops)
+{
+  return {std::begin(ops), std::end(ops)};
+}
+
+// The order in which the components operate when they are sorted in every tick
+log_type sorted_log(std::vector<champsim::chrono::picoseconds> periods, long ticks, champsim::chrono::picoseconds quantum)
+{
+  log_type log;
+  std::vector<logging_operable> ops;
+  for (std::size_t i = 0; i < std::size(periods); ++i)
+    ops.emplace_back(static_cast<int>(i), periods[i], &log);
+
+  champsim::chrono::clock clock{};
+  for (long i = 0; i < ticks; ++i) {
+    clock.tick(quantum);
+    auto operables = ::refs(ops);
+    std::sort(std::begin(operables), std::end(operables),
+              [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
+    for (champsim::operable& op : operables)
+      op.operate_on(clock);
+  }
+  return log;
+}
+
+log_type scheduled_log(std::vector<champsim::chrono::picoseconds> periods, long ticks, champsim::chrono::picoseconds quantum)
+{
+  log_type log;
+  std::vector<logging_operable> ops;
+  for (std::size_t i = 0; i < std::size(periods); ++i)
+    ops.emplace_back(static_cast<int>(i), periods[i], &log);
+
+  champsim::chrono::clock clock{};
+  champsim::clock_schedule uut{::refs(ops), quantum};
+  for (long i = 0; i < ticks; ++i) {
+    clock.tick(quantum);
+    uut.operate_on(clock);
+  }
+  return log;
+}
+} // namespace
+
+TEST_CASE("A clock schedule records the repeating pattern of clock domains") {
+  std::vector<logging_operable> ops;
+  log_type log;
+  ops.emplace_back(0, champsim::chrono::picoseconds{250}, &log);
+  ops.emplace_back(1, champsim::chrono::picoseconds{625}, &log);
+
+  champsim::chrono::clock clock{};
+  champsim::clock_schedule uut{::refs(ops), champsim::chrono::picoseconds{250}};
+  clock.tick(champsim::chrono::picoseconds{250});
+  REQUIRE(uut.operate_on(clock) == 2);
+
+  REQUIRE(uut.is_precomputed());
+  REQUIRE(uut.period_ticks() == 5);
+}
+
+TEST_CASE("A clock schedule operates components in the same order as sorting them every tick") {
+  auto quantum = champsim::chrono::picoseconds{250};
+  std::vector<champsim::chrono::picoseconds> periods{quantum, champsim::chrono::picoseconds{312}, champsim::chrono::picoseconds{625}, quantum,
+                                                     champsim::chrono::picoseconds{500}};
+
+  REQUIRE(::scheduled_log(periods, 10000, quantum) == ::sorted_log(periods, 10000, quantum));
+}
+
+TEST_CASE("A clock schedule with many components keeps the order of sorting them") {
+  auto quantum = champsim::chrono::picoseconds{250};
+  std::vector<champsim::chrono::picoseconds> periods;
+  for (int i = 0; i < 24; ++i)
+    periods.push_back((i % 3 == 0) ? champsim::chrono::picoseconds{625} : quantum);
+
+  REQUIRE(::scheduled_log(periods, 1000, quantum) == ::sorted_log(periods, 1000, quantum));
+}
+
+TEST_CASE("A clock schedule follows a change of clock period") {
+  log_type expected_log;
+  log_type actual_log;
+  std::array<logging_operable, 2> expected{{{0, champsim::chrono::picoseconds{250}, &expected_log}, {1, champsim::chrono::picoseconds{625}, &expected_log}}};
+  std::array<logging_operable, 2> actual{{{0, champsim::chrono::picoseconds{250}, &actual_log}, {1, champsim::chrono::picoseconds{625}, &actual_log}}};
+
+  champsim::chrono::clock clock{};
+  champsim::clock_schedule uut{{std::begin(actual), std::end(actual)}, champsim::chrono::picoseconds{250}};
+  for (int i = 0; i < 1000; ++i) {
+    if (i == 503) {
+      expected[1].clock_period = champsim::chrono::picoseconds{1000};
+      actual[1].clock_period = champsim::chrono::picoseconds{1000};
+    }
+
+    clock.tick(champsim::chrono::picoseconds{250});
+    uut.operate_on(clock);
+
+    std::vector<std::reference_wrapper<champsim::operable>> sorted{std::begin(expected), std::end(expected)};
+    std::sort(std::begin(sorted), std::end(sorted),
+              [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
+    for (champsim::operable& op : sorted)
+      op.operate_on(clock);
+  }
+
+  REQUIRE(actual_log == expected_log);
+  REQUIRE(uut.is_precomputed());
+  REQUIRE(uut.period_ticks() == 4);
+}
+
+TEST_CASE("A clock schedule sorts every tick if the pattern is too long to record") {
+  auto quantum = champsim::chrono::picoseconds{10007};
+  std::vector<champsim::chrono::picoseconds> periods{quantum, champsim::chrono::picoseconds{10009}};
+
+  log_type log;
+  std::vector<logging_operable> ops;
+  for (std::size_t i = 0; i < std::size(periods); ++i)
+    ops.emplace_back(static_cast<int>(i), periods[i], &log);
+  champsim::chrono::clock clock{};
+  champsim::clock_schedule uut{::refs(ops), quantum};
+  clock.tick(quantum);
+  uut.operate_on(clock);
+  REQUIRE_FALSE(uut.is_precomputed());
+
+  REQUIRE(::scheduled_log(periods, 1000, quantum) == ::sorted_log(periods, 1000, quantum));
+}
+
+TEST_CASE("A clock schedule operates components faster than sorting them every tick") {
+  auto quantum = champsim::chrono::picoseconds{250};
+  std::vector<champsim::chrono::picoseconds> periods(12, quantum);
+  periods.push_back(champsim::chrono::picoseconds{625});
+
+  BENCHMARK("Sorted every tick") { return std::size(::sorted_log(periods, 10000, quantum)); };
+
+  BENCHMARK("Scheduled") { return std::size(::scheduled_log(periods, 10000, quantum)); };
+}
@@ -0,0 +1,119 @@
+#include <catch.hpp>
+
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "pooled_list.h"
+
+TEST_CASE("A pooled list holds the elements it is given") {
+  champsim::pooled_list<uint64_t> uut{1, 2, 3};
+  REQUIRE(std::size(uut) == 3);
+  REQUIRE(uut.front() == 1);
+  REQUIRE(uut.back() == 3);
+  REQUIRE(std::vector<uint64_t>(std::begin(uut), std::end(uut)) == std::vector<uint64_t>{1, 2, 3});
+}
+
+TEST_CASE("An empty pooled list has no storage") {
+  champsim::pooled_list<uint64_t> uut{};
+  REQUIRE(uut.empty());
+  REQUIRE(std::begin(uut) == std::end(uut));
+  REQUIRE(uut.data() == nullptr);
+}
+
+TEST_CASE("A pooled list grows beyond its first node") {
+  champsim::pooled_list<uint64_t> uut{};
+  std::vector<uint64_t> expected{};
+  for (uint64_t i = 0; i < 100; ++i) {
+    uut.push_back(i);
+    expected.push_back(i);
+  }
+  REQUIRE(std::vector<uint64_t>(std::begin(uut), std::end(uut)) == expected);
+}
+
+TEST_CASE("A copied pooled list shares its elements until one is modified") {
+  champsim::pooled_list<uint64_t> original{1, 2, 3};
+  champsim::pooled_list<uint64_t> copy{original};
+  REQUIRE(copy.data() == original.data());
+
+  SECTION("Appending to the copy does not change the original") {
+    copy.push_back(4);
+    REQUIRE(copy.data() != original.data());
+    REQUIRE(original == champsim::pooled_list<uint64_t>{1, 2, 3});
+    REQUIRE(copy == champsim::pooled_list<uint64_t>{1, 2, 3, 4});
+  }
+
+  SECTION("Erasing from the original does not change the copy") {
+    auto next = original.erase(std::begin(original));
+    REQUIRE(*next == 2);
+    REQUIRE(original == champsim::pooled_list<uint64_t>{2, 3});
+    REQUIRE(copy == champsim::pooled_list<uint64_t>{1, 2, 3});
+  }
+
+  SECTION("Clearing the original does not change the copy") {
+    original.clear();
+    REQUIRE(original.empty());
+    REQUIRE(copy == champsim::pooled_list<uint64_t>{1, 2, 3});
+  }
+}
+
+TEST_CASE("A moved-from pooled list is empty") {
+  champsim::pooled_list<uint64_t> original{1, 2, 3};
+  champsim::pooled_list<uint64_t> moved{std::move(original)};
+  REQUIRE(original.empty()); // NOLINT(bugprone-use-after-move)
+  REQUIRE(moved == champsim::pooled_list<uint64_t>{1, 2, 3});
+
+  // Merges reuse moved-from lists as destinations
+  std::copy(std::begin(moved), std::end(moved), std::back_inserter(original)); // NOLINT(bugprone-use-after-move)
+  REQUIRE(original == moved);
+}
+
+TEST_CASE("Released pooled list nodes are reused") {
+  // Fill the pool with one node of each size that the loop below uses
+  {
+    champsim::pooled_list<uint64_t> warm{};
+    for (uint64_t i = 0; i < 32; ++i)
+      warm.push_back(i);
+  }
+
+  auto allocations = champsim::pooled_list<uint64_t>::heap_allocations();
+  for (int repeat = 0; repeat < 1000; ++repeat) {
+    champsim::pooled_list<uint64_t> uut{};
+    for (uint64_t i = 0; i < 32; ++i)
+      uut.push_back(i);
+  }
+  REQUIRE(champsim::pooled_list<uint64_t>::heap_allocations() == allocations);
+}
+
+TEST_CASE("Pooled lists may be shared between threads") {
+  champsim::pooled_list<uint64_t> original{1, 2, 3};
+
+  std::vector<std::thread> threads{};
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([original]() mutable {
+      for (int repeat = 0; repeat < 10000; ++repeat) {
+        champsim::pooled_list<uint64_t> copy{original};
+        copy.push_back(4);
+      }
+      original.clear();
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  REQUIRE(original == champsim::pooled_list<uint64_t>{1, 2, 3});
+  REQUIRE(original.data() != nullptr);
+}
+
+TEST_CASE("Pooled list nodes released by another thread are returned to their owner") {
+  // Fill the pool with one node of the size that the loop below uses
+  { champsim::pooled_list<uint64_t> warm{1, 2, 3}; }
+
+  auto allocations = champsim::pooled_list<uint64_t>::heap_allocations();
+  for (int repeat = 0; repeat < 100; ++repeat) {
+    champsim::pooled_list<uint64_t> uut{1, 2, 3};
+    std::thread other{[released = std::move(uut)]() mutable { released.clear(); }};
+    other.join();
+  }
+  REQUIRE(champsim::pooled_list<uint64_t>::heap_allocations() == allocations);
+}
@@ -0,0 +1,66 @@
+#include <catch.hpp>
+
+#include "block.h"
+#include "compact_address.h"
+#include "os_scheduler.h"
+
+TEST_CASE("A compact block address packs its bits without padding") {
+  STATIC_REQUIRE(sizeof(champsim::compact_block_address<32>) == 4);
+  STATIC_REQUIRE(sizeof(champsim::compact_block_address<40>) == 5);
+  STATIC_REQUIRE(alignof(champsim::compact_block_address<40>) == 1);
+}
+
+TEST_CASE("A compact block address holds the block of an address") {
+  champsim::address addr{0xdead'beef'c0};
+  champsim::compact_block_address<48> uut{addr};
+
+  REQUIRE(uut.block_number() == (uint64_t{0xdead'beef'c0} >> LOG2_BLOCK_SIZE));
+  REQUIRE(champsim::address{uut} == champsim::address{champsim::block_number{addr}});
+}
+
+TEST_CASE("A compact block address drops the offset within the block") {
+  champsim::compact_block_address<32> uut{champsim::address{0x1234'5678}};
+  REQUIRE(champsim::address{uut} == champsim::address{0x1234'5640});
+}
+
+TEST_CASE("Compact block addresses of the same block are equal") {
+  REQUIRE(champsim::compact_block_address<32>{champsim::address{0x1000}} == champsim::compact_block_address<32>{champsim::address{0x1030}});
+  REQUIRE(champsim::compact_block_address<32>{champsim::address{0x1000}} != champsim::compact_block_address<32>{champsim::address{0x1040}});
+}
+
+TEST_CASE("A compact block address keeps the address space tag in the top byte") {
+  // A stack address near the top of the canonical address space, alone and in the address space of a scheduled trace
+  champsim::address stack{0x7ffc'd3a1'2f40};
+  champsim::address tagged{(uint64_t{3} << champsim::os_scheduler::address_space_shift) | stack.to<uint64_t>()};
+
+  REQUIRE(champsim::address{champsim::compact_block_address<56>{stack}} == champsim::address{champsim::block_number{stack}});
+  REQUIRE(champsim::address{champsim::compact_block_address<56>{tagged}} == champsim::address{champsim::block_number{tagged}});
+  REQUIRE(champsim::compact_block_address<56>{stack} != champsim::compact_block_address<56>{tagged});
+
+  champsim::address small_tagged{(uint64_t{0xff} << champsim::os_scheduler::address_space_shift) | 0x1234'5640};
+  REQUIRE(champsim::address{champsim::compact_block_address<32>{small_tagged}} == small_tagged);
+}
+
+TEST_CASE("A compact block address rejects addresses that are too wide") {
+  using uut_type = champsim::compact_block_address<40>;
+  REQUIRE(uut_type::address_bits() == 32 + LOG2_BLOCK_SIZE);
+
+  champsim::address widest{(uint64_t{1} << uut_type::address_bits()) - 1};
+  REQUIRE(champsim::address{uut_type{widest}} == champsim::address{champsim::block_number{widest}});
+  REQUIRE_THROWS_AS(uut_type{champsim::address{uint64_t{1} << uut_type::address_bits()}}, std::range_error);
+  REQUIRE_THROWS_AS(uut_type{champsim::address{0x7ffc'd3a1'2f40}}, std::range_error);
+}
+
+TEST_CASE("A cache block stores the block of its address") {
+  champsim::cache_block blk;
+  blk.address = champsim::address{0x8000'0040};
+  REQUIRE(champsim::address{blk.address} == champsim::address{0x8000'0040});
+}
+
+TEST_CASE("A cache block filled at a stack address keeps its virtual address") {
+  champsim::cache_block blk;
+  blk.address = champsim::address{0x7ffc'd3a1'2f40};
+  blk.v_address = champsim::address{0x7ffc'd3a1'2f40};
+  REQUIRE(champsim::address{blk.address} == champsim::address{0x7ffc'd3a1'2f40});
+  REQUIRE(champsim::address{blk.v_address} == champsim::address{0x7ffc'd3a1'2f40});
+}
@@ -0,0 +1,64 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include "stack_distance.h"
+
+TEST_CASE("Stack distances count the distinct lines since the previous access")
+{
+  champsim::stack_distance_counter uut;
+  constexpr auto inf = champsim::stack_distance_counter::infinite;
+
+  std::vector<uint64_t> lines{1, 2, 3, 1, 1, 3, 2, 4, 1};
+  std::vector<uint64_t> expected{inf, inf, inf, 2, 0, 1, 2, inf, 3};
+  std::vector<uint64_t> distances;
+  for (auto line : lines) {
+    distances.push_back(uut.access(line));
+  }
+
+  REQUIRE(distances == expected);
+  REQUIRE(uut.footprint() == 4);
+}
+
+TEST_CASE("Stack distances survive the compaction of the access history")
+{
+  champsim::stack_distance_counter uut;
+  constexpr uint64_t num_lines = 10;
+
+  // Many more accesses than the initial size of the history
+  for (uint64_t i = 0; i < 5000; ++i) {
+    auto distance = uut.access(i % num_lines);
+    if (i < num_lines) {
+      REQUIRE(distance == champsim::stack_distance_counter::infinite);
+    } else {
+      REQUIRE(distance == num_lines - 1);
+    }
+  }
+  REQUIRE(uut.footprint() == num_lines);
+}
+
+TEST_CASE("A stack distance histogram buckets distances by powers of two")
+{
+  champsim::stack_distance_counter counter;
+  champsim::stack_distance_histogram uut;
+
+  // A cyclic sweep over 6 lines, twice, then a repeated access to the last line
+  for (uint64_t i = 0; i < 12; ++i) {
+    uut.add(counter.access(i % 6));
+  }
+  uut.add(counter.access(5));
+
+  REQUIRE(uut.cold() == 6);
+  REQUIRE(uut.buckets().at(0) == 1); // the repeated access
+  REQUIRE(uut.buckets().at(3) == 6); // distance 5 is in [4, 8)
+  REQUIRE(uut.buckets().at(1) == 0);
+  REQUIRE(uut.buckets().at(2) == 0);
+
+  uut.add(1);
+  uut.add(2);
+  uut.add(3);
+  uut.add(uint64_t{1} << 40);
+  REQUIRE(uut.buckets().at(1) == 1);
+  REQUIRE(uut.buckets().at(2) == 2);
+  REQUIRE(uut.buckets().at(41) == 1);
+}
@@ -0,0 +1,235 @@
+#include <catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "fd_stream.h"
+#include "tracereader.h"
+
+namespace
+{
+// A stand-in for a live trace producer, which generates a fixed number of sequential instructions
+std::string generate_records(std::size_t count)
+{
+  std::string retval;
+  for (std::size_t i = 0; i < count; ++i) {
+    input_instr record{};
+    record.ip = 0x1000 + 4 * i;
+    retval.append(reinterpret_cast<const char*>(&record), sizeof(record));
+  }
+  return retval;
+}
+
+std::string make_header(champsim::trace_stream_header::compression_type compression)
+{
+  champsim::trace_stream_header header{};
+  header.compression = compression;
+  return std::string(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+std::string gzip_compress(const std::string& plain)
+{
+  z_stream strm{};
+  deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY); // 15+16 selects a gzip wrapper
+  std::vector<Bytef> in_buf(std::begin(plain), std::end(plain));
+  std::vector<Bytef> out_buf(deflateBound(&strm, static_cast<uLong>(std::size(plain))));
+  strm.next_in = std::data(in_buf);
+  strm.avail_in = static_cast<uInt>(std::size(in_buf));
+  strm.next_out = std::data(out_buf);
+  strm.avail_out = static_cast<uInt>(std::size(out_buf));
+  deflate(&strm, Z_FINISH);
+  std::string retval(reinterpret_cast<const char*>(std::data(out_buf)), strm.total_out);
+  deflateEnd(&strm);
+  return retval;
+}
+
+void write_all(int fd, const std::string& data)
+{
+  std::size_t written = 0;
+  while (written < std::size(data)) {
+    auto result = ::write(fd, std::data(data) + written, std::size(data) - written);
+    if (result <= 0) {
+      break;
+    }
+    written += static_cast<std::size_t>(result);
+  }
+}
+
+// The final instruction in a trace is held back, since its successor (and therefore its branch target) is unknown
+void check_sequential_ips(champsim::tracereader& uut, std::size_t count)
+{
+  for (std::size_t i = 0; i + 1 < count; ++i) {
+    REQUIRE_FALSE(uut.eof());
+    auto instr = uut();
+    REQUIRE(instr.ip == champsim::address{0x1000 + 4 * i});
+  }
+  REQUIRE(uut.eof());
+}
+
+std::filesystem::path unique_temp_path(std::string_view stem)
+{
+  return std::filesystem::temp_directory_path() / (std::string{stem} + "-" + std::to_string(::getpid()));
+}
+} // namespace
+
+TEST_CASE("An fd_istream reassembles short reads from a pipe")
+{
+  std::array<int, 2> fds{};
+  REQUIRE(::pipe(std::data(fds)) == 0);
+
+  std::thread producer{[fd = fds[1]] {
+    write_all(fd, "abc");
+    write_all(fd, "defg");
+    ::close(fd);
+  }};
+
+  champsim::fd_istream uut{fds[0], true};
+  std::array<char, 8> buf{};
+  uut.read(std::data(buf), 5);
+  REQUIRE(uut.gcount() == 5);
+  REQUIRE_FALSE(uut.fail());
+
+  uut.unread("xy", 2);
+  uut.read(std::data(buf), 8);
+  producer.join();
+
+  REQUIRE(uut.gcount() == 4);
+  REQUIRE(uut.eof());
+  REQUIRE(uut.fail());
+  REQUIRE(std::string(std::data(buf), 4) == "xyfg");
+}
+
+TEST_CASE("An fd_istream reports read errors instead of the end of the stream")
+{
+  // Reading a directory fails with EISDIR
+  int fd = ::open("/", O_RDONLY);
+  REQUIRE(fd >= 0);
+
+  champsim::fd_istream uut{fd, true};
+  std::array<char, 8> buf{};
+  REQUIRE_THROWS_AS(uut.read(std::data(buf), 8), std::system_error);
+}
+
+TEST_CASE("A pipe path is recognized as a stream source")
+{
+  std::array<int, 2> fds{};
+  REQUIRE(::pipe(std::data(fds)) == 0);
+  REQUIRE(champsim::is_stream_source("/dev/fd/" + std::to_string(fds[0])));
+  REQUIRE(champsim::is_stream_source("-"));
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+TEST_CASE("A framed stream on a pipe is decoded")
+{
+  constexpr std::size_t num_instrs = 1000;
+  std::array<int, 2> fds{};
+  REQUIRE(::pipe(std::data(fds)) == 0);
+
+  std::thread producer{[fd = fds[1]] {
+    write_all(fd, make_header(champsim::trace_stream_header::compression_type::none));
+    write_all(fd, generate_records(num_instrs));
+    ::close(fd);
+  }};
+
+  auto uut = get_tracereader("/dev/fd/" + std::to_string(fds[0]), 0, false, false);
+  ::close(fds[0]);
+  check_sequential_ips(uut, num_instrs);
+  producer.join();
+}
+
+TEST_CASE("A gzip-compressed framed stream is decoded")
+{
+  constexpr std::size_t num_instrs = 1000;
+  std::array<int, 2> fds{};
+  REQUIRE(::pipe(std::data(fds)) == 0);
+
+  std::thread producer{[fd = fds[1]] {
+    write_all(fd, make_header(champsim::trace_stream_header::compression_type::gzip));
+    write_all(fd, gzip_compress(generate_records(num_instrs)));
+    ::close(fd);
+  }};
+
+  auto uut = get_tracereader("/dev/fd/" + std::to_string(fds[0]), 0, false, false);
+  ::close(fds[0]);
+  check_sequential_ips(uut, num_instrs);
+  producer.join();
+}
+
+TEST_CASE("A stream without a header falls back to raw records")
+{
+  constexpr std::size_t num_instrs = 300;
+  std::array<int, 2> fds{};
+  REQUIRE(::pipe(std::data(fds)) == 0);
+
+  std::thread producer{[fd = fds[1]] {
+    write_all(fd, generate_records(num_instrs));
+    ::close(fd);
+  }};
+
+  auto uut = get_tracereader("/dev/fd/" + std::to_string(fds[0]), 0, false, false);
+  ::close(fds[0]);
+  check_sequential_ips(uut, num_instrs);
+  producer.join();
+}
+
+TEST_CASE("A named FIFO is read as a stream")
+{
+  constexpr std::size_t num_instrs = 500;
+  auto path = unique_temp_path("champsim-trace-fifo");
+  std::filesystem::remove(path);
+  REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+
+  std::thread producer{[path] {
+    auto fd = ::open(path.c_str(), O_WRONLY);
+    write_all(fd, make_header(champsim::trace_stream_header::compression_type::none));
+    write_all(fd, generate_records(num_instrs));
+    ::close(fd);
+  }};
+
+  REQUIRE(champsim::is_stream_source(path.string()));
+  auto uut = get_tracereader(path.string(), 0, false, false);
+  check_sequential_ips(uut, num_instrs);
+  producer.join();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("A Unix domain socket is read as a stream")
+{
+  constexpr std::size_t num_instrs = 500;
+  auto path = unique_temp_path("champsim-trace-sock");
+  std::filesystem::remove(path);
+
+  int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  REQUIRE(listener >= 0);
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  REQUIRE(::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+  REQUIRE(::listen(listener, 1) == 0);
+
+  std::thread producer{[listener] {
+    auto fd = ::accept(listener, nullptr, nullptr);
+    write_all(fd, make_header(champsim::trace_stream_header::compression_type::none));
+    write_all(fd, generate_records(num_instrs));
+    ::close(fd);
+  }};
+
+  REQUIRE(champsim::is_stream_source(path.string()));
+  auto uut = get_tracereader(path.string(), 0, false, false);
+  check_sequential_ips(uut, num_instrs);
+  producer.join();
+  ::close(listener);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,70 @@
+#include <catch.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "tracereader.h"
+
+namespace
+{
+// Every instruction is a direct jump to the next instruction, so that each branch target is exactly the following IP
+std::string taken_branch_chain(std::size_t count)
+{
+  std::string retval;
+  for (std::size_t i = 0; i < count; ++i) {
+    input_instr record{};
+    record.ip = 0x44440000 + 0x100 * i;
+    record.is_branch = 1;
+    record.branch_taken = 1;
+    record.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    retval.append(reinterpret_cast<const char*>(&record), sizeof(record));
+  }
+  return retval;
+}
+} // namespace
+
+TEST_CASE("A tracereader resolves branch targets across buffer refills")
+{
+  constexpr std::size_t num_instrs = 100;
+  auto buffer_size = GENERATE(as<std::size_t>{}, 4, 8, 64, 4096);
+
+  champsim::bulk_tracereader<input_instr, std::istringstream> uut{0, std::istringstream{taken_branch_chain(num_instrs)}, buffer_size};
+
+  // The final instruction has no successor, so it is held back. The trace length is not a multiple of the record buffer, so the end of the trace is seen
+  // while the final instruction is still buffered.
+  for (std::size_t i = 0; i + 1 < num_instrs; ++i) {
+    REQUIRE_FALSE(uut.eof());
+    auto instr = uut();
+    REQUIRE(instr.ip == champsim::address{0x44440000 + 0x100 * i});
+    REQUIRE(instr.branch_target == champsim::address{0x44440000 + 0x100 * (i + 1)});
+  }
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A tracereader reads a trace that is an exact multiple of its buffer")
+{
+  constexpr std::size_t buffer_size = 5;
+  constexpr std::size_t num_instrs = 3 * (buffer_size - 1);
+
+  champsim::bulk_tracereader<input_instr, std::istringstream> uut{0, std::istringstream{taken_branch_chain(num_instrs)}, buffer_size};
+
+  for (std::size_t i = 0; i + 1 < num_instrs; ++i) {
+    REQUIRE_FALSE(uut.eof());
+    auto instr = uut();
+    REQUIRE(instr.ip == champsim::address{0x44440000 + 0x100 * i});
+    REQUIRE(instr.branch_target == champsim::address{0x44440000 + 0x100 * (i + 1)});
+  }
+}
+
+TEST_CASE("A tracereader with the minimum buffer returns one instruction per refill")
+{
+  constexpr std::size_t num_instrs = 10;
+  champsim::bulk_tracereader<input_instr, std::istringstream> uut{0, std::istringstream{taken_branch_chain(num_instrs)}, 2};
+
+  for (std::size_t i = 0; i + 1 < num_instrs; ++i) {
+    auto instr = uut();
+    REQUIRE(instr.ip == champsim::address{0x44440000 + 0x100 * i});
+    REQUIRE(instr.branch_target == champsim::address{0x44440000 + 0x100 * (i + 1)});
+  }
+}
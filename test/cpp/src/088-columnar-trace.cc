@@ -0,0 +1,123 @@
+#include <catch.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "columnar_trace.h"
+#include "tracereader.h"
+
+namespace
+{
+// A loop of loads and stores over an array, with a backwards branch every eight instructions
+std::vector<input_instr> generate_loop(std::size_t count)
+{
+  std::vector<input_instr> retval;
+  for (std::size_t i = 0; i < count; ++i) {
+    input_instr record{};
+    record.ip = 0x400000 + 4 * (i % 8);
+    record.source_registers[0] = static_cast<unsigned char>(1 + i % 3);
+    record.destination_registers[0] = static_cast<unsigned char>(4 + i % 2);
+    if (i % 8 == 7) {
+      record.is_branch = 1;
+      record.branch_taken = 1;
+      record.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    } else if (i % 2 == 0) {
+      record.source_memory[0] = 0x7fff0000 + 8 * i;
+    } else {
+      record.destination_memory[1] = 0x10000000 - 64 * i;
+    }
+    retval.push_back(record);
+  }
+  return retval;
+}
+
+std::string encode(const std::vector<input_instr>& records, std::size_t block_size)
+{
+  auto header = champsim::columnar::file_header();
+  std::vector<char> encoded{std::begin(header), std::end(header)};
+  for (std::size_t i = 0; i < std::size(records); i += block_size) {
+    auto end = std::min(i + block_size, std::size(records));
+    champsim::columnar::encode_block(std::next(std::data(records), static_cast<long>(i)), std::next(std::data(records), static_cast<long>(end)), encoded);
+  }
+  return std::string{std::begin(encoded), std::end(encoded)};
+}
+} // namespace
+
+TEST_CASE("A block of records survives a round trip through the columnar encoding")
+{
+  auto records = ::generate_loop(1000);
+  records.at(3).ip = 0xffffffffffffff00; // A large backwards delta
+  records.at(5).source_memory[3] = 0xdeadbeef;
+
+  std::vector<char> encoded;
+  champsim::columnar::encode_block(std::data(records), std::next(std::data(records), static_cast<long>(std::size(records))), encoded);
+
+  std::vector<input_instr> decoded;
+  champsim::columnar::decode_block(std::next(std::data(encoded), champsim::columnar::block_header_size), std::next(std::data(encoded), static_cast<long>(std::size(encoded))),
+                                   std::size(records), decoded);
+
+  REQUIRE(std::size(decoded) == std::size(records));
+  REQUIRE(std::memcmp(std::data(decoded), std::data(records), std::size(records) * sizeof(input_instr)) == 0);
+}
+
+TEST_CASE("The columnar encoding is smaller than the raw records")
+{
+  auto records = ::generate_loop(10000);
+  auto encoded = ::encode(records, champsim::columnar::default_block_size);
+  REQUIRE(std::size(encoded) * 8 < std::size(records) * sizeof(input_instr));
+}
+
+TEST_CASE("A columnar stream produces the bytes of the raw records across blocks")
+{
+  auto records = ::generate_loop(1000);
+  champsim::columnar::columnar_istream<std::istringstream> uut{std::istringstream{::encode(records, 300)}};
+
+  std::vector<input_instr> decoded(std::size(records) + 1);
+  uut.read(reinterpret_cast<char*>(std::data(decoded)), static_cast<std::streamsize>(std::size(decoded) * sizeof(input_instr)));
+
+  REQUIRE(uut.eof());
+  REQUIRE(uut.gcount() == static_cast<std::streamsize>(std::size(records) * sizeof(input_instr)));
+  REQUIRE(std::memcmp(std::data(decoded), std::data(records), std::size(records) * sizeof(input_instr)) == 0);
+}
+
+TEST_CASE("A tracereader reads a columnar trace")
+{
+  auto records = ::generate_loop(1000);
+  champsim::bulk_tracereader<input_instr, champsim::columnar::columnar_istream<std::istringstream>> uut{
+      0, champsim::columnar::columnar_istream<std::istringstream>{std::istringstream{::encode(records, 128)}}};
+
+  for (std::size_t i = 0; i + 1 < std::size(records); ++i) {
+    auto instr = uut();
+    REQUIRE(instr.ip == champsim::address{records.at(i).ip});
+    REQUIRE(instr.is_branch == (records.at(i).is_branch != 0));
+    if (instr.is_branch) {
+      REQUIRE(instr.branch_target == champsim::address{records.at(i + 1).ip});
+    }
+  }
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A columnar stream rejects a trace without the columnar header")
+{
+  champsim::columnar::columnar_istream<std::istringstream> uut{std::istringstream{std::string(64, '\0')}};
+  std::array<char, 64> buf{};
+  REQUIRE_THROWS_AS(uut.read(std::data(buf), std::size(buf)), std::invalid_argument);
+}
+
+TEST_CASE("A columnar stream rejects a trace that ends partway through a block")
+{
+  auto records = ::generate_loop(1000);
+  auto encoded = ::encode(records, 300);
+
+  auto read_prefix = [&](std::size_t length) {
+    champsim::columnar::columnar_istream<std::istringstream> uut{std::istringstream{encoded.substr(0, length)}};
+    std::vector<input_instr> decoded(std::size(records));
+    uut.read(reinterpret_cast<char*>(std::data(decoded)), static_cast<std::streamsize>(std::size(decoded) * sizeof(input_instr)));
+  };
+
+  REQUIRE_THROWS_AS(read_prefix(champsim::columnar::file_header_size + champsim::columnar::block_header_size / 2), std::invalid_argument);
+  REQUIRE_THROWS_AS(read_prefix(std::size(encoded) - 1), std::invalid_argument);
+  REQUIRE_NOTHROW(read_prefix(std::size(encoded)));
+}
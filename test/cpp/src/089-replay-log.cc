@@ -0,0 +1,106 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "operable.h"
+#include "replay_log.h"
+
+namespace
+{
+// Retires one instruction per cycle, with an optional perturbation at a given cycle
+struct replay_test_operable final : public champsim::operable {
+  uint64_t cycle = 0;
+  uint64_t perturb_cycle = 0;
+
+  long operate() override
+  {
+    ++cycle;
+    if (replay_chain != nullptr && cycle % 2 == 0) {
+      replay_chain->add(champsim::replay::event::retire, (cycle == perturb_cycle) ? 0xdead : cycle);
+    }
+    return 1;
+  }
+};
+
+std::string record(uint64_t perturb_cycle, uint64_t num_cycles)
+{
+  std::ostringstream out;
+  champsim::replay::log log{out};
+  replay_test_operable quiet;
+  replay_test_operable busy;
+  busy.perturb_cycle = perturb_cycle;
+  log.attach(quiet, "quiet");
+  log.attach(busy, "busy");
+
+  for (uint64_t i = 0; i < num_cycles; ++i) {
+    quiet._operate();
+    busy._operate();
+  }
+  return out.str();
+}
+} // namespace
+
+TEST_CASE("Identical runs produce identical replay logs")
+{
+  std::istringstream lhs{::record(0, 100)};
+  std::istringstream rhs{::record(0, 100)};
+  REQUIRE_FALSE(champsim::replay::find_divergence(lhs, rhs).has_value());
+}
+
+TEST_CASE("The replay checker reports the first diverging cycle and component")
+{
+  std::istringstream lhs{::record(0, 100)};
+  std::istringstream rhs{::record(40, 100)};
+  auto result = champsim::replay::find_divergence(lhs, rhs);
+  REQUIRE(result.has_value());
+  REQUIRE(result->component == "busy");
+  REQUIRE(result->cycle == 40);
+}
+
+TEST_CASE("The replay checker reports a log that ends early")
+{
+  std::istringstream lhs{::record(0, 100)};
+  std::istringstream rhs{::record(0, 50)};
+  auto result = champsim::replay::find_divergence(lhs, rhs);
+  REQUIRE(result.has_value());
+  REQUIRE(result->cycle == 52);
+}
+
+TEST_CASE("A component without a replay log records nothing")
+{
+  replay_test_operable uut;
+  REQUIRE(uut.replay_chain == nullptr);
+  uut._operate();
+  REQUIRE(uut.cycle == 1);
+}
+
+TEST_CASE("A component that is operated by its owner records the same cycles as one that operates itself")
+{
+  auto run = [](bool by_owner) {
+    std::ostringstream out;
+    champsim::replay::log log{out};
+    replay_test_operable uut;
+    log.attach(uut, "uut");
+
+    for (uint64_t i = 0; i < 100; ++i) {
+      // The cycles are numbered by their count, not by the time, once the period changes
+      if (i == 50) {
+        uut.set_clock_period(champsim::chrono::picoseconds{3});
+      }
+
+      if (by_owner) {
+        uut.advance_cycle();
+        uut.operate();
+        uut.finish_cycle();
+      } else {
+        uut._operate();
+      }
+    }
+    return out.str();
+  };
+
+  std::istringstream lhs{run(false)};
+  std::istringstream rhs{run(true)};
+  REQUIRE_FALSE(champsim::replay::find_divergence(lhs, rhs).has_value());
+}
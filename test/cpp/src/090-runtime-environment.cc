@@ -0,0 +1,138 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+#include "module_registry.h"
+#include "runtime_environment.h"
+
+#include "../../../prefetcher/next_line/next_line.h"
+#include "../../../replacement/srrip/srrip.h"
+
+namespace
+{
+// A single core with private L1 caches and TLBs, and a shared LLC
+nlohmann::json small_config()
+{
+  return nlohmann::json::parse(R"({
+    "block_size": 64, "page_size": 4096,
+    "cores": [{
+      "name": "cpu0", "index": 0, "frequency": 4000, "rob_size": 64,
+      "L1I": "cpu0_L1I", "L1D": "cpu0_L1D", "branch_predictor": ["bimodal"], "btb": ["basic_btb"]
+    }],
+    "caches": [
+      {"name": "LLC", "defaults": "llc", "frequency": 4000, "sets": 512, "ways": 8, "latency": 20, "queue_factor": 32, "offset_bits": 6,
+       "lower_level": "DRAM", "replacement": ["srrip"]},
+      {"name": "cpu0_L1I", "defaults": "l1i", "frequency": 4000, "sets": 64, "ways": 8, "queue_factor": 32, "offset_bits": 6, "queue_check_full_addr": true,
+       "lower_level": "LLC", "lower_translate": "cpu0_ITLB"},
+      {"name": "cpu0_L1D", "defaults": "l1d", "frequency": 4000, "sets": 64, "ways": 12, "queue_factor": 32, "offset_bits": 6, "queue_check_full_addr": true,
+       "lower_level": "LLC", "lower_translate": "cpu0_DTLB", "prefetcher": ["next_line"], "prefetch_activate": ["LOAD"]},
+      {"name": "cpu0_ITLB", "defaults": "itlb", "frequency": 4000, "sets": 16, "ways": 4, "queue_factor": 16, "offset_bits": 12, "lower_level": "cpu0_PTW"},
+      {"name": "cpu0_DTLB", "defaults": "dtlb", "frequency": 4000, "sets": 16, "ways": 4, "queue_factor": 16, "offset_bits": 12, "lower_level": "cpu0_PTW"}
+    ],
+    "ptws": [{"name": "cpu0_PTW", "cpu": 0, "frequency": 4000, "queue_factor": 32, "lower_level": "cpu0_L1D"}],
+    "pmem": {"name": "DRAM", "data_rate": 3200, "frequency": 1600, "channels": 1, "ranks": 1, "bankgroups": 8, "banks": 4, "bank_rows": 65536,
+             "bank_columns": 1024, "channel_width": 8, "wq_size": 64, "rq_size": 64, "tRP": 24, "tRCD": 24, "tCAS": 24, "tRAS": 52,
+             "refresh_period": 32, "refreshes_per_period": 8192},
+    "vmem": {"pte_page_size": 4096, "num_levels": 5, "minor_fault_penalty": 200, "randomization": 1}
+  })");
+}
+
+CACHE& cache_named(champsim::environment& env, const std::string& name)
+{
+  auto caches = env.cache_view();
+  auto found = std::find_if(std::begin(caches), std::end(caches), [&name](const CACHE& c) { return c.NAME == name; });
+  REQUIRE(found != std::end(caches));
+  return found->get();
+}
+} // namespace
+
+TEST_CASE("A runtime environment builds every element of the configuration")
+{
+  champsim::runtime_environment uut{::small_config()};
+
+  REQUIRE(std::size(uut.cpu_view()) == 1);
+  REQUIRE(std::size(uut.cache_view()) == 5);
+  REQUIRE(std::size(uut.ptw_view()) == 1);
+  REQUIRE(std::size(uut.operable_view()) == 8);
+  REQUIRE(uut.cpu_view().front().get().ROB_SIZE == 64);
+}
+
+TEST_CASE("A runtime environment keeps the order of the configuration")
+{
+  auto config = ::small_config();
+  champsim::runtime_environment uut{config};
+
+  auto cpus = uut.cpu_view();
+  for (std::size_t i = 0; i < std::size(cpus); ++i) {
+    REQUIRE(cpus.at(i).get().cpu == i);
+  }
+
+  auto caches = uut.cache_view();
+  REQUIRE(std::size(caches) == std::size(config.at("caches")));
+  for (std::size_t i = 0; i < std::size(caches); ++i) {
+    REQUIRE(caches.at(i).get().NAME == config.at("caches").at(i).at("name").get<std::string>());
+  }
+}
+
+TEST_CASE("A runtime environment takes its geometry from the configuration")
+{
+  auto config = ::small_config();
+  config["caches"][0]["sets"] = 2048;
+  config["caches"][0]["ways"] = 16;
+  champsim::runtime_environment uut{config};
+
+  auto& llc = ::cache_named(uut, "LLC");
+  REQUIRE(llc.NUM_SET == 2048);
+  REQUIRE(llc.NUM_WAY == 16);
+  REQUIRE(::cache_named(uut, "cpu0_L1D").NUM_WAY == 12);
+}
+
+TEST_CASE("A runtime environment selects modules from the registry")
+{
+  champsim::runtime_environment uut{::small_config()};
+
+  auto& l1d = ::cache_named(uut, "cpu0_L1D");
+  REQUIRE(dynamic_cast<CACHE::prefetcher_module_model<next_line>*>(l1d.pref_module_pimpl.get()) != nullptr);
+
+  auto& llc = ::cache_named(uut, "LLC");
+  REQUIRE(dynamic_cast<CACHE::replacement_module_model<srrip>*>(llc.repl_module_pimpl.get()) != nullptr);
+}
+
+TEST_CASE("The module registry lists the compiled modules")
+{
+  auto prefetchers = champsim::modules::registry::prefetcher_names();
+  REQUIRE(std::find(std::begin(prefetchers), std::end(prefetchers), "next_line") != std::end(prefetchers));
+  REQUIRE_THROWS_AS(champsim::modules::registry::make_prefetcher("not_a_prefetcher", nullptr), std::invalid_argument);
+}
+
+TEST_CASE("A runtime environment rejects an inconsistent configuration")
+{
+  SECTION("An unknown module")
+  {
+    auto config = ::small_config();
+    config["caches"][0]["replacement"] = {"not_a_policy"};
+    REQUIRE_THROWS_AS(champsim::runtime_environment{config}, std::invalid_argument);
+  }
+
+  SECTION("More than one module of a kind")
+  {
+    auto config = ::small_config();
+    config["caches"][0]["replacement"] = {"srrip", "lru"};
+    REQUIRE_THROWS_AS(champsim::runtime_environment{config}, std::invalid_argument);
+  }
+
+  SECTION("An unknown lower level")
+  {
+    auto config = ::small_config();
+    config["caches"][0]["lower_level"] = "not_a_cache";
+    REQUIRE_THROWS_AS(champsim::runtime_environment{config}, std::invalid_argument);
+  }
+
+  SECTION("The wrong number of cores")
+  {
+    auto config = ::small_config();
+    config["cores"].push_back(config["cores"][0]);
+    REQUIRE_THROWS_AS(champsim::runtime_environment{config}, std::invalid_argument);
+  }
+}
@@ -0,0 +1,62 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+#include "runtime_environment.h"
+#include "startup.h"
+
+namespace
+{
+nlohmann::json small_config()
+{
+  return nlohmann::json::parse(R"({
+    "block_size": 64, "page_size": 4096,
+    "cores": [{
+      "name": "cpu0", "index": 0, "frequency": 4000, "rob_size": 64,
+      "L1I": "cpu0_L1I", "L1D": "cpu0_L1D", "branch_predictor": ["bimodal"], "btb": ["basic_btb"]
+    }],
+    "caches": [
+      {"name": "LLC", "defaults": "llc", "frequency": 4000, "sets": 512, "ways": 8, "latency": 20, "queue_factor": 32, "offset_bits": 6,
+       "lower_level": "DRAM", "replacement": ["srrip"]},
+      {"name": "cpu0_L1I", "defaults": "l1i", "frequency": 4000, "sets": 64, "ways": 8, "queue_factor": 32, "offset_bits": 6, "queue_check_full_addr": true,
+       "lower_level": "LLC", "lower_translate": "cpu0_ITLB"},
+      {"name": "cpu0_L1D", "defaults": "l1d", "frequency": 4000, "sets": 64, "ways": 12, "queue_factor": 32, "offset_bits": 6, "queue_check_full_addr": true,
+       "lower_level": "LLC", "lower_translate": "cpu0_DTLB", "prefetcher": ["next_line"], "prefetch_activate": ["LOAD"]},
+      {"name": "cpu0_ITLB", "defaults": "itlb", "frequency": 4000, "sets": 16, "ways": 4, "queue_factor": 16, "offset_bits": 12, "lower_level": "cpu0_PTW"},
+      {"name": "cpu0_DTLB", "defaults": "dtlb", "frequency": 4000, "sets": 16, "ways": 4, "queue_factor": 16, "offset_bits": 12, "lower_level": "cpu0_PTW"}
+    ],
+    "ptws": [{"name": "cpu0_PTW", "cpu": 0, "frequency": 4000, "queue_factor": 32, "lower_level": "cpu0_L1D"}],
+    "pmem": {"name": "DRAM", "data_rate": 3200, "frequency": 1600, "channels": 1, "ranks": 1, "bankgroups": 8, "banks": 4, "bank_rows": 65536,
+             "bank_columns": 1024, "channel_width": 8, "wq_size": 64, "rq_size": 64, "tRP": 24, "tRCD": 24, "tCAS": 24, "tRAS": 52,
+             "refresh_period": 32, "refreshes_per_period": 8192},
+    "vmem": {"pte_page_size": 4096, "num_levels": 5, "minor_fault_penalty": 200, "randomization": 1}
+  })");
+}
+
+std::vector<std::string> names_of(const std::vector<champsim::startup_time>& times)
+{
+  std::vector<std::string> result;
+  std::transform(std::begin(times), std::end(times), std::back_inserter(result), [](const auto& t) { return t.name; });
+  return result;
+}
+} // namespace
+
+TEST_CASE("Initialization reports the time taken by every component") {
+  champsim::runtime_environment env{::small_config()};
+  auto times = champsim::initialize(env, 1);
+  auto names = ::names_of(times);
+
+  REQUIRE(std::size(times) == std::size(env.operable_view()));
+  for (const auto* name : {"cpu0", "LLC", "cpu0_L1I", "cpu0_L1D", "cpu0_DTLB", "cpu0_PTW", "DRAM"}) {
+    REQUIRE(std::count(std::begin(names), std::end(names), name) == 1);
+  }
+  REQUIRE(std::all_of(std::begin(times), std::end(times), [](const auto& t) { return t.elapsed >= std::chrono::steady_clock::duration::zero(); }));
+}
+
+TEST_CASE("Initialization with several threads reports the components in the same order") {
+  champsim::runtime_environment serial{::small_config()};
+  champsim::runtime_environment parallel{::small_config()};
+
+  REQUIRE(::names_of(champsim::initialize(parallel, 4)) == ::names_of(champsim::initialize(serial, 1)));
+}
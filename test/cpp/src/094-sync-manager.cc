@@ -0,0 +1,97 @@
+#include <catch.hpp>
+
+#include <sstream>
+#include <stdexcept>
+
+#include "sync_manager.h"
+
+namespace
+{
+  // Read instructions from the trace until it is held back or the limit is reached
+  uint64_t read_until_blocked(champsim::sync_manager& uut, std::size_t thread, uint64_t limit)
+  {
+    uint64_t count = 0;
+    for (; count < limit && uut.may_read(thread); ++count)
+      uut.advance(thread);
+    return count;
+  }
+}
+
+TEST_CASE("Traces without synchronization events are never held back") {
+  champsim::sync_manager uut{};
+
+  REQUIRE(::read_until_blocked(uut, 0, 100) == 100);
+  REQUIRE_FALSE(uut.waiting_on(0).has_value());
+  REQUIRE(uut.events_passed(0) == 0);
+}
+
+TEST_CASE("A trace waits to acquire a lock that another trace holds") {
+  champsim::sync_manager uut{{
+    {0, 10, champsim::sync_kind::acquire, 7},
+    {0, 20, champsim::sync_kind::release, 7},
+    {1, 5, champsim::sync_kind::acquire, 7},
+    {1, 8, champsim::sync_kind::release, 7}
+  }};
+
+  REQUIRE(::read_until_blocked(uut, 0, 15) == 15);
+  REQUIRE(::read_until_blocked(uut, 1, 100) == 5);
+  REQUIRE(uut.waiting_on(1) == champsim::sync_kind::acquire);
+
+  REQUIRE(::read_until_blocked(uut, 0, 10) == 10);
+  REQUIRE(uut.events_passed(0) == 2);
+
+  REQUIRE(::read_until_blocked(uut, 1, 100) == 100);
+  REQUIRE_FALSE(uut.waiting_on(1).has_value());
+  REQUIRE(uut.events_passed(1) == 2);
+}
+
+TEST_CASE("Traces wait at a barrier until every trace that uses it arrives") {
+  champsim::sync_manager uut{{
+    {0, 10, champsim::sync_kind::barrier, 1},
+    {0, 20, champsim::sync_kind::barrier, 1},
+    {1, 30, champsim::sync_kind::barrier, 1},
+    {1, 40, champsim::sync_kind::barrier, 1},
+  }};
+
+  REQUIRE(::read_until_blocked(uut, 0, 100) == 10);
+  REQUIRE(uut.waiting_on(0) == champsim::sync_kind::barrier);
+  REQUIRE_FALSE(uut.may_read(0));
+
+  // The last trace to arrive does not wait, and goes on to the next episode of the barrier
+  REQUIRE(::read_until_blocked(uut, 1, 100) == 40);
+  REQUIRE(uut.waiting_on(1) == champsim::sync_kind::barrier);
+
+  // The first trace is released, and completes the second episode
+  REQUIRE(::read_until_blocked(uut, 0, 100) == 100);
+  REQUIRE(uut.events_passed(0) == 2);
+  REQUIRE(::read_until_blocked(uut, 1, 100) == 100);
+  REQUIRE(uut.events_passed(1) == 2);
+}
+
+TEST_CASE("Synchronization markers are read from a text file") {
+  std::istringstream markers{"# thread instruction kind id\n"
+                             "0 100 acquire 3\n"
+                             "\n"
+                             "  1 250 barrier 9\n"
+                             "0 120 release 3\n"};
+
+  auto events = champsim::read_sync_markers(markers);
+  REQUIRE(std::size(events) == 3);
+  REQUIRE(events.at(0).thread == 0);
+  REQUIRE(events.at(0).instr == 100);
+  REQUIRE(events.at(0).kind == champsim::sync_kind::acquire);
+  REQUIRE(events.at(0).id == 3);
+  REQUIRE(events.at(1).thread == 1);
+  REQUIRE(events.at(1).kind == champsim::sync_kind::barrier);
+  REQUIRE(events.at(2).kind == champsim::sync_kind::release);
+
+  champsim::sync_manager uut{events};
+  REQUIRE(uut.thread_count() == 2);
+}
+
+TEST_CASE("Malformed synchronization markers are rejected") {
+  auto line = GENERATE(as<std::string>{}, "0 100 acquire", "0 100 unlock 3", "zero 100 acquire 3");
+  std::istringstream markers{line};
+
+  REQUIRE_THROWS_AS(champsim::read_sync_markers(markers), std::invalid_argument);
+}
@@ -0,0 +1,126 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "os_scheduler.h"
+#include "instr.h"
+
+#include <functional>
+#include <vector>
+
+namespace
+{
+  champsim::tracereader trace_of_loads(uint64_t ip)
+  {
+    return champsim::tracereader{[ip]() mutable {
+      auto instr = champsim::test::instruction_with_ip_and_source_memory(champsim::address{ip}, champsim::address{0xcafe0000});
+      ip += 4;
+      return instr;
+    }};
+  }
+
+  uint64_t address_space_of(champsim::address addr) { return addr.to<uint64_t>() >> champsim::os_scheduler::address_space_shift; }
+}
+
+TEST_CASE("A disabled scheduler passes instructions through unchanged") {
+  champsim::os_scheduler uut{};
+  auto trace = ::trace_of_loads(0x1000);
+
+  REQUIRE_FALSE(uut.enabled());
+  auto instr = uut.next_instruction(0, 0, trace);
+  REQUIRE(instr.ip == champsim::address{0x1000});
+  REQUIRE(instr.source_memory.front() == champsim::address{0xcafe0000});
+}
+
+TEST_CASE("A scheduler places each trace in its own address space") {
+  champsim::os_scheduler uut{2, 1, champsim::scheduler_options{100, 0, false}};
+  auto trace_a = ::trace_of_loads(0x1000);
+  auto trace_b = ::trace_of_loads(0x1000);
+
+  auto first = uut.next_instruction(0, 0, trace_a);
+  auto second = uut.next_instruction(0, 1, trace_b);
+
+  REQUIRE(::address_space_of(first.ip) == 0);
+  REQUIRE(::address_space_of(second.ip) == 1);
+  REQUIRE(::address_space_of(second.source_memory.front()) == 1);
+  REQUIRE(first.source_memory.front() != second.source_memory.front());
+
+  // Instructions are numbered in the order the core receives them
+  REQUIRE(second.instr_id == first.instr_id + 1);
+}
+
+TEST_CASE("A scheduler rejects impossible configurations") {
+  REQUIRE_THROWS_AS((champsim::os_scheduler{1, 2, champsim::scheduler_options{100, 0, false}}), std::invalid_argument);
+  REQUIRE_THROWS_AS((champsim::os_scheduler{2, 1, champsim::scheduler_options{0, 0, false}}), std::invalid_argument);
+  REQUIRE_THROWS_AS((champsim::os_scheduler{champsim::os_scheduler::max_traces + 1, 1, champsim::scheduler_options{100, 0, false}}), std::invalid_argument);
+}
+
+SCENARIO("A core switches traces at the end of its time slice") {
+  GIVEN("Two traces that share one core") {
+    constexpr long long time_slice = 100;
+    constexpr long long switch_cost = 10;
+
+    champsim::channel data_queues, translate_queues, tlb_lower_queues;
+    do_nothing_MRC mock_L1I, mock_ll;
+    O3_CPU cpu{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&data_queues)};
+    CACHE l1d{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("095-L1D")
+                  .upper_levels({&data_queues})
+                  .lower_translate(&translate_queues)
+                  .lower_level(&mock_ll.queues)};
+    CACHE dtlb{champsim::cache_builder{champsim::defaults::default_dtlb}.name("095-DTLB").upper_levels({&translate_queues}).lower_level(&tlb_lower_queues)};
+
+    auto flush = GENERATE(false, true);
+    champsim::os_scheduler uut{2, 1, champsim::scheduler_options{time_slice, switch_cost, flush}};
+    std::vector<champsim::tracereader> traces;
+    traces.push_back(::trace_of_loads(0x1000));
+    traces.push_back(::trace_of_loads(0x8000));
+
+    uut.begin_phase({std::ref(cpu)}, {std::ref(l1d), std::ref(dtlb)});
+    for (int i = 0; i < 3; ++i) {
+      cpu.input_queue.push_back(uut.next_instruction(0, uut.trace_on(0), traces.at(uut.trace_on(0))));
+    }
+    dtlb.block.set(0)[0].valid = true;
+    l1d.block.set(0)[0].valid = true;
+
+    WHEN("The time slice has not ended") {
+      cpu.current_time += (time_slice - 1) * cpu.clock_period;
+
+      THEN("The core keeps its trace") {
+        REQUIRE(uut.operate(cpu) == 0);
+        REQUIRE(uut.trace_on(0) == 0);
+        REQUIRE(std::size(cpu.input_queue) == 3);
+      }
+    }
+
+    WHEN("The time slice ends") {
+      cpu.current_time += time_slice * cpu.clock_period;
+      REQUIRE(uut.operate(cpu) == 1);
+
+      THEN("The core runs the other trace after the cost of the switch") {
+        REQUIRE(uut.trace_on(0) == 1);
+        REQUIRE(cpu.fetch_resume_time >= cpu.current_time + switch_cost * cpu.clock_period);
+      }
+
+      THEN("The instructions that were not fetched are returned to their trace") {
+        REQUIRE(std::empty(cpu.input_queue));
+        REQUIRE(uut.has_instruction(0, traces.at(0)));
+        auto resumed = uut.next_instruction(0, 0, traces.at(0));
+        REQUIRE(resumed.ip == champsim::address{0x1000});
+      }
+
+      THEN("The translation caches are flushed only if requested") {
+        REQUIRE(dtlb.block.set(0)[0].valid != flush);
+        REQUIRE(l1d.block.set(0)[0].valid);
+      }
+
+      THEN("Each trace accounts for the cycles it ran") {
+        auto stats = uut.end_phase({std::ref(cpu)});
+        REQUIRE(std::size(stats) == 2);
+        REQUIRE(stats.at(0).cycles == time_slice);
+        REQUIRE(stats.at(0).context_switches == 0);
+        REQUIRE(stats.at(1).cycles == 0);
+        REQUIRE(stats.at(1).context_switches == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,46 @@
+#include <catch.hpp>
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("A worker pool calls the function once with each index") {
+  auto threads = GENERATE(as<std::size_t>{}, 1, 2, 4);
+  champsim::worker_pool uut{threads};
+  REQUIRE(uut.size() == threads);
+
+  std::vector<std::atomic<int>> calls(100);
+  for (int round = 0; round < 1000; ++round) {
+    uut.for_each_index(std::size(calls), [&calls](std::size_t idx) { ++calls[idx]; });
+  }
+
+  REQUIRE(std::all_of(std::begin(calls), std::end(calls), [](const auto& x) { return x == 1000; }));
+}
+
+TEST_CASE("A worker pool returns only after every call has returned") {
+  champsim::worker_pool uut{4};
+  std::atomic<int> finished{0};
+
+  uut.for_each_index(8, [&finished](std::size_t) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    ++finished;
+  });
+
+  REQUIRE(finished == 8);
+}
+
+TEST_CASE("A worker pool of one thread runs every call on the calling thread, in order") {
+  champsim::worker_pool uut{1};
+  std::vector<std::size_t> order;
+  std::vector<std::thread::id> ids;
+
+  uut.for_each_index(5, [&](std::size_t idx) {
+    order.push_back(idx);
+    ids.push_back(std::this_thread::get_id());
+  });
+
+  REQUIRE(order == std::vector<std::size_t>{0, 1, 2, 3, 4});
+  REQUIRE(std::all_of(std::begin(ids), std::end(ids), [](auto id) { return id == std::this_thread::get_id(); }));
+}
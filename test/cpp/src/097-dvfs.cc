@@ -0,0 +1,147 @@
+#include <catch.hpp>
+#include "defaults.hpp"
+#include "dvfs.h"
+
+#include <sstream>
+
+namespace
+{
+  struct counting_operable final : public champsim::operable {
+    using champsim::operable::operable;
+    long operate() final { return 1; }
+  };
+
+  struct dvfs_test_environment final : public champsim::environment {
+    champsim::channel dram_queues{64, 64, 64, champsim::data::bits{6}, false};
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{312},
+                           champsim::chrono::picoseconds{624},
+                           std::size_t{24},
+                           std::size_t{24},
+                           std::size_t{24},
+                           std::size_t{52},
+                           champsim::chrono::microseconds{64000},
+                           {&dram_queues},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           65536,
+                           1024,
+                           1,
+                           8,
+                           4,
+                           8192};
+    O3_CPU cpu{champsim::core_builder{}.index(0).clock_period(champsim::chrono::picoseconds{250}).decode_latency(3)};
+    CACHE l1d{champsim::cache_builder{champsim::defaults::default_l1d}.name("cpu0_L1D").clock_period(champsim::chrono::picoseconds{250}).hit_latency(4)};
+    CACHE llc{champsim::cache_builder{champsim::defaults::default_llc}.name("LLC").clock_period(champsim::chrono::picoseconds{1000}).hit_latency(10)};
+
+    std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {std::ref(cpu)}; }
+    std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {std::ref(l1d), std::ref(llc)}; }
+    std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {}; }
+    MEMORY_CONTROLLER& dram_view() final { return dram; }
+    std::vector<std::reference_wrapper<champsim::operable>> operable_view() final { return {std::ref(cpu), std::ref(l1d), std::ref(llc), std::ref(dram)}; }
+  };
+
+  champsim::chrono::clock::time_point at_ns(long long ns) { return champsim::chrono::clock::time_point{std::chrono::nanoseconds{ns}}; }
+} // namespace
+
+TEST_CASE("Changing the clock period keeps the cycles that have elapsed") {
+  ::counting_operable uut{champsim::chrono::picoseconds{250}};
+  for (int i = 0; i < 100; ++i)
+    uut._operate();
+  REQUIRE(uut.cycle_count() == 100);
+
+  uut.set_clock_period(champsim::chrono::picoseconds{500});
+  REQUIRE(uut.cycle_count() == 100);
+
+  for (int i = 0; i < 10; ++i)
+    uut._operate();
+  REQUIRE(uut.cycle_count() == 110);
+  REQUIRE(uut.current_time == ::at_ns(30));
+}
+
+TEST_CASE("Changing the clock period rescales latencies given in cycles") {
+  ::dvfs_test_environment env;
+  REQUIRE(env.l1d.HIT_LATENCY == champsim::chrono::picoseconds{1000});
+  REQUIRE(env.cpu.DECODE_LATENCY == champsim::chrono::picoseconds{750});
+
+  env.l1d.set_clock_period(champsim::chrono::picoseconds{500});
+  env.cpu.set_clock_period(champsim::chrono::picoseconds{500});
+
+  REQUIRE(env.l1d.HIT_LATENCY == champsim::chrono::picoseconds{2000});
+  REQUIRE(env.cpu.DECODE_LATENCY == champsim::chrono::picoseconds{1500});
+}
+
+TEST_CASE("A DVFS schedule changes the frequency of a domain at the given time") {
+  ::dvfs_test_environment env;
+  champsim::dvfs_controller uut{env, {champsim::dvfs_event{::at_ns(100), "cpu0*", 2000}}, std::nullopt};
+  REQUIRE(uut.enabled());
+  uut.begin_phase(::at_ns(0));
+
+  REQUIRE_FALSE(uut.operate(::at_ns(50)));
+  REQUIRE(env.cpu.clock_period == champsim::chrono::picoseconds{250});
+
+  REQUIRE(uut.operate(::at_ns(100)));
+  REQUIRE(env.cpu.clock_period == champsim::chrono::picoseconds{500});
+  REQUIRE(env.l1d.clock_period == champsim::chrono::picoseconds{500});
+  REQUIRE(env.llc.clock_period == champsim::chrono::picoseconds{1000});
+
+  auto stats = uut.end_phase(::at_ns(400));
+  REQUIRE(std::size(stats) == 1);
+  REQUIRE(stats.at(0).transitions == 1);
+  REQUIRE(stats.at(0).residency.at(4000) == std::chrono::nanoseconds{100});
+  REQUIRE(stats.at(0).residency.at(2000) == std::chrono::nanoseconds{300});
+}
+
+TEST_CASE("A DVFS domain selects components by name") {
+  ::dvfs_test_environment env;
+  champsim::dvfs_controller uut{env, {champsim::dvfs_event{::at_ns(0), "cpu0,LLC", 500}}, std::nullopt};
+  uut.begin_phase(::at_ns(0));
+  uut.operate(::at_ns(0));
+
+  REQUIRE(env.cpu.clock_period == champsim::chrono::picoseconds{2000});
+  REQUIRE(env.l1d.clock_period == champsim::chrono::picoseconds{250});
+  REQUIRE(env.llc.clock_period == champsim::chrono::picoseconds{2000});
+  REQUIRE(env.llc.HIT_LATENCY == champsim::chrono::picoseconds{20000});
+}
+
+TEST_CASE("DVFS domains must be disjoint, must match a component, and may not include the DRAM") {
+  ::dvfs_test_environment env;
+  REQUIRE_THROWS_AS((champsim::dvfs_controller{env, {champsim::dvfs_event{::at_ns(0), "cpu0*", 1000}, champsim::dvfs_event{::at_ns(0), "LLC,cpu0", 1000}},
+                                               std::nullopt}),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS((champsim::dvfs_controller{env, {champsim::dvfs_event{::at_ns(0), "cpu7", 1000}}, std::nullopt}), std::invalid_argument);
+  REQUIRE_THROWS_AS((champsim::dvfs_controller{env, {champsim::dvfs_event{::at_ns(0), "DRAM", 1000}}, std::nullopt}), std::invalid_argument);
+  REQUIRE_THROWS_AS((champsim::dvfs_controller{env, {champsim::dvfs_event{::at_ns(0), "LLC", 0}}, std::nullopt}), std::invalid_argument);
+}
+
+TEST_CASE("A DVFS governor lowers the frequency of an idle core") {
+  ::dvfs_test_environment env;
+  champsim::dvfs_controller uut{env, {}, champsim::dvfs_governor_options{{1000, 2000, 4000}, 10, 0.6, 0.3}};
+  uut.begin_phase(::at_ns(0));
+
+  // The first decision only records where the core began
+  REQUIRE_FALSE(uut.operate(::at_ns(0)));
+  env.cpu.current_time = ::at_ns(10);
+  REQUIRE(uut.operate(::at_ns(10)));
+  REQUIRE(env.cpu.clock_period == champsim::chrono::picoseconds{500});
+  REQUIRE(env.l1d.clock_period == champsim::chrono::picoseconds{500});
+
+  // The LLC is not private to the core
+  REQUIRE(env.llc.clock_period == champsim::chrono::picoseconds{1000});
+  REQUIRE(uut.end_phase(::at_ns(10)).at(0).name == "cpu0,cpu0_*");
+}
+
+TEST_CASE("A DVFS schedule is read from a file") {
+  std::istringstream input{"# time_ns domain MHz\n\n100 cpu0,cpu0_* 2000\n  250 LLC 1500\n"};
+  auto events = champsim::read_dvfs_schedule(input);
+
+  REQUIRE(std::size(events) == 2);
+  REQUIRE(events.at(0).time == ::at_ns(100));
+  REQUIRE(events.at(0).domain == "cpu0,cpu0_*");
+  REQUIRE(events.at(0).frequency == 2000);
+  REQUIRE(events.at(1).domain == "LLC");
+
+  std::istringstream malformed{"100 LLC\n"};
+  REQUIRE_THROWS_AS(champsim::read_dvfs_schedule(malformed), std::invalid_argument);
+}
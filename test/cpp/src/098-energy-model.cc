@@ -0,0 +1,147 @@
+#include <catch.hpp>
+#include "defaults.hpp"
+#include "energy_model.h"
+
+#include <nlohmann/json.hpp>
+
+namespace
+{
+  struct energy_test_environment final : public champsim::environment {
+    champsim::channel dram_queues{64, 64, 64, champsim::data::bits{6}, false};
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{312},
+                           champsim::chrono::picoseconds{624},
+                           std::size_t{24},
+                           std::size_t{24},
+                           std::size_t{24},
+                           std::size_t{52},
+                           champsim::chrono::microseconds{64000},
+                           {&dram_queues},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           65536,
+                           1024,
+                           1,
+                           8,
+                           4,
+                           8192};
+    O3_CPU cpu;
+    CACHE llc{champsim::cache_builder{champsim::defaults::default_llc}.name("LLC").sets(512).ways(16).clock_period(champsim::chrono::picoseconds{500})};
+
+    explicit energy_test_environment(uint32_t cpu_index = 0) : cpu{champsim::core_builder{}.index(cpu_index)} {}
+
+    std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {std::ref(cpu)}; }
+    std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {std::ref(llc)}; }
+    std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {}; }
+    MEMORY_CONTROLLER& dram_view() final { return dram; }
+    std::vector<std::reference_wrapper<champsim::operable>> operable_view() final { return {std::ref(cpu), std::ref(llc), std::ref(dram)}; }
+  };
+
+  champsim::phase_stats phase_of(champsim::chrono::clock::duration elapsed, uint32_t cpu_index = 0)
+  {
+    champsim::phase_stats stats;
+    stats.elapsed = elapsed;
+
+    O3_CPU::stats_type cpu;
+    cpu.name = "CPU " + std::to_string(cpu_index);
+    cpu.end_instrs = 1000;
+    cpu.end_cycles = 4000;
+    stats.sim_cpu_stats.push_back(cpu);
+
+    CACHE::stats_type llc;
+    llc.name = "LLC";
+    llc.end_cycles = 20;
+    llc.hits.increment(std::pair{access_type::LOAD, 0u});
+    llc.misses.increment(std::pair{access_type::LOAD, 0u});
+    llc.misses.increment(std::pair{access_type::LOAD, 0u});
+    llc.mshr_merge.increment(std::pair{access_type::LOAD, 0u});
+    stats.sim_cache_stats.push_back(llc);
+
+    DRAM_CHANNEL::stats_type channel;
+    channel.name = "Channel 0";
+    channel.RQ_ROW_BUFFER_HIT = 3;
+    channel.RQ_ROW_BUFFER_MISS = 2;
+    channel.WQ_ROW_BUFFER_MISS = 1;
+    channel.refresh_cycles = 1;
+    stats.sim_dram_stats.push_back(channel);
+
+    return stats;
+  }
+} // namespace
+
+TEST_CASE("The default energies of a cache grow with its size and associativity") {
+  auto small = champsim::default_cache_energy(64, 8, 64);
+  auto large = champsim::default_cache_energy(2048, 16, 64);
+
+  REQUIRE(small.data_access == Approx(9.0)); // 32 KiB is a point of the table
+  REQUIRE(small.tag_access == Approx(0.45 * 8));
+  REQUIRE(large.data_access == Approx(65.0)); // 2 MiB
+  REQUIRE(large.leakage > small.leakage);
+
+  auto tiny = champsim::default_cache_energy(16, 4, 8);
+  REQUIRE(tiny.data_access > 0);
+  REQUIRE(tiny.data_access < small.data_access);
+}
+
+TEST_CASE("The energy model multiplies each event count by its energy") {
+  ::energy_test_environment env;
+  nlohmann::json overrides{{"cpu0", {{"dispatch", 1}, {"retire", 2}, {"leakage", 3}}},
+                           {"LLC", {{"tag_access", 10}, {"data_access", 100}, {"leakage", 1}}},
+                           {"DRAM", {{"activate", 1}, {"precharge", 2}, {"read", 10}, {"write", 20}, {"refresh", 1000}, {"background", 0}}}};
+  champsim::energy_model uut{env, overrides};
+
+  auto result = uut.account(::phase_of(champsim::chrono::picoseconds{5000}));
+  REQUIRE(std::size(result) == 4);
+
+  REQUIRE(result.at(0).name == "CPU 0");
+  REQUIRE(result.at(0).dynamic == Approx(1000 * 3));
+  REQUIRE(result.at(0).leakage == Approx(4000 * 3));
+
+  // Three lookups, and one hit and one fill, since one of the misses merged with the other
+  REQUIRE(result.at(1).name == "LLC");
+  REQUIRE(result.at(1).dynamic == Approx(3 * 10 + 2 * 100));
+  REQUIRE(result.at(1).leakage == Approx(20)); // the cycles that the cache counted, not the phase time over its configured period
+
+  REQUIRE(result.at(2).dynamic == Approx(3 * (1 + 2) + 5 * 10 + 1 * 20 + 1000));
+
+  REQUIRE(result.at(3).name == "System");
+  REQUIRE(result.at(3).total() == Approx(result.at(0).total() + result.at(1).total() + result.at(2).total()));
+  REQUIRE(result.at(3).edp() == Approx(result.at(3).total() * 1e-12 * 5e-9));
+}
+
+TEST_CASE("The energy model rejects unknown components and energies") {
+  ::energy_test_environment env;
+  REQUIRE_THROWS_AS((champsim::energy_model{env, nlohmann::json{{"L4C", {{"leakage", 1}}}}}), std::invalid_argument);
+  REQUIRE_THROWS_AS((champsim::energy_model{env, nlohmann::json{{"LLC", {{"dispatch", 1}}}}}), std::invalid_argument);
+}
+
+TEST_CASE("The energy model matches cores by their index") {
+  ::energy_test_environment env{1};
+  champsim::energy_model uut{env, nlohmann::json{{"cpu1", {{"dispatch", 1}, {"retire", 2}, {"leakage", 3}}}}};
+
+  auto result = uut.account(::phase_of(champsim::chrono::picoseconds{5000}, 1));
+  REQUIRE(result.at(0).name == "CPU 1");
+  REQUIRE(result.at(0).dynamic == Approx(1000 * 3));
+  REQUIRE(result.at(0).leakage == Approx(4000 * 3));
+
+  REQUIRE_THROWS_AS((champsim::energy_model{env, nlohmann::json{{"cpu0", {{"leakage", 1}}}}}), std::invalid_argument);
+}
+
+TEST_CASE("A cache counts the cycles of a phase at each of its clock periods") {
+  champsim::channel lower_queues{};
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}.name("LLC").clock_period(champsim::chrono::picoseconds{500}).lower_level(&lower_queues)};
+  uut.initialize();
+  uut.begin_phase();
+  for (int i = 0; i < 10; ++i) {
+    uut._operate();
+  }
+  uut.set_clock_period(champsim::chrono::picoseconds{1000});
+  for (int i = 0; i < 5; ++i) {
+    uut._operate();
+  }
+  uut.end_phase(0);
+
+  REQUIRE(uut.sim_stats.cycles() == 15);
+  REQUIRE(uut.roi_stats.cycles() == 15);
+}
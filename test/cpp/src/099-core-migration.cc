@@ -0,0 +1,190 @@
+#include <catch.hpp>
+#include "os_scheduler.h"
+#include "instr.h"
+
+#include <functional>
+#include <vector>
+
+namespace
+{
+  champsim::tracereader trace_of_loads(uint64_t ip)
+  {
+    return champsim::tracereader{[ip]() mutable {
+      auto instr = champsim::test::instruction_with_ip_and_source_memory(champsim::address{ip}, champsim::address{0xcafe0000});
+      ip += 4;
+      return instr;
+    }};
+  }
+
+  O3_CPU big_core(uint32_t cpu)
+  {
+    return O3_CPU{champsim::core_builder{}
+                      .index(cpu)
+                      .core_type("big")
+                      .rob_size(256)
+                      .dispatch_width(champsim::bandwidth::maximum_type{6})
+                      .retire_width(champsim::bandwidth::maximum_type{4})};
+  }
+
+  O3_CPU little_core(uint32_t cpu)
+  {
+    return O3_CPU{champsim::core_builder{}
+                      .index(cpu)
+                      .core_type("little")
+                      .rob_size(64)
+                      .dispatch_width(champsim::bandwidth::maximum_type{2})
+                      .retire_width(champsim::bandwidth::maximum_type{2})};
+  }
+
+  void advance(O3_CPU& cpu, long long cycles, long long instrs)
+  {
+    cpu.current_time += cycles * cpu.clock_period;
+    cpu.num_retired += instrs;
+  }
+} // namespace
+
+TEST_CASE("A core builder names the type of the core") {
+  O3_CPU uut{champsim::core_builder{}.core_type("little")};
+  REQUIRE(uut.CORE_TYPE == "little");
+  REQUIRE(O3_CPU{champsim::core_builder{}}.CORE_TYPE == "default");
+}
+
+TEST_CASE("A scheduler rejects a migration policy without an interval") {
+  REQUIRE_THROWS_AS((champsim::os_scheduler{2, 2, champsim::scheduler_options{100, 0, false, champsim::migration_policy::periodic, 0}}),
+                    std::invalid_argument);
+}
+
+SCENARIO("Traces migrate periodically between a big and a little core") {
+  GIVEN("A big and a little core, each running one trace") {
+    constexpr long long interval = 100;
+    constexpr long long switch_cost = 10;
+
+    O3_CPU big = ::big_core(0);
+    O3_CPU little = ::little_core(1);
+    std::vector<std::reference_wrapper<O3_CPU>> cpus{std::ref(big), std::ref(little)};
+
+    champsim::os_scheduler uut{2, 2, champsim::scheduler_options{1000000, switch_cost, false, champsim::migration_policy::periodic, interval}};
+    std::vector<champsim::tracereader> traces;
+    traces.push_back(::trace_of_loads(0x1000));
+    traces.push_back(::trace_of_loads(0x8000));
+
+    uut.begin_phase(cpus, {});
+    for (O3_CPU& cpu : cpus) {
+      for (int i = 0; i < 3; ++i) {
+        cpu.input_queue.push_back(uut.next_instruction(cpu.cpu, uut.trace_on(cpu.cpu), traces.at(uut.trace_on(cpu.cpu))));
+      }
+    }
+
+    WHEN("The interval has not ended") {
+      ::advance(big, interval - 1, 10);
+      ::advance(little, interval - 1, 10);
+
+      THEN("The traces stay on their cores") {
+        REQUIRE(uut.migrate(cpus) == 0);
+        REQUIRE(uut.trace_on(0) == 0);
+        REQUIRE(uut.trace_on(1) == 1);
+      }
+    }
+
+    WHEN("The interval ends") {
+      ::advance(big, interval, 300);
+      ::advance(little, interval, 100);
+      REQUIRE(uut.migrate(cpus) == 2);
+
+      THEN("The traces swap cores after the cost of the migration") {
+        REQUIRE(uut.trace_on(0) == 1);
+        REQUIRE(uut.trace_on(1) == 0);
+        REQUIRE(big.fetch_resume_time >= big.current_time + switch_cost * big.clock_period);
+        REQUIRE(little.fetch_resume_time >= little.current_time + switch_cost * little.clock_period);
+      }
+
+      THEN("A trace continues on its new core where it left off") {
+        REQUIRE(std::empty(big.input_queue));
+        REQUIRE(std::empty(little.input_queue));
+        auto resumed = uut.next_instruction(1, 0, traces.at(0));
+        REQUIRE(resumed.ip == champsim::address{0x1000});
+      }
+
+      THEN("The next migration returns the traces to their first cores") {
+        ::advance(big, interval, 100);
+        ::advance(little, interval, 300);
+        REQUIRE(uut.migrate(cpus) == 2);
+        REQUIRE(uut.trace_on(0) == 0);
+        REQUIRE(uut.trace_on(1) == 1);
+
+        auto stats = uut.end_phase(cpus);
+        REQUIRE(stats.at(0).migrations == 2);
+        REQUIRE(stats.at(0).instrs == 600);
+        REQUIRE(stats.at(0).cycles == 2 * interval);
+        REQUIRE(std::size(stats.at(0).core_types) == 2);
+        REQUIRE(stats.at(0).core_types.at(0).name == "big");
+        REQUIRE(stats.at(0).core_types.at(0).instrs == 300);
+        REQUIRE(stats.at(0).core_types.at(1).name == "little");
+        REQUIRE(stats.at(0).core_types.at(1).instrs == 300);
+      }
+    }
+  }
+}
+
+SCENARIO("Phase-based migration places the trace that uses the most of its core on the big core") {
+  GIVEN("A big and a little core, each running one trace") {
+    constexpr long long interval = 100;
+
+    O3_CPU big = ::big_core(0);
+    O3_CPU little = ::little_core(1);
+    std::vector<std::reference_wrapper<O3_CPU>> cpus{std::ref(big), std::ref(little)};
+
+    champsim::os_scheduler uut{2, 2, champsim::scheduler_options{1000000, 0, false, champsim::migration_policy::phase, interval}};
+    uut.begin_phase(cpus, {});
+
+    WHEN("The trace on the big core uses more of its width") {
+      ::advance(big, interval, 300);
+      ::advance(little, interval, 100);
+
+      THEN("The traces stay on their cores") {
+        REQUIRE(uut.migrate(cpus) == 0);
+        REQUIRE(uut.trace_on(0) == 0);
+      }
+    }
+
+    WHEN("The trace on the little core uses more of its width") {
+      ::advance(big, interval, 100);
+      ::advance(little, interval, 150);
+
+      THEN("The traces swap cores") {
+        REQUIRE(uut.migrate(cpus) == 2);
+        REQUIRE(uut.trace_on(0) == 1);
+        REQUIRE(uut.trace_on(1) == 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("Traces do not migrate between cores of the same type") {
+  O3_CPU first = ::big_core(0);
+  O3_CPU second = ::big_core(1);
+  std::vector<std::reference_wrapper<O3_CPU>> cpus{std::ref(first), std::ref(second)};
+
+  champsim::os_scheduler uut{2, 2, champsim::scheduler_options{1000000, 0, false, champsim::migration_policy::periodic, 10}};
+  uut.begin_phase(cpus, {});
+  ::advance(first, 10, 0);
+  ::advance(second, 10, 0);
+  REQUIRE(uut.migrate(cpus) == 0);
+}
+
+TEST_CASE("Traces do not migrate between cores of the same size") {
+  O3_CPU first = ::big_core(0);
+  O3_CPU second{champsim::core_builder{}
+                    .index(1)
+                    .core_type("renamed")
+                    .rob_size(256)
+                    .dispatch_width(champsim::bandwidth::maximum_type{6})
+                    .retire_width(champsim::bandwidth::maximum_type{4})};
+  std::vector<std::reference_wrapper<O3_CPU>> cpus{std::ref(first), std::ref(second)};
+
+  champsim::os_scheduler uut{2, 2, champsim::scheduler_options{1000000, 0, false, champsim::migration_policy::periodic, 10}};
+  uut.begin_phase(cpus, {});
+  ::advance(first, 10, 0);
+  ::advance(second, 10, 0);
+  REQUIRE(uut.migrate(cpus) == 0);
+}
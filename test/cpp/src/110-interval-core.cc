@@ -0,0 +1,143 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+#include "instr.h"
+
+#include <limits>
+
+namespace
+{
+  auto interval_builder(champsim::bandwidth::maximum_type dispatch_width, champsim::channel* fetch_queues, champsim::channel* data_queues)
+  {
+    return champsim::core_builder{}
+      .model(champsim::core_model::interval)
+      .ifetch_buffer_size(64)
+      .rob_size(8)
+      .lq_size(4)
+      .sq_size(4)
+      .fetch_width(champsim::bandwidth::maximum_type{4})
+      .dispatch_width(dispatch_width)
+      .retire_width(champsim::bandwidth::maximum_type{4})
+      .lq_width(champsim::bandwidth::maximum_type{2})
+      .fetch_queues(fetch_queues)
+      .data_queues(data_queues);
+  }
+
+  template <typename... Ops>
+  void run_cycles(int cycles, Ops&... ops)
+  {
+    for (int i = 0; i < cycles; ++i)
+      (ops._operate(), ...);
+  }
+
+  ooo_model_instr load(uint64_t id, champsim::address smem)
+  {
+    auto instr = champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x1000 + 4 * id}, smem);
+    instr.instr_id = id;
+    return instr;
+  }
+
+  ooo_model_instr plain(uint64_t id)
+  {
+    auto instr = champsim::test::instruction_with_ip(0x1000 + 4 * id);
+    instr.instr_id = id;
+    return instr;
+  }
+}
+
+TEST_CASE("An interval core dispatches at its full width between miss events") {
+  auto cycles_to_retire = [](long width) {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{::interval_builder(champsim::bandwidth::maximum_type{width}, &mock_L1I.queues, &mock_L1D.queues)};
+    uut.warmup = false;
+    for (uint64_t id = 1; id <= 32; ++id)
+      uut.IFETCH_BUFFER.push_back(::plain(id));
+
+    int cycles = 0;
+    for (; cycles < 1000 && uut.num_retired < 32; ++cycles)
+      ::run_cycles(1, uut, mock_L1I, mock_L1D);
+    return cycles;
+  };
+
+  auto narrow = cycles_to_retire(1);
+  auto wide = cycles_to_retire(4);
+  REQUIRE(narrow >= 32);
+  REQUIRE(wide < narrow / 2);
+}
+
+TEST_CASE("A long-latency load blocks retirement, but dispatch continues until the ROB is full") {
+  do_nothing_MRC mock_L1I;
+  release_MRC mock_L1D;
+  O3_CPU uut{::interval_builder(champsim::bandwidth::maximum_type{4}, &mock_L1I.queues, &mock_L1D.queues)};
+  uut.warmup = false;
+
+  uut.IFETCH_BUFFER.push_back(::load(1, champsim::address{0xcafe0000}));
+  for (uint64_t id = 2; id <= 20; ++id)
+    uut.IFETCH_BUFFER.push_back(::plain(id));
+
+  ::run_cycles(50, uut, mock_L1I, mock_L1D);
+  REQUIRE(mock_L1D.packet_count() == 1);
+  REQUIRE(uut.num_retired == 0);
+  REQUIRE(std::size(uut.ROB) == uut.ROB_SIZE);
+
+  mock_L1D.release_all();
+  ::run_cycles(50, uut, mock_L1I, mock_L1D);
+  REQUIRE(uut.num_retired == 20);
+}
+
+TEST_CASE("Independent loads overlap in an interval core, but dependent loads do not") {
+  do_nothing_MRC mock_L1I;
+  release_MRC mock_L1D;
+  O3_CPU uut{::interval_builder(champsim::bandwidth::maximum_type{4}, &mock_L1I.queues, &mock_L1D.queues)};
+  uut.warmup = false;
+
+  auto first = ::load(1, champsim::address{0xcafe0000});
+  first.destination_registers.push_back(5);
+  auto second = ::load(2, champsim::address{0xbeef0000});
+
+  SECTION("Independent loads") {
+    uut.IFETCH_BUFFER.push_back(first);
+    uut.IFETCH_BUFFER.push_back(second);
+
+    ::run_cycles(20, uut, mock_L1I, mock_L1D);
+    REQUIRE(mock_L1D.packet_count() == 2);
+  }
+
+  SECTION("Dependent loads") {
+    second.source_registers.push_back(5);
+    uut.IFETCH_BUFFER.push_back(first);
+    uut.IFETCH_BUFFER.push_back(second);
+
+    ::run_cycles(20, uut, mock_L1I, mock_L1D);
+    REQUIRE(mock_L1D.packet_count() == 1);
+
+    mock_L1D.release_all();
+    ::run_cycles(20, uut, mock_L1I, mock_L1D);
+    REQUIRE(mock_L1D.packet_count() == 2);
+  }
+}
+
+TEST_CASE("A mispredicted branch in an interval core resumes fetch only after its sources complete") {
+  do_nothing_MRC mock_L1I;
+  release_MRC mock_L1D;
+  O3_CPU uut{::interval_builder(champsim::bandwidth::maximum_type{4}, &mock_L1I.queues, &mock_L1D.queues)};
+  uut.warmup = false;
+
+  auto producer = ::load(1, champsim::address{0xcafe0000});
+  producer.destination_registers.push_back(5);
+  auto branch = ::plain(2);
+  branch.source_registers.push_back(5);
+  branch.branch_mispredicted = true;
+
+  uut.IFETCH_BUFFER.push_back(producer);
+  uut.IFETCH_BUFFER.push_back(branch);
+  uut.fetch_resume_time = champsim::chrono::clock::time_point::max();
+
+  ::run_cycles(20, uut, mock_L1I, mock_L1D);
+  REQUIRE(uut.fetch_resume_time == champsim::chrono::clock::time_point::max());
+
+  mock_L1D.release_all();
+  ::run_cycles(20, uut, mock_L1I, mock_L1D);
+  REQUIRE(uut.fetch_resume_time != champsim::chrono::clock::time_point::max());
+  REQUIRE(uut.num_retired == 2);
+}
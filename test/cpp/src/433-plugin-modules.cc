@@ -0,0 +1,199 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+#include "module_registry.h"
+#include "plugin.h"
+
+#include <map>
+#include <vector>
+
+namespace
+{
+  struct plugin_state {
+    const champsim_plugin_services* services;
+    champsim_plugin_cache* cache;
+  };
+
+  std::vector<uint64_t> operated_addresses;
+  std::vector<long> filled_ways;
+  int live_instances = 0;
+  plugin_state* last_created = nullptr;
+
+  void* test_create(const champsim_plugin_services* services, champsim_plugin_cache* cache)
+  {
+    ++::live_instances;
+    ::last_created = new plugin_state{services, cache};
+    return ::last_created;
+  }
+
+  void test_destroy(void* self)
+  {
+    --::live_instances;
+    delete static_cast<plugin_state*>(self);
+  }
+
+  uint32_t test_cache_operate(void* self, uint64_t addr, uint64_t, int, int, uint32_t, uint32_t metadata_in)
+  {
+    auto state = static_cast<plugin_state*>(self);
+    ::operated_addresses.push_back(addr);
+    auto offset_bits = state->services->offset_bits(state->cache);
+    state->services->prefetch_line(state->cache, ((addr >> offset_bits) + 1) << offset_bits, 1, metadata_in);
+    return metadata_in;
+  }
+
+  long test_find_victim(void* self, uint32_t, uint64_t, long, uint64_t, uint64_t, uint32_t)
+  {
+    auto state = static_cast<plugin_state*>(self);
+    return state->services->num_way(state->cache) - 1;
+  }
+
+  void test_replacement_fill(void*, uint32_t, long, long way, uint64_t, uint64_t, uint64_t, uint32_t)
+  {
+    ::filled_ways.push_back(way);
+  }
+
+  const champsim_prefetcher_plugin_vtable test_prefetcher{CHAMPSIM_PLUGIN_ABI_VERSION, test_create, test_destroy, nullptr, test_cache_operate, nullptr, nullptr, nullptr, nullptr};
+  const champsim_replacement_plugin_vtable test_replacement{CHAMPSIM_PLUGIN_ABI_VERSION, test_create, test_destroy, nullptr, test_find_victim, nullptr, test_replacement_fill, nullptr};
+}
+
+SCENARIO("A plugin prefetcher issues prefetches through the cache services") {
+  GIVEN("A cache whose prefetcher is a plugin") {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE move_source{champsim::cache_builder{champsim::defaults::default_l1d}
+      .name("433-uut")
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+    move_source.pref_module_pimpl = champsim::plugin::make_prefetcher(&::test_prefetcher, &move_source);
+    CACHE uut{std::move(move_source)};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A packet is issued") {
+      ::operated_addresses.clear();
+
+      decltype(mock_ul)::request_type seed;
+      seed.address = champsim::address{0xffff'003f};
+      seed.cpu = 0;
+      auto seed_result = mock_ul.issue(seed);
+      THEN("The issue is accepted") {
+        REQUIRE(seed_result);
+      }
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The plugin sees the access") {
+        REQUIRE(::operated_addresses == std::vector<uint64_t>{0xffff'003f});
+      }
+
+      THEN("The prefetch of the next line reaches the lower level") {
+        REQUIRE(std::size(mock_ll.addresses) == 2);
+        REQUIRE(champsim::block_number{mock_ll.addresses.at(1)} == champsim::block_number{mock_ll.addresses.at(0)} + 1);
+      }
+    }
+  }
+}
+
+SCENARIO("A plugin replacement policy chooses the victim") {
+  GIVEN("A full set") {
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+      .name("433-uut-repl")
+      .sets(1)
+      .ways(4)
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+    };
+    uut.repl_module_pimpl = champsim::plugin::make_replacement(&::test_replacement, &uut);
+
+    uint64_t resident_address = 0xcafe'0000;
+    for (std::size_t idx = 0; idx < uut.block.size(); ++idx) {
+      auto& blk = uut.block.at(idx);
+      blk.valid = true;
+      blk.address = champsim::address{resident_address};
+      resident_address += 64;
+    }
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A miss fills the cache") {
+      ::filled_ways.clear();
+
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.is_translated = true;
+      test.cpu = 0;
+      auto test_result = mock_ul.issue(test);
+      THEN("The issue is accepted") {
+        REQUIRE(test_result);
+      }
+
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      mock_ll.release_all();
+      for (auto i = 0; i < 100; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("The block is placed in the way the plugin chose") {
+        REQUIRE(::filled_ways == std::vector<long>{3});
+      }
+    }
+  }
+}
+
+TEST_CASE("Plugin instances are destroyed with their module") {
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}};
+  auto before = ::live_instances;
+  {
+    auto module = champsim::plugin::make_prefetcher(&::test_prefetcher, &uut);
+    REQUIRE(::live_instances == before + 1);
+  }
+  REQUIRE(::live_instances == before);
+}
+
+TEST_CASE("A plugin built against another version of the interface is rejected") {
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}};
+  auto old_version = ::test_prefetcher;
+  old_version.abi_version = CHAMPSIM_PLUGIN_ABI_VERSION + 1;
+  REQUIRE_THROWS_AS(champsim::plugin::make_prefetcher(&old_version, &uut), std::invalid_argument);
+}
+
+TEST_CASE("The module registry treats names of shared objects as plugins") {
+  REQUIRE(champsim::plugin::is_plugin_name("./my_prefetcher.so"));
+  REQUIRE_FALSE(champsim::plugin::is_plugin_name("next_line"));
+  REQUIRE_FALSE(champsim::plugin::is_plugin_name(".so"));
+
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}};
+  REQUIRE_THROWS_AS(champsim::modules::registry::make_prefetcher("/does/not/exist.so", &uut), std::runtime_error);
+}
+
+TEST_CASE("A plugin reads blocks without allocating the pages of their sets") {
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}.sets(4096)};
+  auto module = champsim::plugin::make_prefetcher(&::test_prefetcher, &uut);
+  auto* state = ::last_created;
+  const auto pages_before = uut.block.allocated_pages();
+
+  REQUIRE(state->services->block_valid(state->cache, 4095, 0) == 0);
+  REQUIRE(state->services->block_address(state->cache, 2048, 1) == 0);
+  REQUIRE(uut.block.allocated_pages() == pages_before);
+}
@@ -0,0 +1,121 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+#include "modules.h"
+#include "plugin.h"
+
+#include "../../../prefetcher/next_line/next_line.h"
+
+namespace
+{
+  // A counting hook, once compiled in and once behind the plugin interface
+  struct compiled_counter : champsim::modules::prefetcher
+  {
+    using prefetcher::prefetcher;
+    uint64_t sum = 0;
+
+    uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address, uint8_t, bool, access_type, uint32_t metadata_in)
+    {
+      sum += addr.to<uint64_t>();
+      return metadata_in;
+    }
+
+    uint32_t prefetcher_cache_fill(champsim::address, long, long, uint8_t, champsim::address, uint32_t metadata_in) { return metadata_in; }
+  };
+
+  void* counter_create(const champsim_plugin_services*, champsim_plugin_cache*) { return new uint64_t{0}; }
+  void counter_destroy(void* self) { delete static_cast<uint64_t*>(self); }
+
+  uint32_t counter_cache_operate(void* self, uint64_t addr, uint64_t, int, int, uint32_t, uint32_t metadata_in)
+  {
+    *static_cast<uint64_t*>(self) += addr;
+    return metadata_in;
+  }
+
+  const champsim_prefetcher_plugin_vtable plugin_counter{CHAMPSIM_PLUGIN_ABI_VERSION, counter_create, counter_destroy, nullptr, counter_cache_operate, nullptr, nullptr, nullptr, nullptr};
+
+  // The next line prefetcher, behind the plugin interface
+  struct next_line_state {
+    const champsim_plugin_services* services;
+    champsim_plugin_cache* cache;
+  };
+
+  void* next_line_create(const champsim_plugin_services* services, champsim_plugin_cache* cache) { return new next_line_state{services, cache}; }
+  void next_line_destroy(void* self) { delete static_cast<next_line_state*>(self); }
+
+  uint32_t next_line_cache_operate(void* self, uint64_t addr, uint64_t, int, int, uint32_t, uint32_t metadata_in)
+  {
+    auto state = static_cast<next_line_state*>(self);
+    auto offset_bits = state->services->offset_bits(state->cache);
+    state->services->prefetch_line(state->cache, ((addr >> offset_bits) + 1) << offset_bits, 1, metadata_in);
+    return metadata_in;
+  }
+
+  const champsim_prefetcher_plugin_vtable plugin_next_line{CHAMPSIM_PLUGIN_ABI_VERSION, next_line_create, next_line_destroy, nullptr, next_line_cache_operate, nullptr, nullptr, nullptr, nullptr};
+
+  // Stream loads through a cache, so that the hooks are measured alongside the work the cache does for each access
+  template <typename Builder, typename Setup>
+  std::size_t stream_loads(Builder builder, Setup&& setup)
+  {
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{builder.upper_levels({&mock_ul.queues}).lower_level(&mock_ll.queues)};
+    setup(uut);
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    for (uint64_t i = 0; i < 1024; ++i) {
+      decltype(mock_ul)::request_type load;
+      load.address = champsim::address{0x1000'0000 + (i << 7)};
+      load.is_translated = true;
+      load.cpu = 0;
+      mock_ul.issue(load);
+
+      for (auto j = 0; j < 4; ++j)
+        for (auto elem : elements)
+          elem->_operate();
+      mock_ll.release_all();
+    }
+
+    return mock_ll.packet_count();
+  }
+}
+
+TEST_CASE("The plugin interface adds little overhead to a prefetcher hook") {
+  CACHE compiled{champsim::cache_builder{champsim::defaults::default_l1d}.prefetcher<::compiled_counter>()};
+  CACHE plugin{champsim::cache_builder{champsim::defaults::default_l1d}};
+  plugin.pref_module_pimpl = champsim::plugin::make_prefetcher(&::plugin_counter, &plugin);
+
+  constexpr uint64_t calls = 1 << 16;
+
+  BENCHMARK("Compiled-in prefetcher hook") {
+    uint32_t result = 0;
+    for (uint64_t i = 0; i < calls; ++i)
+      result += compiled.impl_prefetcher_cache_operate(champsim::address{i << 6}, champsim::address{}, false, false, access_type::LOAD, 1);
+    return result;
+  };
+
+  BENCHMARK("Plugin prefetcher hook") {
+    uint32_t result = 0;
+    for (uint64_t i = 0; i < calls; ++i)
+      result += plugin.impl_prefetcher_cache_operate(champsim::address{i << 6}, champsim::address{}, false, false, access_type::LOAD, 1);
+    return result;
+  };
+}
+
+TEST_CASE("The plugin interface adds little overhead to a cache") {
+  BENCHMARK("Compiled-in next_line") {
+    return ::stream_loads(champsim::cache_builder{champsim::defaults::default_l1d}.prefetcher<next_line>(), [](CACHE&) {});
+  };
+
+  BENCHMARK("Plugin next_line") {
+    return ::stream_loads(champsim::cache_builder{champsim::defaults::default_l1d},
+        [](CACHE& uut) { uut.pref_module_pimpl = champsim::plugin::make_prefetcher(&::plugin_next_line, &uut); });
+  };
+}
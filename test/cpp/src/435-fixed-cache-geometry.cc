@@ -0,0 +1,172 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+
+#include <array>
+#include <random>
+#include <vector>
+
+namespace
+{
+  using geometry = champsim::fixed_cache_geometry<64, 8, 6>;
+
+  struct stream_result {
+    long hits;
+    long misses;
+    std::size_t lower_level_packets;
+  };
+
+  // Load a working set slightly larger than the cache, twice, so that some loads hit, some miss, and blocks are evicted
+  template <typename Builder>
+  stream_result stream_loads(Builder builder)
+  {
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{builder.upper_levels({&mock_ul.queues}).lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    std::mt19937_64 rng{435};
+    std::uniform_int_distribution<uint64_t> block_dist{0, 64 * 8 * 5 / 4};
+    for (auto i = 0; i < 2048; ++i) {
+      decltype(mock_ul)::request_type load;
+      load.address = champsim::address{0x8000'0000 + (block_dist(rng) << 6)};
+      load.is_translated = true;
+      load.cpu = 0;
+      mock_ul.issue(load);
+
+      for (auto j = 0; j < 4; ++j)
+        for (auto elem : elements)
+          elem->_operate();
+      mock_ll.release_all();
+    }
+
+    return {uut.sim_stats.hits.value_or(std::pair{access_type::LOAD, 0u}, 0), uut.sim_stats.misses.value_or(std::pair{access_type::LOAD, 0u}, 0),
+            mock_ll.packet_count()};
+  }
+}
+
+TEST_CASE("A fixed geometry selects the same set as the runtime geometry") {
+  std::mt19937_64 rng{435};
+  for (auto i = 0; i < 1000; ++i) {
+    champsim::address addr{rng()};
+    REQUIRE(geometry::set_index(addr) == addr.slice(champsim::dynamic_extent{champsim::data::bits{6}, 6}).to<long>());
+  }
+}
+
+TEST_CASE("A fixed geometry finds blocks in a set") {
+  std::array<champsim::cache_block, 8> set{};
+  for (std::size_t way = 0; way < std::size(set); ++way) {
+    set[way].address = champsim::address{0x1000 * (way + 1)};
+  }
+  set[2].valid = true;
+  set[5].valid = true;
+
+  SECTION("Only valid blocks hit") {
+    REQUIRE(geometry::table.find_valid(std::data(set), champsim::address{0x3000}) == 2);
+    REQUIRE(geometry::table.find_valid(std::data(set), champsim::address{0x2000}) == 8);
+  }
+
+  SECTION("The offset is ignored") {
+    REQUIRE(geometry::table.find_valid(std::data(set), champsim::address{0x603f}) == 5);
+  }
+
+  SECTION("Invalid blocks can be found by address") {
+    REQUIRE(geometry::table.find_any(std::data(set), champsim::address{0x2000}) == 1);
+  }
+
+  SECTION("The first invalid way is found") {
+    REQUIRE(geometry::table.find_invalid(std::data(set)) == 0);
+    set[0].valid = true;
+    set[1].valid = true;
+    REQUIRE(geometry::table.find_invalid(std::data(set)) == 3);
+  }
+
+  SECTION("A full set has no invalid way") {
+    for (auto& blk : set)
+      blk.valid = true;
+    REQUIRE(geometry::table.find_invalid(std::data(set)) == 8);
+  }
+}
+
+TEST_CASE("A geometry table searches sets of any associativity") {
+  auto ways = GENERATE(as<uint32_t>{}, 1, 6, 12, 16);
+  champsim::cache_geometry_table table{64, ways, champsim::data::bits{6}};
+
+  std::vector<champsim::cache_block> set(ways);
+  for (std::size_t way = 0; way < std::size(set); ++way) {
+    set[way].address = champsim::address{0x1000 * (way + 1)};
+    set[way].valid = true;
+  }
+  set.back().valid = false;
+
+  REQUIRE(table.find_valid(std::data(set), champsim::address{0x1000}) == (ways > 1 ? 0 : long{ways}));
+  REQUIRE(table.find_any(std::data(set), champsim::address{0x1000 * ways}) == long{ways} - 1);
+  REQUIRE(table.find_valid(std::data(set), champsim::address{0x1000 * (ways + 1)}) == long{ways});
+  REQUIRE(table.find_invalid(std::data(set)) == long{ways} - 1);
+}
+
+TEST_CASE("A cache uses its fixed geometry only if the geometry was not changed afterward") {
+  CACHE fixed{champsim::cache_builder{champsim::defaults::default_l1d}.fixed_geometry<64, 8, 6>()};
+  REQUIRE(fixed.fixed_geometry == &geometry::table);
+  REQUIRE(fixed.NUM_SET == 64);
+  REQUIRE(fixed.NUM_WAY == 8);
+
+  CACHE changed{champsim::cache_builder{champsim::defaults::default_l1d}.fixed_geometry<64, 8, 6>().ways(4)};
+  REQUIRE(changed.fixed_geometry == nullptr);
+
+  CACHE runtime{champsim::cache_builder{champsim::defaults::default_l1d}.sets(64).ways(8)};
+  REQUIRE(runtime.fixed_geometry == nullptr);
+
+  CACHE moved{std::move(fixed)};
+  REQUIRE(moved.fixed_geometry == &geometry::table);
+}
+
+TEST_CASE("A cache with a fixed geometry behaves like one with a runtime geometry") {
+  auto fixed = ::stream_loads(champsim::cache_builder{champsim::defaults::default_l1d}.fixed_geometry<64, 8, 6>());
+  auto runtime = ::stream_loads(champsim::cache_builder{champsim::defaults::default_l1d}.sets(64).ways(8).offset_bits(champsim::data::bits{6}));
+
+  REQUIRE(fixed.hits > 0);
+  REQUIRE(fixed.misses > 0);
+  REQUIRE(fixed.hits == runtime.hits);
+  REQUIRE(fixed.misses == runtime.misses);
+  REQUIRE(fixed.lower_level_packets == runtime.lower_level_packets);
+}
+
+TEST_CASE("A fixed geometry speeds up set searches") {
+  CACHE runtime{champsim::cache_builder{champsim::defaults::default_llc}.sets(2048).ways(16).offset_bits(champsim::data::bits{6})};
+  CACHE fixed{champsim::cache_builder{champsim::defaults::default_llc}.fixed_geometry<2048, 16, 6>()};
+
+  // No block matches, so every search checks every way
+  constexpr uint64_t searches = 1 << 16;
+
+  BENCHMARK("Runtime geometry") {
+    long result = 0;
+    for (uint64_t i = 1; i <= searches; ++i)
+      result += runtime.invalidate_entry(champsim::address{i << 6});
+    return result;
+  };
+
+  BENCHMARK("Fixed geometry") {
+    long result = 0;
+    for (uint64_t i = 1; i <= searches; ++i)
+      result += fixed.invalidate_entry(champsim::address{i << 6});
+    return result;
+  };
+}
+
+TEST_CASE("A fixed geometry speeds up tag checks") {
+  BENCHMARK("Runtime geometry") {
+    return ::stream_loads(champsim::cache_builder{champsim::defaults::default_l1d}.sets(64).ways(8).offset_bits(champsim::data::bits{6}));
+  };
+
+  BENCHMARK("Fixed geometry") {
+    return ::stream_loads(champsim::cache_builder{champsim::defaults::default_l1d}.fixed_geometry<64, 8, 6>());
+  };
+}
@@ -0,0 +1,98 @@
+#include <catch.hpp>
+#include "defaults.hpp"
+#include "cache.h"
+#include "dram_controller.h"
+
+#include <array>
+#include <deque>
+
+namespace
+{
+  struct hierarchy {
+    champsim::channel core_queues{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    champsim::channel l1d_to_l2c{}, l2c_to_llc{}, llc_to_dram{};
+
+    CACHE l1d{champsim::cache_builder{champsim::defaults::default_l1d}.name("436-L1D").upper_levels({&core_queues}).lower_level(&l1d_to_l2c)};
+    CACHE l2c{champsim::cache_builder{champsim::defaults::default_l2c}.name("436-L2C").upper_levels({&l1d_to_l2c}).lower_level(&l2c_to_llc)};
+    CACHE llc{champsim::cache_builder{champsim::defaults::default_llc}.name("436-LLC").upper_levels({&l2c_to_llc}).lower_level(&llc_to_dram)};
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200}, champsim::chrono::picoseconds{1600}, 18, 18, 18, 38, champsim::chrono::microseconds{64000},
+                           {&llc_to_dram}, 64, 64, 1, champsim::data::bytes{8}, 65536, 1024, 2, 2, 4, 8192};
+
+    std::array<champsim::operable*, 4> elements{{&l1d, &l2c, &llc, &dram}};
+
+    std::size_t returned = 0;
+    uint64_t next_block = 1;
+
+    hierarchy()
+    {
+      for (auto elem : elements) {
+        elem->initialize();
+        elem->warmup = false;
+        elem->begin_phase();
+      }
+    }
+
+    // Load distinct blocks, so that every load misses in every cache and is returned from DRAM
+    void load(std::size_t count)
+    {
+      std::size_t issued = 0;
+      for (int cycle = 0; cycle < 100000 && returned < count; ++cycle) {
+        if (issued < count) {
+          champsim::channel::request_type pkt;
+          pkt.address = champsim::address{next_block << LOG2_BLOCK_SIZE};
+          pkt.v_address = pkt.address;
+          pkt.cpu = 0;
+          pkt.instr_depend_on_me = {issued, issued + 1};
+          if (core_queues.add_rq(pkt)) {
+            ++issued;
+            ++next_block;
+          }
+        }
+
+        for (auto elem : elements)
+          elem->_operate();
+
+        returned += std::size(core_queues.returned);
+        core_queues.returned.clear();
+      }
+    }
+  };
+} // namespace
+
+TEST_CASE("Packets cross the memory hierarchy without allocating dependency lists") {
+  hierarchy uut;
+
+  // The first loads fill the pools
+  uut.load(256);
+  REQUIRE(uut.returned == 256);
+
+  auto instr_allocations = champsim::pooled_list<uint64_t>::heap_allocations();
+  auto return_allocations = champsim::pooled_list<std::deque<champsim::channel::response_type>*>::heap_allocations();
+
+  uut.returned = 0;
+  uut.load(1024);
+  REQUIRE(uut.returned == 1024);
+
+  CHECK(champsim::pooled_list<uint64_t>::heap_allocations() == instr_allocations);
+  CHECK(champsim::pooled_list<std::deque<champsim::channel::response_type>*>::heap_allocations() == return_allocations);
+}
+
+TEST_CASE("Loads cross the memory hierarchy without allocating from the pools") {
+  hierarchy uut;
+  uut.load(256);
+
+  // Allocations are counted by the pools rather than by replacing the global allocator, so that only those made for dependency lists are measured
+  auto allocations = [] {
+    return champsim::pooled_list<uint64_t>::heap_allocations() + champsim::pooled_list<std::deque<champsim::channel::response_type>*>::heap_allocations();
+  };
+  auto before = allocations();
+
+  constexpr std::size_t loads = 1024;
+  BENCHMARK("1024 loads") {
+    uut.returned = 0;
+    uut.load(loads);
+    return uut.returned;
+  };
+
+  CHECK(allocations() == before);
+}
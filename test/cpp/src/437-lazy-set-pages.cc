@@ -0,0 +1,168 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "block_array.h"
+#include "cache.h"
+
+#include <algorithm>
+#include <array>
+
+TEST_CASE("A block array allocates a page when one of its sets is modified") {
+  constexpr std::size_t sets = 4 * champsim::block_array::sets_per_page;
+  champsim::block_array uut{sets, 8};
+  REQUIRE(uut.size() == sets * 8);
+  REQUIRE(uut.page_count() == 4);
+  REQUIRE(uut.allocated_pages() == 1);
+
+  const auto& const_uut = uut;
+  auto set_idx = 2 * champsim::block_array::sets_per_page + 5;
+
+  SECTION("Reading an untouched set finds invalid blocks") {
+    const auto* set = const_uut.set(set_idx);
+    REQUIRE(std::none_of(set, set + 8, [](const auto& blk) { return blk.valid; }));
+    REQUIRE(uut.allocated_pages() == 1);
+  }
+
+  SECTION("Modifying a set keeps its blocks") {
+    uut.set(set_idx)[3].valid = true;
+    REQUIRE(uut.allocated_pages() == 2);
+    REQUIRE(const_uut.set(set_idx)[3].valid);
+    REQUIRE(const_uut.at(set_idx * 8 + 3).valid);
+    REQUIRE_FALSE(const_uut.set(set_idx + 1)[3].valid);
+  }
+
+  SECTION("Invalidating the array clears its blocks, but allocates no pages") {
+    uut.set(set_idx)[3].valid = true;
+    uut.invalidate();
+    REQUIRE_FALSE(const_uut.set(set_idx)[3].valid);
+    REQUIRE(uut.allocated_pages() == 2);
+  }
+
+  SECTION("Blocks beyond the array are rejected") {
+    REQUIRE_THROWS_AS(const_uut.at(uut.size()), std::out_of_range);
+  }
+}
+
+TEST_CASE("A small block array is allocated at once") {
+  champsim::block_array uut{16, 4};
+  REQUIRE(uut.page_count() == 1);
+  REQUIRE(uut.allocated_pages() == 1);
+}
+
+SCENARIO("A large cache holds only the pages of the sets it fills") {
+  GIVEN("A cache with many sets") {
+    constexpr uint32_t sets = 1 << 16;
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("437-uut")
+                  .sets(sets)
+                  .ways(16)
+                  .offset_bits(champsim::data::bits{6})
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    REQUIRE(uut.block.allocated_pages() == 1);
+
+    WHEN("Loads to a few distant sets miss and fill") {
+      constexpr uint64_t loads = 8;
+      for (uint64_t i = 0; i < loads; ++i) {
+        decltype(mock_ul)::request_type load;
+        load.address = champsim::address{(i * sets / loads) << 6};
+        load.is_translated = true;
+        load.cpu = 0;
+        mock_ul.issue(load);
+      }
+
+      for (auto i = 0; i < 1000; ++i) {
+        for (auto elem : elements)
+          elem->_operate();
+        mock_ll.release_all();
+      }
+
+      THEN("Only the pages of those sets are allocated") {
+        REQUIRE(mock_ll.packet_count() == loads);
+        REQUIRE(uut.block.allocated_pages() == loads);
+      }
+
+      AND_THEN("The loads hit when repeated") {
+        for (uint64_t i = 0; i < loads; ++i) {
+          decltype(mock_ul)::request_type load;
+          load.address = champsim::address{(i * sets / loads) << 6};
+          load.is_translated = true;
+          load.cpu = 0;
+          mock_ul.issue(load);
+        }
+
+        for (auto i = 0; i < 1000; ++i) {
+          for (auto elem : elements)
+            elem->_operate();
+          mock_ll.release_all();
+        }
+
+        REQUIRE(uut.sim_stats.hits.value_or(std::pair{access_type::LOAD, 0u}, 0) == loads);
+        REQUIRE(uut.block.allocated_pages() == loads);
+      }
+    }
+  }
+}
+
+SCENARIO("A cache does not allocate the pages of sets that it only probes") {
+  GIVEN("A cache with many sets") {
+    constexpr uint32_t sets = 1 << 16;
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_llc}
+                  .name("437-uut")
+                  .sets(sets)
+                  .ways(16)
+                  .offset_bits(champsim::data::bits{6})
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Loads to distant sets miss and are never returned") {
+      constexpr uint64_t loads = 8;
+      for (uint64_t i = 0; i < loads; ++i) {
+        decltype(mock_ul)::request_type load;
+        load.address = champsim::address{(i * sets / loads) << 6};
+        load.is_translated = true;
+        load.cpu = 0;
+        mock_ul.issue(load);
+      }
+
+      for (auto i = 0; i < 100; ++i) {
+        for (auto elem : elements)
+          elem->_operate();
+      }
+
+      THEN("No page is allocated beyond the first") {
+        REQUIRE(mock_ll.packet_count() == loads);
+        REQUIRE(uut.block.allocated_pages() == 1);
+      }
+    }
+
+    WHEN("Addresses that are not cached are invalidated") {
+      for (uint64_t i = 1; i < 8; ++i) {
+        uut.invalidate_entry(champsim::address{(i * sets / 8) << 6});
+      }
+
+      THEN("No page is allocated beyond the first") {
+        REQUIRE(uut.block.allocated_pages() == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,140 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+#include "cache.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <utility>
+
+TEST_CASE("A set sampler selects the sets that have no bits in common with the mask") {
+  champsim::set_sampler uut{16, 3};
+
+  REQUIRE(uut.enabled());
+  REQUIRE(uut.sampled_sets() == 4);
+  REQUIRE(uut.total_sets() == 16);
+  REQUIRE(uut.is_sampled(0));
+  REQUIRE(uut.is_sampled(8));
+  REQUIRE_FALSE(uut.is_sampled(1));
+  REQUIRE_FALSE(uut.is_sampled(14));
+  REQUIRE(uut.sample_index(8) == 2);
+}
+
+TEST_CASE("A set sampler without a mask samples every set") {
+  champsim::set_sampler uut{16, 0};
+
+  REQUIRE_FALSE(uut.enabled());
+  REQUIRE(uut.sampled_sets() == 16);
+  REQUIRE(uut.is_sampled(13));
+}
+
+TEST_CASE("A set sampler models the average latency of the sampled sets") {
+  champsim::set_sampler uut{16, 3};
+  const champsim::chrono::clock::duration fallback{champsim::chrono::picoseconds{1000}};
+
+  REQUIRE(uut.average_latency(fallback) == fallback);
+
+  uut.record_latency(champsim::chrono::picoseconds{2000});
+  uut.record_latency(champsim::chrono::picoseconds{4000});
+  REQUIRE(uut.average_latency(fallback) == champsim::chrono::picoseconds{3000});
+}
+
+TEST_CASE("Misses are extrapolated from the sampled sets") {
+  cache_stats stats;
+  stats.sampled_sets = 2;
+  stats.total_sets = 8;
+  stats.sampled_set_misses = {10, 20};
+
+  REQUIRE(champsim::is_sampled(stats));
+
+  auto estimate = champsim::estimate_misses(stats);
+  REQUIRE(estimate.value == Approx(120));
+  REQUIRE(estimate.confidence == Approx(1.96 * 8 * std::sqrt(50.0 / 2 * (1 - 2.0 / 8))));
+}
+
+TEST_CASE("Statistics that cover every set are not extrapolated") {
+  cache_stats stats;
+  stats.misses.increment(std::pair{access_type::LOAD, 0u});
+
+  REQUIRE_FALSE(champsim::is_sampled(stats));
+  REQUIRE(champsim::estimate_misses(stats).value == Approx(1));
+  REQUIRE(champsim::estimate_misses(stats).confidence == Approx(0));
+}
+
+namespace
+{
+  struct stream_result {
+    cache_stats stats;
+    std::size_t lower_level_packets;
+    std::size_t returned;
+    std::size_t issued;
+    std::size_t unsampled_valid_blocks;
+  };
+
+  // Load a working set twice as large as the cache, so that many loads miss
+  stream_result stream_loads(uint64_t mask)
+  {
+    do_nothing_MRC mock_ll{20};
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .sets(64)
+                  .ways(8)
+                  .offset_bits(champsim::data::bits{6})
+                  .set_sample_mask(mask)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &mock_ul, &uut}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    std::mt19937_64 rng{438};
+    std::uniform_int_distribution<uint64_t> block_dist{0, 64 * 8 * 2};
+    for (auto i = 0; i < 8192; ++i) {
+      decltype(mock_ul)::request_type load;
+      load.address = champsim::address{0x8000'0000 + (block_dist(rng) << 6)};
+      load.is_translated = true;
+      load.cpu = 0;
+      mock_ul.issue(load);
+
+      for (auto j = 0; j < 4; ++j)
+        for (auto elem : elements)
+          elem->_operate();
+    }
+    for (auto j = 0; j < 200; ++j)
+      for (auto elem : elements)
+        elem->_operate();
+
+    std::size_t unsampled_valid = 0;
+    for (long set = 0; set < 64; ++set) {
+      if (!uut.sampler.is_sampled(set)) {
+        const auto* blocks = std::as_const(uut.block).set(static_cast<std::size_t>(set));
+        unsampled_valid += static_cast<std::size_t>(std::count_if(blocks, blocks + 8, [](const auto& blk) { return blk.valid; }));
+      }
+    }
+
+    auto returned = std::count_if(std::begin(mock_ul.packets), std::end(mock_ul.packets), [](const auto& x) { return x.return_time > 0; });
+    return {uut.sim_stats, mock_ll.packet_count(), static_cast<std::size_t>(returned), std::size(mock_ul.packets), unsampled_valid};
+  }
+}
+
+TEST_CASE("A cache that samples its sets responds to every access, but only sampled sets reach the lower level") {
+  auto full = ::stream_loads(0);
+  auto sampled = ::stream_loads(3);
+
+  REQUIRE(sampled.returned == sampled.issued);
+  REQUIRE(sampled.unsampled_valid_blocks == 0);
+  REQUIRE(sampled.lower_level_packets < full.lower_level_packets / 2);
+
+  REQUIRE(champsim::is_sampled(sampled.stats));
+  REQUIRE_FALSE(champsim::is_sampled(full.stats));
+
+  auto estimate = champsim::estimate_misses(sampled.stats);
+  REQUIRE(estimate.confidence > 0);
+  REQUIRE(estimate.value == Approx(static_cast<double>(full.stats.misses.total())).epsilon(0.15));
+}
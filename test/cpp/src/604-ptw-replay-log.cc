@@ -0,0 +1,67 @@
+#include <catch.hpp>
+#include "mocks.hpp"
+#include "defaults.hpp"
+
+#include "dram_controller.h"
+#include "ptw.h"
+#include "replay_log.h"
+#include "vmem.h"
+
+#include <array>
+#include <sstream>
+#include <string>
+
+namespace
+{
+  // Walk a single address through a 5-level virtual memory, recording the walker in a replay log
+  std::string record_walk(champsim::address walk_address)
+  {
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200}, champsim::chrono::picoseconds{6400}, std::size_t{18}, std::size_t{18}, std::size_t{18}, std::size_t{38}, champsim::chrono::microseconds{64000}, {}, 64, 64, 1, champsim::data::bytes{8}, 1024, 1024, 4, 4, 4, 8192};
+    VirtualMemory vmem{champsim::data::bytes{1<<12}, 5, champsim::chrono::nanoseconds{640}, dram};
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    PageTableWalker uut{champsim::ptw_builder{champsim::defaults::default_ptw}
+      .name("604-uut")
+      .clock_period(champsim::chrono::picoseconds{3200})
+      .upper_levels({&mock_ul.queues})
+      .lower_level(&mock_ll.queues)
+      .virtual_memory(&vmem)
+    };
+
+    std::ostringstream out;
+    champsim::replay::log log{out};
+    log.attach(uut, uut.NAME);
+
+    std::array<champsim::operable*, 3> elements{{&mock_ul, &uut, &mock_ll}};
+
+    uut.warmup = false;
+    uut.begin_phase();
+
+    decltype(mock_ul)::request_type test;
+    test.address = walk_address;
+    test.v_address = test.address;
+    test.cpu = 0;
+    REQUIRE(mock_ul.issue(test));
+
+    for (auto i = 0; i < 10000; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    return out.str();
+  }
+}
+
+TEST_CASE("A page table walker records the steps of its walks in the replay log") {
+  auto first = ::record_walk(champsim::address{0xdeadbeef});
+  REQUIRE_FALSE(std::empty(first));
+
+  std::istringstream lhs{first};
+  std::istringstream rhs{::record_walk(champsim::address{0xdeadbeef})};
+  REQUIRE_FALSE(champsim::replay::find_divergence(lhs, rhs).has_value());
+
+  std::istringstream same{first};
+  std::istringstream other{::record_walk(champsim::address{0xcafef00d})};
+  auto result = champsim::replay::find_divergence(same, other);
+  REQUIRE(result.has_value());
+  REQUIRE(result->component == "604-uut");
+}
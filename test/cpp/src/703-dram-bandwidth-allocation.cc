@@ -0,0 +1,161 @@
+#include <catch.hpp>
+#include "dram_controller.h"
+#include "token_bucket.h"
+
+#include <algorithm>
+#include <array>
+
+TEST_CASE("A token bucket allows a burst, then one token per interval") {
+  const champsim::chrono::clock::duration interval{champsim::chrono::picoseconds{100}};
+  champsim::token_bucket uut{interval, 3};
+  champsim::chrono::clock::time_point now{};
+
+  REQUIRE(uut.limited());
+  for (int i = 0; i < 3; ++i) {
+    REQUIRE(uut.may_take(now));
+    uut.take(now);
+  }
+  REQUIRE_FALSE(uut.may_take(now));
+  REQUIRE_FALSE(uut.may_take(now + interval / 2));
+  REQUIRE(uut.may_take(now + interval));
+
+  uut.take(now + interval);
+  REQUIRE_FALSE(uut.may_take(now + interval));
+}
+
+TEST_CASE("A token bucket does not store more than its burst") {
+  const champsim::chrono::clock::duration interval{champsim::chrono::picoseconds{100}};
+  champsim::token_bucket uut{interval, 2};
+  const champsim::chrono::clock::time_point later{interval * 50};
+
+  uut.take(later);
+  uut.take(later);
+  REQUIRE_FALSE(uut.may_take(later));
+}
+
+TEST_CASE("A default token bucket is never empty") {
+  champsim::token_bucket uut{};
+  champsim::chrono::clock::time_point now{};
+
+  REQUIRE_FALSE(uut.limited());
+  for (int i = 0; i < 100; ++i)
+    uut.take(now);
+  REQUIRE(uut.may_take(now));
+}
+
+TEST_CASE("A token bucket must hold at least one token") {
+  REQUIRE_THROWS_AS((champsim::token_bucket{champsim::chrono::picoseconds{100}, 0}), std::invalid_argument);
+}
+
+namespace
+{
+  MEMORY_CONTROLLER make_controller(champsim::channel* ul, std::size_t rq_size)
+  {
+    return MEMORY_CONTROLLER{champsim::chrono::picoseconds{312},
+                             champsim::chrono::picoseconds{624},
+                             std::size_t{24},
+                             std::size_t{24},
+                             std::size_t{24},
+                             std::size_t{52},
+                             champsim::chrono::microseconds{64000},
+                             {ul},
+                             rq_size,
+                             64,
+                             1,
+                             champsim::data::bytes{8},
+                             65536,
+                             1024,
+                             1,
+                             8,
+                             4,
+                             8192};
+  }
+
+  void start(MEMORY_CONTROLLER& uut)
+  {
+    uut.warmup = false;
+    uut.begin_phase();
+  }
+
+  champsim::channel::request_type make_read(uint32_t cpu, uint64_t index)
+  {
+    champsim::channel::request_type req;
+    req.type = access_type::LOAD;
+    req.cpu = cpu;
+    req.address = champsim::address{(uint64_t{cpu} << 32) + (index << 6)};
+    req.response_requested = true;
+    return req;
+  }
+}
+
+TEST_CASE("A core with a share of the memory bandwidth is held to that share") {
+  champsim::channel ul{64, 64, 64, champsim::data::bits{6}, false};
+  auto uut = ::make_controller(&ul, 64);
+  ::start(uut);
+  uut.set_allocations({{25, 0}});
+
+  std::array<uint64_t, 2> issued{};
+  std::array<uint64_t, 2> returned{};
+  const long cycles = 20000;
+  for (long i = 0; i < cycles; ++i) {
+    // Both cores always have requests waiting
+    for (uint32_t cpu = 0; cpu < 2; ++cpu) {
+      while (std::count_if(std::begin(ul.RQ), std::end(ul.RQ), [cpu](const auto& x) { return x.cpu == cpu; }) < 8)
+        ul.add_rq(::make_read(cpu, issued[cpu]++));
+    }
+
+    uut._operate();
+
+    for (const auto& ret : ul.returned)
+      ++returned[ret.address.to<uint64_t>() >> 32];
+    ul.returned.clear();
+  }
+
+  // One request per data transfer, at a quarter of the peak
+  const auto limit = MEMORY_CONTROLLER::allocation_burst + static_cast<uint64_t>(uut.current_time.time_since_epoch() / (uut.channels[0].DRAM_DBUS_RETURN_TIME * 4));
+  REQUIRE(returned[0] <= limit);
+  REQUIRE(returned[0] > limit / 2);
+  REQUIRE(returned[1] > returned[0]);
+  REQUIRE(uut.channels[0].sim_stats.cores.at(0).throttled_request_cycles > 0);
+}
+
+TEST_CASE("Requests from cores with a higher priority enter the channel queues first") {
+  champsim::channel ul{64, 64, 64, champsim::data::bits{6}, false};
+  auto uut = ::make_controller(&ul, 4);
+  ::start(uut);
+  uut.set_allocations({{100, 0}, {100, 1}});
+
+  for (uint64_t i = 0; i < 4; ++i)
+    ul.add_rq(::make_read(0, i));
+  for (uint64_t i = 0; i < 4; ++i)
+    ul.add_rq(::make_read(1, i));
+
+  uut._operate();
+
+  REQUIRE(std::size(ul.RQ) == 4);
+  REQUIRE(std::all_of(std::begin(ul.RQ), std::end(ul.RQ), [](const auto& x) { return x.cpu == 0; }));
+}
+
+TEST_CASE("Without allocations, requests enter the channel queues in order") {
+  champsim::channel ul{64, 64, 64, champsim::data::bits{6}, false};
+  auto uut = ::make_controller(&ul, 4);
+  ::start(uut);
+
+  for (uint64_t i = 0; i < 4; ++i)
+    ul.add_rq(::make_read(0, i));
+  for (uint64_t i = 0; i < 4; ++i)
+    ul.add_rq(::make_read(1, i));
+
+  uut._operate();
+
+  REQUIRE(std::size(ul.RQ) == 4);
+  REQUIRE(std::all_of(std::begin(ul.RQ), std::end(ul.RQ), [](const auto& x) { return x.cpu == 1; }));
+}
+
+TEST_CASE("A share of the memory bandwidth must be between 1 and 100 percent") {
+  champsim::channel ul{64, 64, 64, champsim::data::bits{6}, false};
+  auto uut = ::make_controller(&ul, 64);
+
+  REQUIRE_THROWS_AS(uut.set_allocations({{0, 0}}), std::invalid_argument);
+  REQUIRE_THROWS_AS(uut.set_allocations({{101, 0}}), std::invalid_argument);
+}
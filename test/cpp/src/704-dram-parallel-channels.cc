@@ -0,0 +1,71 @@
+#include <catch.hpp>
+#include "dram_controller.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  MEMORY_CONTROLLER make_controller(champsim::channel* ul)
+  {
+    return MEMORY_CONTROLLER{champsim::chrono::picoseconds{312},
+                             champsim::chrono::picoseconds{624},
+                             std::size_t{24},
+                             std::size_t{24},
+                             std::size_t{24},
+                             std::size_t{52},
+                             champsim::chrono::microseconds{64000},
+                             {ul},
+                             16,
+                             16,
+                             4,
+                             champsim::data::bytes{8},
+                             65536,
+                             1024,
+                             1,
+                             8,
+                             4,
+                             8192};
+  }
+
+  // The address of each response, and the cycle in which it was returned
+  std::vector<std::pair<uint64_t, long>> run_requests(std::size_t threads)
+  {
+    champsim::channel ul{32, 32, 32, champsim::data::bits{6}, false};
+    auto uut = ::make_controller(&ul);
+    uut.set_threads(threads);
+    uut.warmup = false;
+    uut.begin_phase();
+
+    std::mt19937_64 rng{704};
+    std::uniform_int_distribution<uint64_t> block_dist{0, (1 << 20) - 1};
+    std::vector<std::pair<uint64_t, long>> returned;
+    for (long cycle = 0; cycle < 20000; ++cycle) {
+      champsim::channel::request_type req;
+      req.address = champsim::address{block_dist(rng) << 6};
+      req.cpu = 0;
+      req.response_requested = true;
+      if (cycle % 3 == 0) {
+        ul.add_wq(req);
+      } else {
+        ul.add_rq(req);
+      }
+
+      uut._operate();
+
+      for (const auto& ret : ul.returned)
+        returned.emplace_back(ret.address.to<uint64_t>(), cycle);
+      ul.returned.clear();
+    }
+    return returned;
+  }
+}
+
+TEST_CASE("Channels operated in parallel return the same responses in the same order as channels operated serially") {
+  auto serial = ::run_requests(1);
+  auto parallel = ::run_requests(4);
+
+  REQUIRE(std::size(serial) > 500);
+  REQUIRE(serial == parallel);
+}
@@ -154,3 +154,24 @@ TEST_CASE("The DRAM refresh counters increment the printed stats")
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
+
+TEST_CASE("The DRAM per-core counters print the bandwidth and queueing delay of each core")
+{
+  dram_stats given{};
+  given.name = "test_channel";
+  given.elapsed = champsim::chrono::microseconds{1000};
+  core_stats(given, 1) = {15625, 5625, 10000};
+
+  std::vector<std::string> expected{
+    "test_channel RQ ROW_BUFFER_HIT:          0",
+    "  ROW_BUFFER_MISS:          0",
+    "  AVG DBUS CONGESTED CYCLE: -",
+    "test_channel WQ ROW_BUFFER_HIT:          0",
+    "  ROW_BUFFER_MISS:          0",
+    "  FULL:          0",
+    "test_channel REFRESHES ISSUED: -",
+    "test_channel cpu1 REQUESTS:      15625 BANDWIDTH: 1 GB/s AVG QUEUE DELAY: 1 THROTTLED CYCLES:       5625"
+  };
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
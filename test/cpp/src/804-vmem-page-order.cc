@@ -0,0 +1,48 @@
+#include <catch.hpp>
+#include "vmem.h"
+
+#include <set>
+
+#include "dram_controller.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_dram()
+{
+  return MEMORY_CONTROLLER{champsim::chrono::picoseconds{3200}, champsim::chrono::picoseconds{6400}, std::size_t{18}, std::size_t{18}, std::size_t{18},
+                           std::size_t{38}, champsim::chrono::microseconds{64000}, {}, 64, 64, 1, champsim::data::bytes{8}, 1024, 1024, 4, 4, 4, 8192};
+}
+} // namespace
+
+TEST_CASE("Virtual memory without a randomization seed maps pages in order") {
+  auto dram = ::make_dram();
+  VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram};
+  auto original_size = uut.available_ppages();
+
+  auto [first, first_delay] = uut.va_to_pa(0, champsim::page_number{0x1000});
+  auto [second, second_delay] = uut.va_to_pa(0, champsim::page_number{0x2000});
+  REQUIRE(first_delay > champsim::chrono::clock::duration::zero());
+  REQUIRE(second == first + 1);
+  REQUIRE(uut.available_ppages() == original_size - 2);
+}
+
+TEST_CASE("Virtual memory with a randomization seed maps pages out of order") {
+  auto dram = ::make_dram();
+  VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, std::chrono::nanoseconds{6400}, dram, 804};
+  auto original_size = uut.available_ppages();
+
+  std::set<champsim::page_number> mapped;
+  bool in_order = true;
+  auto [previous, delay] = uut.va_to_pa(0, champsim::page_number{0});
+  mapped.insert(previous);
+  for (uint64_t i = 1; i < 16; ++i) {
+    auto [ppage, fault_delay] = uut.va_to_pa(0, champsim::page_number{i});
+    in_order = in_order && (ppage == previous + 1);
+    mapped.insert(ppage);
+    previous = ppage;
+  }
+
+  REQUIRE_FALSE(in_order);
+  REQUIRE(std::size(mapped) == 16);
+  REQUIRE(uut.available_ppages() == original_size - 16);
+}
@@ -0,0 +1,64 @@
+#include <catch.hpp>
+#include "vmem.h"
+
+#include "dram_controller.h"
+#include "os_scheduler.h"
+
+SCENARIO("The virtual memory keys translations by the address space tag") {
+  GIVEN("A virtual memory whose address spaces are tagged") {
+    constexpr unsigned levels = 5;
+    constexpr champsim::data::bytes pte_page_size{1ull << 12};
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200}, champsim::chrono::picoseconds{6400}, std::size_t{18}, std::size_t{18}, std::size_t{18}, std::size_t{38}, champsim::chrono::microseconds{64000}, {}, 64, 64, 1, champsim::data::bytes{8}, 1024, 1024, 4, 4, 4, 8192};
+    VirtualMemory uut{pte_page_size, levels, std::chrono::nanoseconds{6400}, dram};
+    uut.tag_address_spaces(champsim::os_scheduler::address_space_shift);
+
+    const champsim::page_number first_trace_page{champsim::address{(uint64_t{1} << champsim::os_scheduler::address_space_shift) | 0xdeadb000}};
+    const champsim::page_number second_trace_page{champsim::address{(uint64_t{2} << champsim::os_scheduler::address_space_shift) | 0xdeadb000}};
+
+    WHEN("A trace translates a page on one core") {
+      auto [ppage_a, delay_a] = uut.va_to_pa(0, first_trace_page);
+      auto [pte_a, pte_delay_a] = uut.get_pte_pa(0, first_trace_page, 1);
+
+      AND_WHEN("The trace moves to another core and translates the page again") {
+        auto [ppage_b, delay_b] = uut.va_to_pa(1, first_trace_page);
+        auto [pte_b, pte_delay_b] = uut.get_pte_pa(1, first_trace_page, 1);
+
+        THEN("The trace keeps its physical page") {
+          REQUIRE(ppage_a == ppage_b);
+          REQUIRE(delay_b == champsim::chrono::clock::duration::zero());
+        }
+
+        THEN("The trace keeps its page table") {
+          REQUIRE(pte_a == pte_b);
+        }
+      }
+
+      AND_WHEN("Another trace translates the same page on the same core") {
+        auto [ppage_b, delay_b] = uut.va_to_pa(0, second_trace_page);
+
+        THEN("The other trace gets its own physical page") {
+          REQUIRE(ppage_a != ppage_b);
+          REQUIRE(delay_b > champsim::chrono::clock::duration::zero());
+        }
+      }
+    }
+  }
+
+  GIVEN("A virtual memory whose address spaces are not tagged") {
+    constexpr unsigned levels = 5;
+    constexpr champsim::data::bytes pte_page_size{1ull << 12};
+    MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200}, champsim::chrono::picoseconds{6400}, std::size_t{18}, std::size_t{18}, std::size_t{18}, std::size_t{38}, champsim::chrono::microseconds{64000}, {}, 64, 64, 1, champsim::data::bytes{8}, 1024, 1024, 4, 4, 4, 8192};
+    VirtualMemory uut{pte_page_size, levels, std::chrono::nanoseconds{6400}, dram};
+
+    const champsim::page_number page{0xdeadb};
+
+    WHEN("Two cores translate the same page") {
+      auto [ppage_a, delay_a] = uut.va_to_pa(0, page);
+      auto [ppage_b, delay_b] = uut.va_to_pa(1, page);
+
+      THEN("Each core gets its own physical page") {
+        REQUIRE(ppage_a != ppage_b);
+      }
+    }
+  }
+}
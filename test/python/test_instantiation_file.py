@@ -16,6 +16,15 @@ class VectorStringTest(unittest.TestCase):
     def test_list_with_two(self):
         self.assertEqual(config.instantiation_file.vector_string(['a','b']), '{a, b}');
 
+class BandwidthAllocationTest(unittest.TestCase):
+
+    def test_no_allocation(self):
+        self.assertEqual(list(config.instantiation_file.get_bandwidth_allocation({ 'name': 'DRAM' })), [])
+
+    def test_allocation(self):
+        pmem = { 'name': 'DRAM', 'bandwidth_allocation': [{ 'percent': 50, 'priority': 1 }, { 'percent': 25 }, {}] }
+        self.assertEqual(list(config.instantiation_file.get_bandwidth_allocation(pmem)), ['DRAM.set_allocations({{50, 1}, {25, 0}, {100, 0}});'])
+
 class CpuBuilderTest(unittest.TestCase):
 
     def get_element_diff(self, added_lines, **kwargs):
@@ -74,6 +83,12 @@ class CpuBuilderTest(unittest.TestCase):
     def test_mispredict_penalty(self):
         self.get_element_diff(['.mispredict_penalty(1)'], mispredict_penalty=1)
 
+    def test_model(self):
+        self.get_element_diff(['.model(champsim::core_model::interval)'], model='interval')
+
+    def test_core_type(self):
+        self.get_element_diff(['.core_type("big")'], core_type='big')
+
     def test_decode_latency(self):
         self.get_element_diff(['.decode_latency(1)'], decode_latency=1)
 
@@ -139,6 +154,15 @@ class CacheBuilderTests(unittest.TestCase):
     def test_log2_ways(self):
         self.get_element_diff(['.log2_ways(1)'], log2_ways=1)
 
+    def test_fixed_geometry(self):
+        self.get_element_diff(['.sets(64)', '.ways(8)', '.offset_bits(champsim::data::bits{6})', '.fixed_geometry<64, 8, 6>()'], sets=64, ways=8, _offset_bits=6)
+
+    def test_no_fixed_geometry_without_offset(self):
+        self.get_element_diff(['.sets(64)', '.ways(8)'], sets=64, ways=8)
+
+    def test_no_fixed_geometry_for_non_power_of_two_sets(self):
+        self.get_element_diff(['.sets(48)', '.ways(8)', '.offset_bits(champsim::data::bits{6})'], sets=48, ways=8, _offset_bits=6)
+
     def test_pq_size(self):
         self.get_element_diff(['.pq_size(1)'], pq_size=1)
 
@@ -160,6 +184,9 @@ class CacheBuilderTests(unittest.TestCase):
     def test_max_fill(self):
         self.get_element_diff(['.fill_bandwidth(champsim::bandwidth::maximum_type{1})'], max_fill=1)
 
+    def test_set_sample_mask(self):
+        self.get_element_diff(['.set_sample_mask(31)'], set_sample_mask=31)
+
     def test_prefetch_as_load(self):
         self.get_element_diff(['.set_prefetch_as_load()'], prefetch_as_load=True)
         self.get_element_diff(['.reset_prefetch_as_load()'], prefetch_as_load=False)
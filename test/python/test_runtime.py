@@ -0,0 +1,55 @@
+import unittest
+
+import config.runtime
+
+class OffsetBitsTest(unittest.TestCase):
+
+    def test_lg2_string(self):
+        self.assertEqual(config.runtime.offset_bits('champsim::lg2(64)'), 6)
+        self.assertEqual(config.runtime.offset_bits('champsim::lg2(4096)'), 12)
+
+    def test_integer(self):
+        self.assertEqual(config.runtime.offset_bits(6), 6)
+
+class RuntimeCacheTest(unittest.TestCase):
+
+    def test_private_keys_are_removed(self):
+        cache = { 'name': 'test_cache', '_queue_factor': 32, '_offset_bits': 'champsim::lg2(64)', '_queue_check_full_addr': False, '_first_level': True }
+        result = config.runtime.runtime_cache(cache)
+        self.assertFalse(any(k.startswith('_') for k in result.keys()))
+        self.assertEqual(result['queue_factor'], 32)
+        self.assertEqual(result['offset_bits'], 6)
+
+    def test_modules_are_resolved_to_names(self):
+        cache = {
+            'name': 'test_cache', 'prefetcher': 'next_line', 'replacement': '/path/to/my_policy',
+            '_queue_factor': 32, '_offset_bits': 6, '_queue_check_full_addr': False,
+            '_prefetcher_data': [{ 'name': 'prefetcherDnext_line', 'path': '/champsim/prefetcher/next_line/', 'class': 'next_line' }],
+            '_replacement_data': [{ 'name': 'my_policy', 'path': '/path/to/my_policy', 'class': 'my_policy' }]
+        }
+        result = config.runtime.runtime_cache(cache)
+        self.assertEqual(result['prefetcher'], ['next_line'])
+        self.assertEqual(result['replacement'], ['my_policy'])
+
+    def test_more_than_one_module_is_rejected(self):
+        cache = {
+            'name': 'test_cache', '_queue_factor': 32, '_offset_bits': 6, '_queue_check_full_addr': False,
+            '_prefetcher_data': [
+                { 'name': 'prefetcherDnext_line', 'path': '/champsim/prefetcher/next_line/', 'class': 'next_line' },
+                { 'name': 'prefetcherDip_stride', 'path': '/champsim/prefetcher/ip_stride/', 'class': 'ip_stride' }
+            ]
+        }
+        with self.assertRaises(ValueError):
+            config.runtime.runtime_cache(cache)
+
+    def test_defaults_are_shortened(self):
+        cache = { 'name': 'test_cache', '_queue_factor': 32, '_offset_bits': 6, '_queue_check_full_addr': False, '_defaults': 'champsim::defaults::default_l1d' }
+        self.assertEqual(config.runtime.runtime_cache(cache)['defaults'], 'l1d')
+
+class RuntimeCoreTest(unittest.TestCase):
+
+    def test_index_is_public(self):
+        cpu = { 'name': 'test_cpu', '_index': 3, '_branch_predictor_data': [], '_btb_data': [] }
+        result = config.runtime.runtime_core(cpu)
+        self.assertEqual(result['index'], 3)
+        self.assertNotIn('_index', result)
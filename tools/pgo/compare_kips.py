@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+#    Copyright 2023 The ChampSim Contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+'''
+Compare the simulation speed of ChampSim binaries, in thousands of simulated instructions per second of wall time (KIPS).
+
+Each binary simulates the same traces for the same number of instructions. Each run is repeated, and the fastest is reported,
+since the noise in wall time only ever makes a run slower.
+'''
+
+import argparse
+import subprocess
+import time
+
+def run_once(binary, traces, warmup, simulation):
+    command = [binary, '--warmup-instructions', str(warmup), '--simulation-instructions', str(simulation), '--hide-heartbeat', *traces]
+    start = time.perf_counter()
+    subprocess.run(command, stdout=subprocess.DEVNULL, check=True)
+    return time.perf_counter() - start
+
+def kips(binary, traces, warmup, simulation, repeat):
+    best = min(run_once(binary, traces, warmup, simulation) for _ in range(repeat))
+    return len(traces) * (warmup + simulation) / best / 1000
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Compare the simulation speed of ChampSim binaries')
+    parser.add_argument('-w', '--warmup-instructions', type=int, default=1000000, help='The number of instructions in the warmup phase')
+    parser.add_argument('-i', '--simulation-instructions', type=int, default=4000000, help='The number of instructions in the simulation phase')
+    parser.add_argument('-r', '--repeat', type=int, default=3, help='The number of times to run each binary')
+    parser.add_argument('-t', '--trace', action='append', required=True, help='A trace to simulate. Give one for each core')
+    parser.add_argument('baseline', help='The binary to compare against')
+    parser.add_argument('binaries', nargs='+', help='The binaries to compare')
+    args = parser.parse_args()
+
+    results = [(b, kips(b, args.trace, args.warmup_instructions, args.simulation_instructions, args.repeat)) for b in (args.baseline, *args.binaries)]
+
+    name_width = max(len(b) for b,_ in results)
+    print(f'{"Binary":<{name_width}}  {"KIPS":>10}  {"Speedup":>8}')
+    for binary, result in results:
+        print(f'{binary:<{name_width}}  {result:>10.1f}  {result / results[0][1]:>7.3f}x')
@@ -0,0 +1,81 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* A least-recently-used replacement policy, written against the plugin interface alone */
+
+#include <stdlib.h>
+
+#include "plugin_abi.h"
+
+struct lru_state {
+  uint32_t num_way;
+  uint64_t cycle;
+  uint64_t* last_used;
+};
+
+static void* lru_create(const champsim_plugin_services* services, champsim_plugin_cache* cache)
+{
+  struct lru_state* self = malloc(sizeof(struct lru_state));
+  self->num_way = services->num_way(cache);
+  self->cycle = 0;
+  self->last_used = calloc((size_t)services->num_set(cache) * self->num_way, sizeof(uint64_t));
+  return self;
+}
+
+static void lru_destroy(void* state)
+{
+  struct lru_state* self = state;
+  free(self->last_used);
+  free(self);
+}
+
+static long lru_find_victim(void* state, uint32_t triggering_cpu, uint64_t instr_id, long set, uint64_t ip, uint64_t full_addr, uint32_t type)
+{
+  struct lru_state* self = state;
+  const uint64_t* begin = self->last_used + set * self->num_way;
+  long victim = 0;
+  for (long way = 1; way < (long)self->num_way; ++way) {
+    if (begin[way] < begin[victim])
+      victim = way;
+  }
+  return victim;
+}
+
+static void lru_cache_fill(void* state, uint32_t triggering_cpu, long set, long way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, uint32_t type)
+{
+  struct lru_state* self = state;
+  self->last_used[set * self->num_way + way] = self->cycle++;
+}
+
+static void lru_update_replacement_state(void* state, uint32_t triggering_cpu, long set, long way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr,
+                                         uint32_t type, int hit)
+{
+  struct lru_state* self = state;
+  /* Writeback hits (type 3) do not update the replacement state */
+  if (hit && type != 3)
+    self->last_used[set * self->num_way + way] = self->cycle++;
+}
+
+static const champsim_replacement_plugin_vtable lru_vtable = {
+    .abi_version = CHAMPSIM_PLUGIN_ABI_VERSION,
+    .create = lru_create,
+    .destroy = lru_destroy,
+    .find_victim = lru_find_victim,
+    .update_replacement_state = lru_update_replacement_state,
+    .cache_fill = lru_cache_fill,
+};
+
+const champsim_replacement_plugin_vtable* champsim_replacement_plugin(void) { return &lru_vtable; }
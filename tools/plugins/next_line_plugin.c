@@ -0,0 +1,54 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* A next-line prefetcher, written against the plugin interface alone */
+
+#include <stdlib.h>
+
+#include "plugin_abi.h"
+
+struct next_line_state {
+  const champsim_plugin_services* services;
+  champsim_plugin_cache* cache;
+};
+
+static void* next_line_create(const champsim_plugin_services* services, champsim_plugin_cache* cache)
+{
+  struct next_line_state* self = malloc(sizeof(struct next_line_state));
+  self->services = services;
+  self->cache = cache;
+  return self;
+}
+
+static void next_line_destroy(void* self) { free(self); }
+
+static uint32_t next_line_cache_operate(void* state, uint64_t addr, uint64_t ip, int cache_hit, int useful_prefetch, uint32_t type, uint32_t metadata_in)
+{
+  struct next_line_state* self = state;
+  uint32_t offset_bits = self->services->offset_bits(self->cache);
+  uint64_t next_block = ((addr >> offset_bits) + 1) << offset_bits;
+  self->services->prefetch_line(self->cache, next_block, 1, metadata_in);
+  return metadata_in;
+}
+
+static const champsim_prefetcher_plugin_vtable next_line_vtable = {
+    .abi_version = CHAMPSIM_PLUGIN_ABI_VERSION,
+    .create = next_line_create,
+    .destroy = next_line_destroy,
+    .cache_operate = next_line_cache_operate,
+};
+
+const champsim_prefetcher_plugin_vtable* champsim_prefetcher_plugin(void) { return &next_line_vtable; }
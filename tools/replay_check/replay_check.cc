@@ -0,0 +1,46 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "replay_log.h"
+
+// Compare two replay logs recorded with bin/champsim --replay-log, and report the first cycle and component at which they differ
+int main(int argc, char** argv)
+{
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " first.log second.log" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ifstream lhs{argv[1], std::ios::binary};
+  std::ifstream rhs{argv[2], std::ios::binary};
+  if (!lhs || !rhs) {
+    std::cerr << "Could not open the logs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto result = champsim::replay::find_divergence(lhs, rhs);
+  if (!result.has_value()) {
+    std::cout << "The logs are identical" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  std::cout << "First divergence: " << result->component << " cycle " << result->cycle << ": " << result->reason << std::endl;
+  return 2;
+}
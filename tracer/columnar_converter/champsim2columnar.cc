@@ -0,0 +1,69 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../inc/columnar_trace.h"
+
+// Read uncompressed ChampSim trace records from standard input and write the equivalent columnar trace to standard output
+int main(int argc, char** argv)
+{
+  std::size_t block_size = champsim::columnar::default_block_size;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+      block_size = std::strtoull(argv[++i], nullptr, 0);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [-b block_size] < input.champsimtrace > output.csct" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (block_size == 0) {
+    std::cerr << "Block size must be positive" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ios::sync_with_stdio(false);
+  auto header = champsim::columnar::file_header();
+  std::cout.write(std::data(header), std::size(header));
+
+  std::vector<input_instr> records(block_size);
+  std::vector<char> encoded;
+  std::size_t total_records = 0;
+  std::size_t total_bytes = std::size(header);
+  while (std::cin) {
+    std::cin.read(reinterpret_cast<char*>(std::data(records)), static_cast<std::streamsize>(block_size * sizeof(input_instr)));
+    auto records_read = static_cast<std::size_t>(std::cin.gcount()) / sizeof(input_instr);
+    if (records_read == 0) {
+      break;
+    }
+
+    encoded.clear();
+    champsim::columnar::encode_block(std::data(records), std::next(std::data(records), records_read), encoded);
+    std::cout.write(std::data(encoded), static_cast<std::streamsize>(std::size(encoded)));
+
+    total_records += records_read;
+    total_bytes += std::size(encoded);
+  }
+
+  std::cerr << "Converted " << total_records << " instructions into " << total_bytes << " bytes (" << (total_records * sizeof(input_instr))
+            << " bytes uncompressed)" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../../inc/stack_distance.h"
+#include "../../inc/trace_instruction.h"
+
+namespace
+{
+// A SplitMix64 finalizer, used to select a spatially unbiased sample of lines
+uint64_t hash_line(uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+uint64_t parse_size(const std::string& str)
+{
+  char* end = nullptr;
+  auto value = std::strtoull(str.c_str(), &end, 0);
+  switch (std::toupper(static_cast<unsigned char>(*end))) {
+  case 'G':
+    value <<= 10;
+    [[fallthrough]];
+  case 'M':
+    value <<= 10;
+    [[fallthrough]];
+  case 'K':
+    value <<= 10;
+    break;
+  default:
+    break;
+  }
+  return value;
+}
+
+struct interval_stats {
+  uint64_t instructions = 0;
+  double footprint_lines = 0;
+  std::vector<uint64_t> misses; // per cache size
+  uint64_t accesses = 0;
+};
+
+void usage(const char* name)
+{
+  std::cerr << "Usage: " << name << " -c cache_size [-c cache_size ...] [-l line_size] [-i interval] [-r sample_rate] [-t tolerance] [--no-ifetch]\n"
+            << "Reads an uncompressed ChampSim trace from standard input.\n"
+            << "  -c  Capacity of a cache to size the warmup for, with an optional K, M, or G suffix (e.g. 2M)\n"
+            << "  -l  Cache line size in bytes (default 64)\n"
+            << "  -i  Number of instructions in each reporting interval (default 10000000)\n"
+            << "  -r  Fraction of lines to sample, as in SHARDS (default 1, exact)\n"
+            << "  -t  Tolerance on the interval miss ratio that defines the steady state (default 0.02)\n"
+            << "  --no-ifetch  Do not count instruction fetches" << std::endl;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::vector<uint64_t> cache_sizes;
+  uint64_t line_size = 64;
+  uint64_t interval = 10000000;
+  double sample_rate = 1.0;
+  double tolerance = 0.02;
+  bool count_ifetch = true;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg{argv[i]};
+    if (arg == "--no-ifetch") {
+      count_ifetch = false;
+    } else if (i + 1 < argc && arg == "-c") {
+      cache_sizes.push_back(parse_size(argv[++i]));
+    } else if (i + 1 < argc && arg == "-l") {
+      line_size = parse_size(argv[++i]);
+    } else if (i + 1 < argc && arg == "-i") {
+      interval = parse_size(argv[++i]);
+    } else if (i + 1 < argc && arg == "-r") {
+      sample_rate = std::strtod(argv[++i], nullptr);
+    } else if (i + 1 < argc && arg == "-t") {
+      tolerance = std::strtod(argv[++i], nullptr);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (std::empty(cache_sizes) || line_size == 0 || (line_size & (line_size - 1)) != 0 || interval == 0 || sample_rate <= 0 || sample_rate > 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  // SHARDS: sample lines whose hash falls below a threshold, and scale the observed distances by the inverse of the sampling rate
+  auto threshold = static_cast<uint64_t>(sample_rate * static_cast<double>(std::numeric_limits<uint64_t>::max()));
+  auto line_shift = static_cast<unsigned>(std::log2(line_size));
+
+  std::vector<uint64_t> cache_lines;
+  std::transform(std::begin(cache_sizes), std::end(cache_sizes), std::back_inserter(cache_lines), [line_size](auto size) { return size / line_size; });
+
+  champsim::stack_distance_counter counter;
+  champsim::stack_distance_histogram histogram; // of the scaled stack distance
+  std::vector<interval_stats> intervals;
+  interval_stats current{0, 0, std::vector<uint64_t>(std::size(cache_sizes), 0), 0};
+
+  auto record_access = [&](uint64_t addr) {
+    auto line = addr >> line_shift;
+    if (sample_rate < 1 && hash_line(line) > threshold) {
+      return;
+    }
+
+    auto distance = counter.access(line);
+    ++current.accesses;
+    if (distance == champsim::stack_distance_counter::infinite) {
+      histogram.add(distance);
+    } else {
+      histogram.add(static_cast<uint64_t>(static_cast<double>(distance) / sample_rate));
+    }
+
+    for (std::size_t i = 0; i < std::size(cache_lines); ++i) {
+      if (distance == champsim::stack_distance_counter::infinite || static_cast<double>(distance) / sample_rate >= static_cast<double>(cache_lines[i])) {
+        ++current.misses[i];
+      }
+    }
+  };
+
+  std::ios::sync_with_stdio(false);
+  std::vector<input_instr> records(4096);
+  uint64_t instr_count = 0;
+  while (std::cin) {
+    std::cin.read(reinterpret_cast<char*>(std::data(records)), static_cast<std::streamsize>(std::size(records) * sizeof(input_instr)));
+    auto records_read = static_cast<std::size_t>(std::cin.gcount()) / sizeof(input_instr);
+    for (std::size_t r = 0; r < records_read; ++r) {
+      const auto& instr = records[r];
+      if (count_ifetch) {
+        record_access(instr.ip);
+      }
+      for (auto addr : instr.source_memory) {
+        if (addr != 0) {
+          record_access(addr);
+        }
+      }
+      for (auto addr : instr.destination_memory) {
+        if (addr != 0) {
+          record_access(addr);
+        }
+      }
+
+      if (++instr_count % interval == 0) {
+        current.instructions = instr_count;
+        current.footprint_lines = static_cast<double>(counter.footprint()) / sample_rate;
+        intervals.push_back(current);
+        current = interval_stats{0, 0, std::vector<uint64_t>(std::size(cache_sizes), 0), 0};
+      }
+    }
+    if (records_read == 0) {
+      break;
+    }
+  }
+  if (current.accesses > 0) {
+    current.instructions = instr_count;
+    current.footprint_lines = static_cast<double>(counter.footprint()) / sample_rate;
+    intervals.push_back(current);
+  }
+
+  std::cout << "Instructions: " << instr_count << "\n";
+  std::cout << "Footprint: " << static_cast<uint64_t>(static_cast<double>(counter.footprint()) / sample_rate) << " lines ("
+            << static_cast<uint64_t>(static_cast<double>(counter.footprint()) / sample_rate) * line_size << " bytes)\n\n";
+
+  std::cout << "Stack distance profile (lines)\n";
+  const auto& buckets = histogram.buckets();
+  for (std::size_t b = 0; b + 1 < std::size(buckets); ++b) {
+    if (buckets[b] > 0) {
+      std::cout << "  [" << (b == 0 ? 0 : (1ULL << (b - 1))) << ", " << (1ULL << b) << "): " << buckets[b] << "\n";
+    }
+  }
+  std::cout << "  cold: " << histogram.cold() << "\n\n";
+
+  std::cout << std::setw(16) << "instructions" << std::setw(16) << "footprint";
+  for (auto size : cache_sizes) {
+    std::cout << std::setw(15) << size << "B";
+  }
+  std::cout << "\n";
+  for (const auto& iv : intervals) {
+    std::cout << std::setw(16) << iv.instructions << std::setw(16) << static_cast<uint64_t>(iv.footprint_lines);
+    for (auto misses : iv.misses) {
+      std::cout << std::setw(16) << std::fixed << std::setprecision(4) << (iv.accesses > 0 ? static_cast<double>(misses) / static_cast<double>(iv.accesses) : 0.0);
+    }
+    std::cout << "\n";
+  }
+  std::cout << "\n";
+
+  // A cache is warm once the footprint has filled it and the miss ratio of every later interval stays within the tolerance of the final interval's
+  for (std::size_t i = 0; i < std::size(cache_sizes); ++i) {
+    std::size_t first_steady = std::size(intervals);
+    if (!std::empty(intervals)) {
+      auto final_ratio = static_cast<double>(intervals.back().misses[i]) / static_cast<double>(std::max<uint64_t>(intervals.back().accesses, 1));
+      for (auto it = std::rbegin(intervals); it != std::rend(intervals); ++it) {
+        auto ratio = static_cast<double>(it->misses[i]) / static_cast<double>(std::max<uint64_t>(it->accesses, 1));
+        if (std::abs(ratio - final_ratio) > tolerance) {
+          break;
+        }
+        first_steady = static_cast<std::size_t>(std::distance(it, std::rend(intervals))) - 1;
+      }
+    }
+
+    auto filled = std::find_if(std::begin(intervals), std::end(intervals),
+                               [lines = cache_lines[i]](const auto& iv) { return iv.footprint_lines >= static_cast<double>(lines); });
+
+    // If the footprint never fills the cache, it is warm once the cold misses have subsided
+    auto warm_idx = first_steady;
+    if (filled != std::end(intervals)) {
+      warm_idx = std::max(static_cast<std::size_t>(std::distance(std::begin(intervals), filled)) + 1, first_steady);
+    }
+
+    std::cout << "Cache of " << cache_sizes[i] << " bytes: ";
+    if (std::size(intervals) < 2 || warm_idx >= std::size(intervals) - 1) {
+      std::cout << "no steady state was reached within the trace; consider a longer trace or a larger tolerance\n";
+    } else {
+      uint64_t warmup = warm_idx == 0 ? 0 : intervals[warm_idx - 1].instructions;
+      std::cout << "recommended --warmup-instructions " << warmup;
+      if (filled == std::end(intervals)) {
+        std::cout << " (the trace footprint fits in this cache)";
+      }
+      std::cout << "\n";
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
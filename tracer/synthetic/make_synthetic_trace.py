@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+#    Copyright 2023 The ChampSim Contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+'''
+Write a synthetic ChampSim trace that exercises the common paths through the simulator.
+
+The trace is a loop over three kernels: a streaming kernel that prefetchers can follow, a pointer chase that misses in every level of the cache,
+and a table lookup with data-dependent branches that branch predictors cannot learn. Each kernel is entered through a call and left through a return.
+The trace is deterministic for a given seed.
+'''
+
+import argparse
+import functools
+import lzma
+import random
+import struct
+
+# Must match inc/trace_instruction.h
+REG_STACK_POINTER = 6
+REG_FLAGS = 25
+REG_INSTRUCTION_POINTER = 26
+input_instr = struct.Struct('<QBB2B4B2Q4Q')
+
+def instr(ip, dregs=(), sregs=(), dmem=(), smem=(), branch=None):
+    ''' Pack one instruction. The branch, if any, is given as whether it was taken. '''
+    dregs, sregs, dmem, smem = list(dregs), list(sregs), list(dmem), list(smem)
+    return input_instr.pack(ip, int(branch is not None), int(bool(branch)),
+            *(dregs + [0]*(2-len(dregs))), *(sregs + [0]*(4-len(sregs))),
+            *(dmem + [0]*(2-len(dmem))), *(smem + [0]*(4-len(smem))))
+
+def conditional(ip, taken, reg=1):
+    return instr(ip, dregs=[REG_INSTRUCTION_POINTER], sregs=[REG_INSTRUCTION_POINTER, REG_FLAGS, reg], branch=taken)
+
+def call(ip):
+    return instr(ip, dregs=[REG_INSTRUCTION_POINTER, REG_STACK_POINTER], sregs=[REG_INSTRUCTION_POINTER, REG_STACK_POINTER], branch=True)
+
+def ret(ip):
+    return instr(ip, dregs=[REG_INSTRUCTION_POINTER, REG_STACK_POINTER], sregs=[REG_STACK_POINTER], branch=True)
+
+class Program:
+    ''' The state of the synthetic program, which persists between visits to each kernel. '''
+    code_base = 0x40_0000
+    stream_base = 0x1000_0000
+    chase_base = 0x4000_0000
+    table_base = 0x8000_0000
+
+    def __init__(self, rng, stream_bytes, chase_bytes, table_bytes):
+        self.rng = rng
+        self.stream_bytes = stream_bytes
+        self.stream_offset = 0
+
+        # A single random cycle through the lines of the region
+        chase_lines = list(range(chase_bytes // 64))
+        rng.shuffle(chase_lines)
+        self.chase_next = dict(zip(chase_lines, chase_lines[1:] + chase_lines[:1]))
+        self.chase_line = chase_lines[0]
+
+        self.table_entries = table_bytes // 8
+
+    def stream(self, iterations):
+        ip = self.code_base + 0x100
+        for i in range(iterations):
+            offset = (self.stream_offset + 8*i) % self.stream_bytes
+            yield instr(ip, dregs=[1], sregs=[2], smem=[self.stream_base + offset])
+            yield instr(ip+4, dregs=[3], sregs=[2], smem=[self.stream_base + self.stream_bytes + offset])
+            yield instr(ip+8, dregs=[4], sregs=[1, 3])
+            yield instr(ip+12, sregs=[4, 2], dmem=[self.stream_base + 2*self.stream_bytes + offset])
+            yield instr(ip+16, dregs=[2], sregs=[2])
+            yield conditional(ip+20, i+1 < iterations, reg=2)
+        self.stream_offset = (self.stream_offset + 8*iterations) % self.stream_bytes
+
+    def chase(self, iterations):
+        ip = self.code_base + 0x200
+        for i in range(iterations):
+            yield instr(ip, dregs=[5], sregs=[5], smem=[self.chase_base + 64*self.chase_line])
+            yield instr(ip+4, dregs=[7], sregs=[7, 5])
+            yield conditional(ip+8, i+1 < iterations, reg=5)
+            self.chase_line = self.chase_next[self.chase_line]
+
+    def lookup(self, iterations):
+        ip = self.code_base + 0x300
+        for i in range(iterations):
+            entry = self.rng.randrange(self.table_entries)
+            taken = self.rng.random() < 0.5
+            yield instr(ip, dregs=[8], sregs=[9], smem=[self.table_base + 8*entry])
+            yield conditional(ip+4, taken, reg=8)
+            if not taken:
+                yield instr(ip+8, dregs=[10], sregs=[10, 8])
+            yield instr(ip+12, dregs=[9], sregs=[9])
+            yield conditional(ip+16, i+1 < iterations, reg=9)
+
+    def run(self):
+        ''' Generate instructions from the main loop, forever. '''
+        ip = self.code_base
+        while True:
+            for kernel, call_ip, ret_ip, iterations in ((self.stream, ip, self.code_base + 0x1fc, 256), (self.chase, ip+4, self.code_base + 0x2fc, 16),
+                                                        (self.lookup, ip+8, self.code_base + 0x3fc, 128)):
+                yield call(call_ip)
+                yield from kernel(iterations)
+                yield ret(ret_ip)
+            yield conditional(ip+12, True, reg=11)
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Write a synthetic ChampSim trace')
+    parser.add_argument('-n', '--instructions', type=int, default=1000000, help='The number of instructions in the trace')
+    parser.add_argument('--stream-size', type=int, default=16*1024*1024, help='The size of each array in the streaming kernel, in bytes')
+    parser.add_argument('--chase-size', type=int, default=4*1024*1024, help='The size of the region in the pointer-chasing kernel, in bytes')
+    parser.add_argument('--table-size', type=int, default=256*1024, help='The size of the table in the lookup kernel, in bytes')
+    parser.add_argument('--seed', type=int, default=0, help='The seed for the random choices in the trace')
+    parser.add_argument('output', help='The file to write. Files ending in .xz are compressed')
+    args = parser.parse_args()
+
+    program = Program(random.Random(args.seed), args.stream_size, args.chase_size, args.table_size)
+    # The trace is very regular, so light compression is nearly as good as the default and much faster
+    opener = functools.partial(lzma.open, preset=1) if args.output.endswith('.xz') else open
+    with opener(args.output, 'wb') as wfp:
+        buffer = bytearray()
+        for _, packed in zip(range(args.instructions), program.run()):
+            buffer += packed
+            if len(buffer) >= (1 << 20):
+                wfp.write(buffer)
+                buffer.clear()
+        wfp.write(buffer)